@@ -0,0 +1,428 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+}
+
+#include "info_generator.hpp"
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+/*! \brief Latencies of repeated runs in microseconds
+ */
+struct latency {
+    double min = 0.0;       //!< The fastest run
+    double median = 0.0;    //!< The median run
+    double p99 = 0.0;       //!< The 99th percentile, less sensitive to preemption than max
+    double max = 0.0;       //!< The slowest run
+};
+
+/*! \brief The result of the serialization benchmark
+ */
+struct serialization_result {
+    size_t bytes = 0U;             //!< The number of gcda bytes of one pass over all files
+    size_t max_gcda_bytes = 0U;    //!< The buffer size needed for the largest file
+    double seconds = 0.0;          //!< The time of all passes
+    double mb_per_s = 0.0;         //!< The serialization throughput
+};
+
+/*! \brief The result of the dump benchmark of one image layout
+ */
+struct dump_result {
+    const char* layout = nullptr;           //!< The name of the layout
+    gcov_unsigned_t flags = 0U;             //!< The GCOV_IMAGE_* flags of the layout
+    const gcov_filter* filter = nullptr;    //!< The filter of the dump, nullptr to dump all files
+    size_t image_bytes = 0U;                //!< The image size, i.e. the peak usage of the buffer
+    size_t max_chunk_bytes = 0U;            //!< The largest chunk handed to the sink
+    size_t chunks = 0U;                     //!< The number of chunks of one image
+    latency latency_us = {};                //!< The latency of __gcov_dump()
+    double mb_per_s = 0.0;                  //!< The image bytes per second of the median dump
+};
+
+/*! \brief The result of the benchmark of a dump written with gcov_dump_step()
+ */
+struct step_result {
+    size_t budget = 0U;         //!< The byte budget of each step
+    size_t image_bytes = 0U;    //!< The image size
+    size_t steps = 0U;          //!< The number of steps of one image
+    latency step_latency_us;    //!< The latency of a single step over all images
+    latency dump_latency_us;    //!< The time of all steps of one image
+};
+
+/*! \brief The result of the benchmark of gcov_snapshot() and the dump of the snapshot
+ */
+struct snapshot_result {
+    size_t counters = 0U;         //!< The number of counters copied by each snapshot
+    latency pause_us;             //!< The pause reported by gcov_snapshot_pause()
+    double max_pause_us = 0.0;    //!< The longest pause reported by gcov_snapshot_max_pause()
+    latency dump_latency_us;      //!< The time of __gcov_dump() writing the snapshot
+    bool matches_dump = false;    //!< Set if the image equals the dump of the live counters
+};
+
+/*! \brief State of the sink which collects the image in RAM and records the chunk sizes
+ */
+struct recording_sink_context {
+    std::vector<unsigned char> buffer;    //!< The image
+    size_t used = 0U;                     //!< The number of bytes of the current image
+    size_t max_chunk = 0U;                //!< The largest chunk of the current image
+    size_t chunks = 0U;                   //!< The number of chunks of the current image
+};
+
+int begin_recording(void* context) {
+    recording_sink_context& sink = *static_cast<recording_sink_context*>(context);
+    sink.used = 0U;
+    sink.max_chunk = 0U;
+    sink.chunks = 0U;
+    return 0;
+}
+
+int write_recording(void* context, const unsigned char* data, const size_t size) {
+    recording_sink_context& sink = *static_cast<recording_sink_context*>(context);
+    if(sink.buffer.size() - sink.used < size)
+        sink.buffer.resize(std::max(sink.buffer.size() * 2U, sink.used + size));
+    memcpy(sink.buffer.data() + sink.used, data, size);
+    sink.used += size;
+    sink.max_chunk = std::max(sink.max_chunk, size);
+    ++sink.chunks;
+    return 0;
+}
+
+latency summarize(std::vector<double>& samples) {
+    std::sort(samples.begin(), samples.end());
+    return {samples.front(), samples[samples.size() / 2U], samples[samples.size() * 99U / 100U],
+            samples.back()};
+}
+
+double seconds_since(const bench_clock::time_point start) {
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+//! The clock of gcov_snapshot(), in nanoseconds wrapping around every 4.3 seconds
+gcov_unsigned_t read_nanoseconds() {
+    return gcov_unsigned_t(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now().time_since_epoch())
+            .count());
+}
+
+/*! \brief Measures gcov_convert_to_gcda() over all files
+ */
+serialization_result measure_serialization(gcovbench::synthetic_coverage& coverage,
+                                           const size_t repetitions) {
+    serialization_result result;
+    for(gcov_info* info : coverage.infos()) {
+        const size_t size = gcov_convert_to_gcda(nullptr, 0U, info);
+        result.bytes += size;
+        result.max_gcda_bytes = std::max(result.max_gcda_bytes, size);
+    }
+
+    std::vector<unsigned char> buffer(result.max_gcda_bytes);
+    size_t written = 0U;
+    const bench_clock::time_point start = bench_clock::now();
+    for(size_t repetition = 0U; repetition < repetitions; ++repetition) {
+        for(gcov_info* info : coverage.infos())
+            written += gcov_convert_to_gcda(buffer.data(), buffer.size(), info);
+    }
+    result.seconds = seconds_since(start);
+    result.mb_per_s = double(written) / 1e6 / result.seconds;
+    return result;
+}
+
+/*! \brief Measures __gcov_dump() of the registered files into RAM
+ */
+void measure_dump(dump_result& result, const size_t repetitions) {
+    recording_sink_context context;
+    const gcov_sink sink = {begin_recording, write_recording, nullptr, &context};
+    set_gcov_sink(&sink);
+    set_gcov_image_flags(result.flags);
+    if(result.filter)
+        gcov_add_filter(result.filter);
+
+    // the first dump grows the buffer to the image size, so it is not measured
+    __gcov_dump();
+    std::vector<double> samples;
+    for(size_t repetition = 0U; repetition < repetitions; ++repetition) {
+        const bench_clock::time_point start = bench_clock::now();
+        __gcov_dump();
+        samples.push_back(seconds_since(start) * 1e6);
+    }
+    set_gcov_sink(nullptr);
+    set_gcov_image_flags(0U);
+    gcov_clear_filters();
+
+    result.image_bytes = context.used;
+    result.max_chunk_bytes = context.max_chunk;
+    result.chunks = context.chunks;
+    result.latency_us = summarize(samples);
+    result.mb_per_s = double(result.image_bytes) / result.latency_us.median;
+}
+
+/*! \brief Measures the latency of the steps of a dump with gcov_dump_step()
+ *
+ *  \param[in,out]  result      The budget, the results are filled in
+ *  \param[in]      repetitions The number of images
+ *  \param[in]      changed     The counter changed before each image of a delta dump, all other
+ *                              files are unchanged, nullptr for a plain dump
+ *  \param[in]      functions   The number of functions of all files, the size of the baseline
+ */
+void measure_steps(step_result& result,
+                   const size_t repetitions,
+                   gcov_type* changed = nullptr,
+                   const size_t functions = 0U) {
+    recording_sink_context context;
+    const gcov_sink sink = {begin_recording, write_recording, nullptr, &context};
+    set_gcov_sink(&sink);
+    std::vector<gcov_function_baseline> baseline(functions);
+    if(changed) {
+        set_gcov_delta_buffer(baseline.data(), baseline.size());
+        set_gcov_image_flags(GCOV_IMAGE_DELTA);
+    }
+
+    // the first delta dump holds all functions, the following ones only the changed one
+    __gcov_dump();
+    std::vector<double> step_samples;
+    std::vector<double> dump_samples;
+    for(size_t repetition = 0U; repetition < repetitions; ++repetition) {
+        if(changed)
+            ++*changed;
+        double dump_us = 0.0;
+        size_t steps = 0U;
+        int status = GCOV_DUMP_PENDING;
+        while(status == GCOV_DUMP_PENDING) {
+            const bench_clock::time_point start = bench_clock::now();
+            status = gcov_dump_step(result.budget);
+            step_samples.push_back(seconds_since(start) * 1e6);
+            dump_us += step_samples.back();
+            ++steps;
+        }
+        dump_samples.push_back(dump_us);
+        result.steps = steps;
+    }
+    set_gcov_sink(nullptr);
+    set_gcov_image_flags(0U);
+    set_gcov_delta_buffer(nullptr, 0U);
+
+    result.image_bytes = context.used;
+    result.step_latency_us = summarize(step_samples);
+    result.dump_latency_us = summarize(dump_samples);
+}
+
+/*! \brief Measures the pause of gcov_snapshot() and the dump of the snapshot
+ */
+void measure_snapshot(snapshot_result& result, const size_t repetitions) {
+    recording_sink_context context;
+    const gcov_sink sink = {begin_recording, write_recording, nullptr, &context};
+    set_gcov_sink(&sink);
+    __gcov_dump();
+    const std::vector<unsigned char> live_image(context.buffer.begin(),
+                                                context.buffer.begin() + context.used);
+
+    std::vector<unsigned char> area((result.counters + 1U) * sizeof(gcov_type));
+    set_gcov_snapshot_buffer(area.data(), area.size());
+    set_gcov_clock(read_nanoseconds);
+    std::vector<double> pause_samples;
+    std::vector<double> dump_samples;
+    result.matches_dump = true;
+    for(size_t repetition = 0U; repetition < repetitions; ++repetition) {
+        if(gcov_snapshot() != 0) {
+            result.matches_dump = false;
+            break;
+        }
+        pause_samples.push_back(gcov_snapshot_pause() / 1e3);
+        const bench_clock::time_point start = bench_clock::now();
+        __gcov_dump();
+        dump_samples.push_back(seconds_since(start) * 1e6);
+        result.matches_dump = result.matches_dump && (context.used == live_image.size())
+                              && std::equal(live_image.begin(), live_image.end(),
+                                            context.buffer.begin());
+    }
+    result.max_pause_us = gcov_snapshot_max_pause() / 1e3;
+    set_gcov_clock(nullptr);
+    set_gcov_snapshot_buffer(nullptr, 0U);
+    set_gcov_sink(nullptr);
+
+    if(!pause_samples.empty()) {
+        result.pause_us = summarize(pause_samples);
+        result.dump_latency_us = summarize(dump_samples);
+    }
+}
+
+void write_latency(FILE* output, const latency& value) {
+    fprintf(output, "{\"min\": %.3f, \"median\": %.3f, \"p99\": %.3f, \"max\": %.3f}", value.min,
+            value.median, value.p99, value.max);
+}
+
+void write_steps(FILE* output, const char* name, const step_result& steps) {
+    fprintf(output,
+            "  \"%s\": {\"budget\": %zu, \"image_bytes\": %zu, \"steps\": %zu, "
+            "\"step_latency_us\": ",
+            name, steps.budget, steps.image_bytes, steps.steps);
+    write_latency(output, steps.step_latency_us);
+    fprintf(output, ", \"dump_latency_us\": ");
+    write_latency(output, steps.dump_latency_us);
+    fprintf(output, "},\n");
+}
+
+/*! \brief Writes the results as JSON object
+ */
+void write_results(FILE* output,
+                   const gcovbench::generator_config& config,
+                   const size_t repetitions,
+                   const serialization_result& serialization,
+                   const std::vector<dump_result>& dumps,
+                   const step_result& steps,
+                   const step_result& delta_steps,
+                   const snapshot_result& snapshot) {
+    char timestamp[32];
+    const time_t now = time(nullptr);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    fprintf(output,
+            "{\n"
+            "  \"benchmark\": \"gcov_bench\",\n"
+            "  \"timestamp\": \"%s\",\n"
+            "  \"compiler\": \"%s\",\n"
+            "  \"config\": {\"files\": %zu, \"functions\": %zu, \"counters\": %zu, "
+            "\"zero_share\": %.3f, \"seed\": %u, \"repetitions\": %zu, "
+            "\"staging_buffer_bytes\": %u},\n",
+            timestamp, __VERSION__, config.files, config.functions, config.counters,
+            config.zero_share, config.seed, repetitions, GCOV_STAGING_BUFFER_SIZE);
+    fprintf(output,
+            "  \"serialization\": {\"bytes\": %zu, \"max_gcda_bytes\": %zu, \"seconds\": %.6f, "
+            "\"mb_per_s\": %.2f},\n"
+            "  \"dump\": [",
+            serialization.bytes, serialization.max_gcda_bytes, serialization.seconds,
+            serialization.mb_per_s);
+    for(size_t idx = 0U; idx < dumps.size(); ++idx) {
+        const dump_result& dump = dumps[idx];
+        fprintf(output,
+                "%s\n    {\"layout\": \"%s\", \"flags\": %u, \"image_bytes\": %zu, "
+                "\"max_chunk_bytes\": %zu, \"chunks\": %zu, \"mb_per_s\": %.2f, \"latency_us\": ",
+                idx ? "," : "", dump.layout, dump.flags, dump.image_bytes, dump.max_chunk_bytes,
+                dump.chunks, dump.mb_per_s);
+        write_latency(output, dump.latency_us);
+        fprintf(output, "}");
+    }
+    fprintf(output, "\n  ],\n");
+    write_steps(output, "steps", steps);
+    // a delta dump of a single changed file passes over all other files
+    write_steps(output, "delta_steps", delta_steps);
+    fprintf(output,
+            "  \"snapshot\": {\"counters\": %zu, \"matches_dump\": %s, \"max_pause_us\": %.3f, "
+            "\"pause_us\": ",
+            snapshot.counters, snapshot.matches_dump ? "true" : "false", snapshot.max_pause_us);
+    write_latency(output, snapshot.pause_us);
+    fprintf(output, ", \"dump_latency_us\": ");
+    write_latency(output, snapshot.dump_latency_us);
+    fprintf(output, "}\n}\n");
+}
+
+void print_usage(const char* name) {
+    fprintf(stderr,
+            "Usage: %s [-f files] [-F functions] [-c counters] [-z zero share] [-s seed]\n"
+            "          [-r repetitions] [-i pattern] [-b budget] [-o results]\n"
+            "Measures the serialization, dump and snapshot of synthesized coverage data.\n"
+            "  -f files        the number of object files, defaults to 16\n"
+            "  -F functions    the number of functions per file, defaults to 32\n"
+            "  -c counters     the number of counters per function, defaults to 16\n"
+            "  -z zero share   the share of zero counters from 0 to 1, defaults to 0.5\n"
+            "  -s seed         the seed of the counter values, defaults to 1\n"
+            "  -r repetitions  the number of measured runs, defaults to 100\n"
+            "  -i pattern      adds a plain dump of the files matching the gcov_filter pattern,\n"
+            "                  e.g. '/bench/synthetic/file_00001*'\n"
+            "  -b budget       the byte budget of each gcov_dump_step() of a plain and a delta\n"
+            "                  dump, defaults to 1024\n"
+            "  -o results      the JSON file to write, defaults to stdout\n",
+            name);
+}
+
+}
+
+int main(int argc, char** argv) {
+    gcovbench::generator_config config;
+    size_t repetitions = 100U;
+    const char* output_path = nullptr;
+    const char* include_pattern = nullptr;
+    step_result steps;
+    steps.budget = 1024U;
+    for(int arg = 1; arg < argc; ++arg) {
+        const bool has_value = arg + 1 < argc;
+        if(!strcmp(argv[arg], "-f") && has_value) {
+            config.files = strtoul(argv[++arg], nullptr, 10);
+        } else if(!strcmp(argv[arg], "-F") && has_value) {
+            config.functions = strtoul(argv[++arg], nullptr, 10);
+        } else if(!strcmp(argv[arg], "-c") && has_value) {
+            config.counters = strtoul(argv[++arg], nullptr, 10);
+        } else if(!strcmp(argv[arg], "-z") && has_value) {
+            config.zero_share = strtod(argv[++arg], nullptr);
+        } else if(!strcmp(argv[arg], "-s") && has_value) {
+            config.seed = uint32_t(strtoul(argv[++arg], nullptr, 10));
+        } else if(!strcmp(argv[arg], "-r") && has_value) {
+            repetitions = strtoul(argv[++arg], nullptr, 10);
+        } else if(!strcmp(argv[arg], "-i") && has_value) {
+            include_pattern = argv[++arg];
+        } else if(!strcmp(argv[arg], "-b") && has_value) {
+            steps.budget = strtoul(argv[++arg], nullptr, 10);
+        } else if(!strcmp(argv[arg], "-o") && has_value) {
+            output_path = argv[++arg];
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if(!config.files || !repetitions || config.zero_share < 0.0 || config.zero_share > 1.0) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if(config.files > GCOV_MAX_FILES) {
+        fprintf(stderr, "Error: at most %u files can be registered\n", GCOV_MAX_FILES);
+        return EXIT_FAILURE;
+    }
+
+    gcovbench::synthetic_coverage coverage(config);
+    const serialization_result serialization = measure_serialization(coverage, repetitions);
+
+    // files can not be unregistered, so each run benchmarks a single configuration
+    for(gcov_info* info : coverage.infos())
+        __gcov_init(info);
+    std::vector<dump_result> dumps = {{"plain", 0U, nullptr},
+                                      {"packed", GCOV_IMAGE_PACKED_COUNTERS, nullptr},
+                                      {"checked", GCOV_IMAGE_CHECKED, nullptr},
+                                      {"hit_only", GCOV_IMAGE_HIT_ONLY, nullptr}};
+    const gcov_filter filter = {include_pattern, nullptr, 0U, true};
+    if(include_pattern)
+        dumps.push_back({"filtered", 0U, &filter});
+    for(dump_result& dump : dumps)
+        measure_dump(dump, repetitions);
+    measure_steps(steps, repetitions);
+    step_result delta_steps;
+    delta_steps.budget = steps.budget;
+    gcov_info* last_file = coverage.infos().back();
+    measure_steps(delta_steps, repetitions, last_file->functions[0]->ctrs[0].values,
+                  config.files * config.functions);
+    snapshot_result snapshot;
+    snapshot.counters = coverage.counters();
+    measure_snapshot(snapshot, repetitions);
+
+    FILE* output = output_path ? fopen(output_path, "w") : stdout;
+    if(!output) {
+        fprintf(stderr, "Error: can not write %s\n", output_path);
+        return EXIT_FAILURE;
+    }
+    write_results(output, config, repetitions, serialization, dumps, steps, delta_steps,
+                  snapshot);
+    if(output != stdout && fclose(output) != 0) {
+        fprintf(stderr, "Error: can not write %s\n", output_path);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
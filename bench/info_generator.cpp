@@ -0,0 +1,53 @@
+#include <cstdio>
+#include <random>
+
+#include "info_generator.hpp"
+
+namespace {
+
+// Any version works, the runtime copies it into the gcda header without interpreting it
+constexpr gcov_unsigned_t synthetic_version = 0x4234342AU;    // "B44*"
+
+}
+
+gcovbench::synthetic_coverage::synthetic_coverage(const generator_config& config)
+    : values(config.files * config.functions * config.counters),
+      functions(config.files * config.functions),
+      function_pointers(functions.size()),
+      filenames(config.files),
+      files(config.files),
+      info_pointers(config.files) {
+    std::mt19937 random(config.seed);
+    std::bernoulli_distribution zero(config.zero_share);
+    std::uniform_int_distribution<gcov_type> count(1, 1 << 20);
+    for(gcov_type& value : values)
+        value = zero(random) ? 0 : count(random);
+
+    for(size_t function_idx = 0U; function_idx < functions.size(); ++function_idx) {
+        gcov_fn_info& function = functions[function_idx];
+        function.key = nullptr;
+        function.ident = gcov_unsigned_t(function_idx);
+        function.lineno_checksum = gcov_unsigned_t(random());
+        function.cfg_checksum = gcov_unsigned_t(random());
+        function.ctrs[0].num = gcov_unsigned_t(config.counters);
+        function.ctrs[0].values = values.data() + function_idx * config.counters;
+        function_pointers[function_idx] = &function;
+    }
+
+    for(size_t file_idx = 0U; file_idx < files.size(); ++file_idx) {
+        char filename[64];
+        snprintf(filename, sizeof(filename), "/bench/synthetic/file_%06zu.gcda", file_idx);
+        filenames[file_idx] = filename;
+
+        gcov_info& file = files[file_idx];
+        file = {};
+        file.version = synthetic_version;
+        file.stamp = gcov_unsigned_t(random());
+        file.checksum = gcov_unsigned_t(random());
+        file.filename = filenames[file_idx].c_str();
+        file.merge[0] = __gcov_merge_add;
+        file.n_functions = unsigned(config.functions);
+        file.functions = function_pointers.data() + file_idx * config.functions;
+        info_pointers[file_idx] = &file;
+    }
+}
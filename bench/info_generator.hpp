@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+#include <gcov/gcov_info.h>
+}
+
+namespace gcovbench {
+
+/*! \brief The shape of the synthesized coverage data
+ */
+struct generator_config {
+    size_t files = 16U;         //!< The number of object files
+    size_t functions = 32U;     //!< The number of functions per file
+    size_t counters = 16U;      //!< The number of arc counters per function
+    double zero_share = 0.5;    //!< The share of counters which were never incremented
+    uint32_t seed = 1U;         //!< The seed of the counter values
+};
+
+/*! \brief Coverage data shaped like the data the compiler emits for instrumented objects
+ *
+ *  Each file uses the arc counters only, like objects built with --coverage. The counters are
+ *  filled with random values, the given share of them is zero. The object is not copyable
+ *  since the structures point into each other.
+ */
+class synthetic_coverage {
+public:
+    explicit synthetic_coverage(const generator_config& config);
+    synthetic_coverage(const synthetic_coverage&) = delete;
+    synthetic_coverage& operator=(const synthetic_coverage&) = delete;
+
+    /*! \brief Returns the data of the files, ready for __gcov_init() or gcov_convert_to_gcda()
+     */
+    std::vector<gcov_info*>& infos() { return info_pointers; }
+
+    /*! \brief Returns the number of counters of all files
+     */
+    size_t counters() const { return values.size(); }
+
+private:
+    std::vector<gcov_type> values;                   //!< The counters of all functions
+    std::vector<gcov_fn_info> functions;             //!< The functions of all files
+    std::vector<gcov_fn_info*> function_pointers;    //!< The function tables of all files
+    std::vector<std::string> filenames;              //!< The gcda paths of the files
+    std::vector<gcov_info> files;                    //!< The files
+    std::vector<gcov_info*> info_pointers;           //!< Pointers to the files
+};
+
+}
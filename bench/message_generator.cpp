@@ -0,0 +1,19 @@
+#include <random>
+
+#include "message_generator.hpp"
+
+gcovbench::message_set gcovbench::generate_messages(const size_t count, const uint32_t seed) {
+    std::mt19937 random(seed);
+    message_set set;
+    set.payload.resize(4096U);
+    for(uint8_t& byte : set.payload)
+        byte = uint8_t(random());
+    set.messages.resize(count);
+    for(test::message& message : set.messages) {
+        const uint32_t share = random() % 100U;
+        message.type = share < 90U ? 0U : share % 4U;
+        message.length = share < 80U ? 48U : random() % 256U;
+        message.payload = set.payload.data() + random() % 2048U;
+    }
+    return set;
+}
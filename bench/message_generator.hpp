@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <test/workload.hpp>
+
+namespace gcovbench {
+
+/*! \brief The messages of a run and the payload they point into
+ */
+struct message_set {
+    std::vector<uint8_t> payload;           //!< The payload of all messages
+    std::vector<test::message> messages;    //!< The messages
+};
+
+/*! \brief Generates messages like the traffic of a typical protocol
+ *
+ *  \param[in]  count   The number of messages
+ *  \param[in]  seed    The seed of the messages
+ *  \return             The messages
+ *
+ *  Most messages are of the first type and have the same length, the rest is spread over all
+ *  types and lengths.
+ */
+message_set generate_messages(size_t count, uint32_t seed);
+
+}
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#ifdef GCOV_OVERHEAD_INSTRUMENTED
+extern "C" {
+#include <gcov/gcov.h>
+}
+#endif
+
+#include <test/workload.hpp>
+
+#include "message_generator.hpp"
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+#ifdef GCOV_OVERHEAD_INSTRUMENTED
+constexpr char variant[] = "instrumented";
+#else
+constexpr char variant[] = "plain";
+#endif
+
+/*! \brief The configuration of a run
+ */
+struct overhead_config {
+    size_t messages = 4096U;      //!< The number of messages per repetition
+    uint32_t block_size = 16U;    //!< The block size passed to process_messages()
+    uint32_t seed = 1U;           //!< The seed of the messages
+    size_t repetitions = 200U;    //!< The number of measured repetitions
+};
+
+#ifdef GCOV_OVERHEAD_INSTRUMENTED
+int write_image(void* context, const unsigned char* data, const size_t size) {
+    return fwrite(data, 1U, size, static_cast<FILE*>(context)) == size ? 0 : -1;
+}
+
+/*! \brief Writes the counters of the measured repetitions as image for gcov_hot
+ */
+bool dump_counters(const char* path) {
+    FILE* file = fopen(path, "wb");
+    if(!file)
+        return false;
+    const gcov_sink sink = {nullptr, write_image, nullptr, file};
+    set_gcov_sink(&sink);
+    const int status = gcov_dump_step(SIZE_MAX);
+    // the dump at exit has no sink then
+    set_gcov_sink(nullptr);
+    return (fclose(file) == 0) && (status == GCOV_DUMP_DONE);
+}
+#endif
+
+void print_usage(const char* name) {
+    fprintf(stderr,
+            "Usage: %s [-m messages] [-b block size] [-s seed] [-r repetitions] [-p image]\n"
+            "          [-o results]\n"
+            "Measures the message processing of the %s build of libtest.\n"
+            "  -m messages     the number of messages per repetition, defaults to 4096\n"
+            "  -b block size   the block size of the handlers, defaults to 16\n"
+            "  -s seed         the seed of the messages, defaults to 1\n"
+            "  -r repetitions  the number of measured repetitions, defaults to 200\n"
+            "  -p image        the image with the counters of the measured repetitions, only\n"
+            "                  written by the instrumented build\n"
+            "  -o results      the JSON file to write, defaults to stdout\n",
+            name, variant);
+}
+
+}
+
+int main(int argc, char** argv) {
+    overhead_config config;
+    const char* image_path = nullptr;
+    const char* output_path = nullptr;
+    for(int arg = 1; arg < argc; ++arg) {
+        const bool has_value = arg + 1 < argc;
+        if(!strcmp(argv[arg], "-m") && has_value) {
+            config.messages = strtoul(argv[++arg], nullptr, 10);
+        } else if(!strcmp(argv[arg], "-b") && has_value) {
+            config.block_size = uint32_t(strtoul(argv[++arg], nullptr, 10));
+        } else if(!strcmp(argv[arg], "-s") && has_value) {
+            config.seed = uint32_t(strtoul(argv[++arg], nullptr, 10));
+        } else if(!strcmp(argv[arg], "-r") && has_value) {
+            config.repetitions = strtoul(argv[++arg], nullptr, 10);
+        } else if(!strcmp(argv[arg], "-p") && has_value) {
+            image_path = argv[++arg];
+        } else if(!strcmp(argv[arg], "-o") && has_value) {
+            output_path = argv[++arg];
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if(!config.messages || !config.block_size || !config.repetitions) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const gcovbench::message_set set = gcovbench::generate_messages(config.messages, config.seed);
+#ifdef GCOV_OVERHEAD_INSTRUMENTED
+    // the image only counts the measured repetitions
+    __gcov_reset();
+#endif
+    std::vector<double> samples;
+    uint64_t checksum = 0U;
+    for(size_t repetition = 0U; repetition < config.repetitions; ++repetition) {
+        const bench_clock::time_point start = bench_clock::now();
+        checksum += test::process_messages(set.messages.data(), set.messages.size(),
+                                           config.block_size);
+        samples.push_back(std::chrono::duration<double>(bench_clock::now() - start).count()
+                          * 1e9 / double(config.messages));
+    }
+    std::sort(samples.begin(), samples.end());
+#ifdef GCOV_OVERHEAD_INSTRUMENTED
+    if(image_path && !dump_counters(image_path)) {
+        fprintf(stderr, "Error: can not write the image %s\n", image_path);
+        return EXIT_FAILURE;
+    }
+#else
+    if(image_path)
+        fprintf(stderr, "Warning: the plain build has no counters, %s is not written\n",
+                image_path);
+#endif
+
+    FILE* output = output_path ? fopen(output_path, "w") : stdout;
+    if(!output) {
+        fprintf(stderr, "Error: can not write %s\n", output_path);
+        return EXIT_FAILURE;
+    }
+    char timestamp[32];
+    const time_t now = time(nullptr);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+    // both builds compute the same checksum for the same seed
+    fprintf(output,
+            "{\n"
+            "  \"benchmark\": \"gcov_overhead_bench\",\n"
+            "  \"timestamp\": \"%s\",\n"
+            "  \"compiler\": \"%s\",\n"
+            "  \"variant\": \"%s\",\n"
+            "  \"flags\": \"%s\",\n"
+            "  \"config\": {\"messages\": %zu, \"block_size\": %u, \"seed\": %u, "
+            "\"repetitions\": %zu},\n"
+            "  \"ns_per_message\": {\"min\": %.3f, \"median\": %.3f},\n"
+            "  \"checksum\": %llu\n"
+            "}\n",
+            timestamp, __VERSION__, variant, GCOV_OVERHEAD_FLAGS, config.messages,
+            config.block_size, config.seed, config.repetitions, samples.front(),
+            samples[samples.size() / 2U], (unsigned long long) checksum);
+    if(output != stdout && fclose(output) != 0) {
+        fprintf(stderr, "Error: can not write %s\n", output_path);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
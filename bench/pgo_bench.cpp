@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#ifdef GCOV_PGO_GENERATE
+extern "C" {
+#include <gcov/gcov.h>
+}
+#endif
+
+#include <test/workload.hpp>
+
+#include "message_generator.hpp"
+
+namespace {
+
+using bench_clock = std::chrono::steady_clock;
+
+/*! \brief The configuration of a run
+ */
+struct pgo_config {
+    size_t messages = 4096U;      //!< The number of messages per repetition
+    uint32_t block_size = 16U;    //!< The block size passed to process_messages()
+    uint32_t seed = 1U;           //!< The seed of the messages
+    size_t repetitions = 200U;    //!< The number of measured repetitions
+};
+
+#ifdef GCOV_PGO_GENERATE
+int write_profile(void* context, const unsigned char* data, const size_t size) {
+    return fwrite(data, 1U, size, static_cast<FILE*>(context)) == size ? 0 : -1;
+}
+
+/*! \brief Writes the profile of the training run as image, gcov_merge turns it into gcda files
+ */
+bool dump_profile(const char* path) {
+    FILE* file = fopen(path, "wb");
+    if(!file)
+        return false;
+    const gcov_sink sink = {nullptr, write_profile, nullptr, file};
+    set_gcov_sink(&sink);
+    const int status = gcov_dump_step(SIZE_MAX);
+    // the dump at exit has no sink then
+    set_gcov_sink(nullptr);
+    return (fclose(file) == 0) && (status == GCOV_DUMP_DONE);
+}
+#endif
+
+void print_usage(const char* name) {
+    fprintf(stderr,
+            "Usage: %s [-m messages] [-b block size] [-s seed] [-r repetitions] [-p profile]\n"
+            "          [-o results]\n"
+            "Measures the message processing of libtest, built for the PGO phase %s.\n"
+            "  -m messages     the number of messages per repetition, defaults to 4096\n"
+            "  -b block size   the block size of the handlers, defaults to 16\n"
+            "  -s seed         the seed of the messages, defaults to 1\n"
+            "  -r repetitions  the number of measured repetitions, defaults to 200\n"
+            "  -p profile      the image the GENERATE phase writes, defaults to pgo_profile.bin\n"
+            "  -o results      the JSON file to write, defaults to stdout\n",
+            name, GCOV_PGO_PHASE);
+}
+
+}
+
+int main(int argc, char** argv) {
+    pgo_config config;
+    const char* profile_path = "pgo_profile.bin";
+    const char* output_path = nullptr;
+    for(int arg = 1; arg < argc; ++arg) {
+        const bool has_value = arg + 1 < argc;
+        if(!strcmp(argv[arg], "-m") && has_value) {
+            config.messages = strtoul(argv[++arg], nullptr, 10);
+        } else if(!strcmp(argv[arg], "-b") && has_value) {
+            config.block_size = uint32_t(strtoul(argv[++arg], nullptr, 10));
+        } else if(!strcmp(argv[arg], "-s") && has_value) {
+            config.seed = uint32_t(strtoul(argv[++arg], nullptr, 10));
+        } else if(!strcmp(argv[arg], "-r") && has_value) {
+            config.repetitions = strtoul(argv[++arg], nullptr, 10);
+        } else if(!strcmp(argv[arg], "-p") && has_value) {
+            profile_path = argv[++arg];
+        } else if(!strcmp(argv[arg], "-o") && has_value) {
+            output_path = argv[++arg];
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if(!config.messages || !config.block_size || !config.repetitions) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const gcovbench::message_set set = gcovbench::generate_messages(config.messages, config.seed);
+    std::vector<double> samples;
+    uint64_t checksum = 0U;
+    for(size_t repetition = 0U; repetition < config.repetitions; ++repetition) {
+        const bench_clock::time_point start = bench_clock::now();
+        checksum += test::process_messages(set.messages.data(), set.messages.size(),
+                                           config.block_size);
+        samples.push_back(std::chrono::duration<double>(bench_clock::now() - start).count()
+                          * 1e9 / double(config.messages));
+    }
+    std::sort(samples.begin(), samples.end());
+#ifdef GCOV_PGO_GENERATE
+    if(!dump_profile(profile_path)) {
+        fprintf(stderr, "Error: can not write the profile %s\n", profile_path);
+        return EXIT_FAILURE;
+    }
+#else
+    (void) profile_path;
+#endif
+
+    FILE* output = output_path ? fopen(output_path, "w") : stdout;
+    if(!output) {
+        fprintf(stderr, "Error: can not write %s\n", output_path);
+        return EXIT_FAILURE;
+    }
+    char timestamp[32];
+    const time_t now = time(nullptr);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+    // for the same seed all phases compute the same checksum
+    fprintf(output,
+            "{\n"
+            "  \"benchmark\": \"gcov_pgo_bench\",\n"
+            "  \"timestamp\": \"%s\",\n"
+            "  \"compiler\": \"%s\",\n"
+            "  \"phase\": \"%s\",\n"
+            "  \"config\": {\"messages\": %zu, \"block_size\": %u, \"seed\": %u, "
+            "\"repetitions\": %zu},\n"
+            "  \"ns_per_message\": {\"min\": %.3f, \"median\": %.3f},\n"
+            "  \"checksum\": %llu\n"
+            "}\n",
+            timestamp, __VERSION__, GCOV_PGO_PHASE, config.messages, config.block_size,
+            config.seed, config.repetitions, samples.front(), samples[samples.size() / 2U],
+            (unsigned long long) checksum);
+    if(output != stdout && fclose(output) != 0) {
+        fprintf(stderr, "Error: can not write %s\n", output_path);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
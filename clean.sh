@@ -2,3 +2,5 @@
 rm -rf output/*
 rm -rf build
 rm -rf results
+rm -rf build-bench
+rm -rf build-pgo
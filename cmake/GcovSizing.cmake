@@ -0,0 +1,33 @@
+# gcov_sizing_header(<target> INSTRUMENTED <targets>... [IMAGE_BUFFER_SIZE <bytes>])
+#
+# Generates gcov/gcov_sizing.h with upper bounds of the coverage data of the instrumented
+# targets once they are built and compiles <target> with it, see tools/gcov_sizing.cpp.
+# libgcov sizes its registration table from the header, and with IMAGE_BUFFER_SIZE the build
+# fails if a complete image does not fit into a buffer of that size.
+function(gcov_sizing_header TARGET)
+    cmake_parse_arguments(PARSE_ARGV 1 SIZING "" "IMAGE_BUFFER_SIZE" "INSTRUMENTED")
+
+    set(directory ${CMAKE_CURRENT_BINARY_DIR}/${TARGET}_sizing)
+    set(header ${directory}/gcov/gcov_sizing.h)
+    set(arguments -o ${header})
+    if(SIZING_IMAGE_BUFFER_SIZE)
+        list(APPEND arguments -m ${SIZING_IMAGE_BUFFER_SIZE})
+    endif()
+    foreach(instrumented ${SIZING_INSTRUMENTED})
+        list(APPEND arguments $<TARGET_OBJECTS:${instrumented}>)
+    endforeach()
+
+    # depending on the targets reruns the sizing whenever one of them was linked again
+    add_custom_command(OUTPUT ${header}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${directory}/gcov
+        COMMAND gcov_sizing ${arguments}
+        DEPENDS gcov_sizing ${SIZING_INSTRUMENTED}
+        COMMENT "Sizing the coverage data of ${SIZING_INSTRUMENTED}"
+        COMMAND_EXPAND_LISTS
+        VERBATIM)
+    add_custom_target(${TARGET}_sizing DEPENDS ${header})
+
+    add_dependencies(${TARGET} ${TARGET}_sizing)
+    target_include_directories(${TARGET} PUBLIC $<BUILD_INTERFACE:${directory}>)
+    target_compile_definitions(${TARGET} PUBLIC GCOV_SIZING)
+endfunction()
@@ -1,90 +1,406 @@
 import argparse
+import mmap
 import pathlib
 import re
+import struct
+import zlib
+
+# Layout of the coverage image, see libgcov/include/gcov/gcov.h
+IMAGE_MAGIC = b"GCIM"
+IMAGE_HEADER_SIZE = 16
+IMAGE_V3_HEADER_SIZE = 8
+IMAGE_LENGTH_OFFSET = 8
+IMAGE_TOC_ENTRY_SIZE = 12
+IMAGE_TRAILER_SIZE = 8
+IMAGE_PACKED_COUNTERS = 0x01
+IMAGE_DELTA = 0x02
+IMAGE_FILTERED = 0x08
+IMAGE_CHECKED = 0x10
+IMAGE_HIT_ONLY = 0x20
+IMAGE_TEST = 0x40
+IMAGE_INCOMPLETE = 0x80
+END_MARKER = b"Gcov End\0"
+
+GCOV_DATA_MAGIC = 0x67636461
+GCOV_TAG_FUNCTION = 0x01000000
+GCOV_TAG_COUNTER_BASE = 0x01a10000
+GCOV_COUNTERS = 9
+GCOV_COUNTER_TAGS = {GCOV_TAG_COUNTER_BASE + (i << 17) for i in range(GCOV_COUNTERS)}
+GCOV_TAG_HIT_BITS = 0x00000001
 
 class gcda_splitter:
+    """Splits images of the legacy headerless layout into their gcda files"""
     def __init__(self):
         return
 
-    def _parse_filepath(self, content: list):
-        """Parses a filepath from a byte list. Parses until the end token .gcda is encountered
-        content: list
-            List of bytes. The list starts with a '/'
-        end_of_file_path = ".gcda"
+    def split_gcda(self, content: bytes):
+        """Expects the raw bytes of a legacy image that is output by the testrun
+        content: bytes
+            The raw image, each record consists of the filepath with trailing null character,
+            the length of the gcda data with MSB first and the gcda data
+        Returns a dictionary with key filepath and the value as the actual gcda data
         """
-        end_of_file_path = ".gcda"
-        filepath : str = ""
-        for i in range(len(content)):
-            # terminate early on null-character
-            if chr(content[i]) == '\0':
-                return filepath
-            # check if a byte is a dot and we still have room till the actual file end
-            if chr(content[i]) == '.' and (len(content) - i) >= len(end_of_file_path):
-                # join the characters and compare if it matches the .gcda token
-                token = "".join(chr(c) for c in content[i:i+len(end_of_file_path)])
-                if token == end_of_file_path:
-                    filepath = content[:i+len(end_of_file_path)]
-                    print("Found filepath ", filepath)
-                    break
-        return filepath
+        gcda_files = dict()
+        pos = 0
+        while pos < len(content) and content[pos:pos + len(END_MARKER)] != END_MARKER:
+            path_end = content.index(b"\0", pos)
+            path = content[pos:path_end]
+            print("Found filepath ", path)
+            (length,) = struct.unpack_from(">I", content, path_end + 1)
+            data_start = path_end + 5
+            if data_start + length > len(content):
+                raise Exception("Record of {} exceeds the image".format(path))
+            gcda_files[path] = content[data_start:data_start + length]
+            pos = data_start + length
+        return gcda_files
 
-    def split_gcda(self, content: list):
-        """Expects a list of bytes from a merged gcda file that is output by the testrun
-        content: list
-            List of bytes holding all the raw gcda data from a testrun
-        Returns a dictionary with key filepath and the value as the actual gcda data
+class counter_unpacker:
+    """Expands gcda records with packed counters (zero runs and LEB128 values) to plain gcda"""
+    def __init__(self):
+        return
+
+    @staticmethod
+    def _read_leb128(data: bytes, pos: int):
+        value = 0
+        shift = 0
+        while True:
+            byte = data[pos]
+            pos += 1
+            value |= (byte & 0x7f) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value, pos
+
+    def _expand_values(self, data: bytes, pos: int, num: int, endian: str):
+        """Decodes num packed counters starting at pos
+        Returns the plain counter words and the position behind the padded encoded values
         """
-        filepaths = list()
-        i = 0
-        while i  < len(content):
-            # check if we encountered a slash and then check if we have a valid filepath
-            if chr(content[i]) == '/':
-                file_path = self._parse_filepath(content[i:])
-                # if the path is valid increment the loop variable by the filelength
-                # to prevent any submatches, like 1. /home/user/file.gcda, 2. /user/file.gcda
-                if file_path:
-                    filepaths.append({"pos": i, "path": file_path})
-                    i += len(file_path)
-            i += 1
-        if len(filepaths) == 0:
-            return
+        start = pos
+        values = list()
+        while len(values) < num:
+            value, pos = self._read_leb128(data, pos)
+            if value:
+                values.append(value)
+            else:
+                run, pos = self._read_leb128(data, pos)
+                if run > num - len(values):
+                    raise Exception("Packed counters exceed their record")
+                values.extend([0] * run)
+        if len(values) != num:
+            raise Exception("Packed counters exceed their record")
+        pos += (4 - (pos - start) % 4) % 4
+        # gcov stores 64 bit counters as two words, the low part first
+        return b"".join(struct.pack(endian + "II", v & 0xffffffff, v >> 32) for v in values), pos
 
-        gcda_files = dict()
-        # iterate over the found files
-        for i in range(len(filepaths)):
-            # if we got the last element extract data from the end of the filepath + terminating null character
-            # + 4 Bytes which indicate the length of the gcda data. After this the actual header of the gcda file
-            # starts with 12 Byte of magic number, version and crc. Extract until 9 Bytes before the end because
-            # the gcda file ends with "Gcov End\0"
-            data = list()
-            if i == (len(filepaths) - 1):
-                data = content[filepaths[i]["pos"] + len(filepaths[i]["path"]) + 5: len(content)-9]
+    @staticmethod
+    def _expand_hit_bits(data: bytes, pos: int, num: int, endian: str):
+        """Decodes num counters stored as hit bits, a word per 32 counters, starting at pos
+        Returns the plain counter words with counts of 0 or 1 and the position behind the bits
+        """
+        end = pos + (num + 31) // 32 * 4
+        if end > len(data):
+            raise Exception("Hit bits exceed their record")
+        bits = data[pos:end]
+        return b"".join(struct.pack(endian + "II", (bits[i // 8] >> (i % 8)) & 1, 0)
+                        for i in range(num)), end
+
+    @staticmethod
+    def _endian(data: bytes, pos: int = 0):
+        return "<" if struct.unpack_from("<I", data, pos)[0] == GCOV_DATA_MAGIC else ">"
+
+    def expand(self, data: bytes):
+        """Expands the packed counter records of a single gcda file of a version 1 image
+        data: bytes
+            The gcda data with packed counter records, the record length covers the number of
+            counters and the encoded values
+        Returns the plain gcda data
+        """
+        endian = self._endian(data)
+        # the header consists of magic, version, stamp and checksum
+        output = [data[:16]]
+        pos = 16
+        while pos + 8 <= len(data):
+            tag, length = struct.unpack_from(endian + "II", data, pos)
+            payload = data[pos + 8:pos + 8 + length]
+            if tag in GCOV_COUNTER_TAGS:
+                (num,) = struct.unpack_from(endian + "I", payload, 0)
+                payload, _ = self._expand_values(payload, 4, num, endian)
+            output.append(struct.pack(endian + "II", tag, len(payload)))
+            output.append(payload)
+            pos += 8 + length
+        return b"".join(output)
+
+    def read_gcda(self, content: bytes, pos: int, packed: bool):
+        """Reads the gcda data of a record which is terminated by a zero tag
+        content: bytes
+            The raw image
+        pos: int
+            The position of the gcda data in the image
+        packed: bool
+            True if the counter records hold the number of counters and the packed values
+        Returns the plain gcda data and the position behind the terminating zero tag
+        """
+        endian = self._endian(content, pos)
+        output = [content[pos:pos + 16]]
+        pos += 16
+        while True:
+            (tag,) = struct.unpack_from(endian + "I", content, pos)
+            if not tag:
+                return b"".join(output), pos + 4
+            (length,) = struct.unpack_from(endian + "I", content, pos + 4)
+            pos += 8
+            if tag & GCOV_TAG_HIT_BITS and tag & ~GCOV_TAG_HIT_BITS in GCOV_COUNTER_TAGS:
+                # the length holds the number of counters
+                tag &= ~GCOV_TAG_HIT_BITS
+                payload, pos = self._expand_hit_bits(content, pos, length, endian)
+            elif packed and tag in GCOV_COUNTER_TAGS:
+                payload, pos = self._expand_values(content, pos, length, endian)
             else:
-                # extract data that starting from 5 Bytes after the filepath end until the start of the next filepath
-                data = \
-                    content[filepaths[i]["pos"] + len(filepaths[i]["path"]) + 5 : filepaths[i+1]["pos"]]
+                payload = content[pos:pos + length]
+                pos += length
+            output.append(struct.pack(endian + "II", tag, len(payload)))
+            output.append(payload)
 
-            #data = b''.join([bytes([b]) for b in data if (b == 9 or b == 10 or b == 13 or (b>31 and b <127))])
+class image_reader:
+    """Reads coverage images which start with the GCIM image header"""
+    def __init__(self):
+        return
 
-            gcda_files[filepaths[i]["path"]] = data
-        return gcda_files
+    @staticmethod
+    def is_image(content: bytes):
+        return content[:len(IMAGE_MAGIC)] == IMAGE_MAGIC
+
+    @staticmethod
+    def _is_gcda(content: bytes, pos: int):
+        return content[pos:pos + 4] in (struct.pack("<I", GCOV_DATA_MAGIC),
+                                        struct.pack(">I", GCOV_DATA_MAGIC))
+
+    @staticmethod
+    def _read_toc(content: bytes, size: int, header_size: int):
+        """Reads the table of contents of an image since version 3
+        Returns a list of record offset, data offset and data length tuples, None if the image
+        has no valid table of contents, e.g. because it was truncated
+        """
+        trailer = size - len(END_MARKER) - IMAGE_TRAILER_SIZE
+        if trailer < header_size or content[trailer + IMAGE_TRAILER_SIZE:size] != END_MARKER:
+            return None
+        toc_offset, count = struct.unpack_from(">II", content, trailer)
+        if toc_offset < header_size or toc_offset + count * IMAGE_TOC_ENTRY_SIZE != trailer:
+            return None
+        return [struct.unpack_from(">III", content, toc_offset + i * IMAGE_TOC_ENTRY_SIZE)
+                for i in range(count)]
+
+    @staticmethod
+    def _image_size(content: bytes):
+        """Checks the length and the CRC-32 in the header of a version 4 image
+        Returns the length of the image, or the size of the content if the header holds none
+        """
+        length, crc = struct.unpack_from(">II", content, IMAGE_LENGTH_OFFSET)
+        if not length:
+            return len(content)
+        if length > len(content):
+            print("Warning: image is truncated, {} of {} bytes".format(len(content), length))
+            return len(content)
+        # the CRC-32 was calculated with the length and the CRC-32 zero
+        actual = zlib.crc32(content[:IMAGE_LENGTH_OFFSET])
+        actual = zlib.crc32(bytes(8), actual)
+        actual = zlib.crc32(content[IMAGE_HEADER_SIZE:length], actual)
+        if actual != crc:
+            raise Exception("Image length or CRC-32 does not match")
+        return length
+
+    def read_records(self, content: bytes):
+        """Splits an image into its records and expands packed counters
+        content: bytes
+            The raw image starting with the image header
+        Returns the image flags, the dump sequence number, a dictionary with key filepath and
+        the plain gcda data as value and the number of gcda bytes in the image
+        """
+        version = content[4]
+        flags = content[5]
+        (sequence,) = struct.unpack_from(">H", content, 6)
+        if version not in (1, 2, 3, 4):
+            raise Exception("Unsupported image version {}".format(version))
+        if flags & IMAGE_FILTERED:
+            print("Image is filtered, only the selected files and functions are included")
+        if flags & IMAGE_TEST:
+            print("Image of test {}, only the functions it executed are included".format(sequence))
+        if flags & IMAGE_INCOMPLETE:
+            print("Warning: object files beyond GCOV_MAX_FILES are missing from the image")
+
+        unpacker = counter_unpacker()
+        packed = bool(flags & IMAGE_PACKED_COUNTERS)
+        # hit bits records are expanded while reading the gcda data
+        expand = bool(flags & (IMAGE_PACKED_COUNTERS | IMAGE_HIT_ONLY))
+        records = dict()
+        raw_size = 0
+        header_size = IMAGE_HEADER_SIZE if version >= 4 else IMAGE_V3_HEADER_SIZE
+        if version >= 4 and flags & IMAGE_CHECKED:
+            # a single reader recovers the records of damaged images, see libgcovhost/src/image.cpp
+            raise Exception("Checked images are read by gcov_merge and gcov_lcov")
+        # bytes behind the image, e.g. the rest of the buffer, are ignored
+        size = self._image_size(content) if version >= 4 else len(content)
+
+        toc = self._read_toc(content, size, header_size) if version >= 3 else None
+        if toc is not None:
+            # records are sliced directly from the table of contents
+            for record_offset, data_offset, length in toc:
+                path = content[record_offset:data_offset - 1]
+                print("Found filepath ", path)
+                if data_offset + length > size:
+                    raise Exception("Record of {} exceeds the image".format(path))
+                if expand:
+                    records[path], _ = unpacker.read_gcda(content, data_offset, packed)
+                else:
+                    records[path] = content[data_offset:data_offset + length]
+                raw_size += length
+            return flags, sequence, records, raw_size
+
+        pos = header_size
+        while pos < size and content[pos:pos + len(END_MARKER)] != END_MARKER:
+            path_end = content.find(b"\0", pos, size)
+            if path_end < 0:
+                break
+            path = content[pos:path_end]
+            # the table of contents behind the records of version 3 images ends the walk
+            if version >= 3 and not self._is_gcda(content, path_end + 1):
+                break
+            print("Found filepath ", path)
+            if version == 1:
+                # version 1 records are framed by their length
+                (length,) = struct.unpack_from(">I", content, path_end + 1)
+                data_start = path_end + 5
+                if data_start + length > size:
+                    raise Exception("Record of {} exceeds the image".format(path))
+                data = content[data_start:data_start + length]
+                records[path] = unpacker.expand(data) if packed else data
+                pos = data_start + length
+            else:
+                # without table of contents the records are walked up to their zero tag
+                try:
+                    records[path], pos = unpacker.read_gcda(content, path_end + 1, packed)
+                except (IndexError, struct.error):
+                    print("Warning: image is truncated in the record of {}".format(path))
+                    break
+            raw_size += pos - path_end - 1
+        return flags, sequence, records, raw_size
+
+class gcda_delta_merger:
+    """Reconstructs cumulative gcda data from a base image and a chain of delta images"""
+    def __init__(self):
+        return
+
+    @staticmethod
+    def _split_functions(data: bytes):
+        """Splits plain gcda data into its header and the records of each function
+        Returns the header, the records in front of the first function, e.g. the object summary,
+        and a dictionary with the function ident as key and the function record including its
+        counter records as value
+        """
+        endian = "<" if struct.unpack_from("<I", data, 0)[0] == GCOV_DATA_MAGIC else ">"
+        functions = dict()
+        summary = bytearray()
+        ident = None
+        pos = 16
+        while pos + 8 <= len(data):
+            tag, length = struct.unpack_from(endian + "II", data, pos)
+            if tag == GCOV_TAG_FUNCTION:
+                (ident,) = struct.unpack_from(endian + "I", data, pos + 8)
+                functions[ident] = bytearray()
+            if ident is not None:
+                functions[ident] += data[pos:pos + 8 + length]
+            else:
+                summary += data[pos:pos + 8 + length]
+            pos += 8 + length
+        return data[:16], summary, functions
+
+    def summary(self, data: bytes):
+        """Returns the records of plain gcda data in front of the first function"""
+        return self._split_functions(data)[1]
+
+    def apply(self, base: bytes, delta: bytes, summary: bytes):
+        """Replaces the functions of the base gcda data by the ones contained in the delta
+        base: bytes
+            The plain gcda data of a file up to the previous dump
+        delta: bytes
+            The plain gcda data of the same file with the functions changed since then, None if
+            the file did not change
+        summary: bytes
+            The object summary of the delta dump, the largest arc counter is taken over all files
+            so it also changes for files without changes
+        Returns the plain gcda data up to the delta dump
+        """
+        base_header, _, functions = self._split_functions(base)
+        if delta is not None:
+            delta_header, _, changed = self._split_functions(delta)
+            if base_header != delta_header:
+                raise Exception("Delta does not belong to the base data")
+            functions.update(changed)
+        return base_header + summary + b"".join(functions.values())
+
+def read_image(path: str):
+    """Reads a raw coverage image from the target application
+    path: str
+        The path to the raw gcov output
+    Returns the image flags, the dump sequence number and a dictionary with key filepath and the
+    plain gcda data as value
+    """
+    with open(path, "rb") as f:
+        if not pathlib.Path(path).stat().st_size:
+            raise Exception("{} is empty".format(path))
+        # the records are sliced out of the mapped image instead of reading it as a whole
+        with mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as content:
+            if not image_reader.is_image(content):
+                return 0, 0, gcda_splitter().split_gcda(content)
+            flags, sequence, gcdas, raw_size = image_reader().read_records(content)
+
+    if flags & (IMAGE_PACKED_COUNTERS | IMAGE_HIT_ONLY):
+        expanded_size = sum(len(data) for data in gcdas.values())
+        print("{}: {} bytes expanded to {} bytes, compression ratio {:.2f}".format(
+            "Packed counters" if flags & IMAGE_PACKED_COUNTERS else "Hit bits",
+            raw_size, expanded_size, expanded_size / max(raw_size, 1)))
+    return flags, sequence, gcdas
+
+def rebuild_gcdas(image_path: str, delta_paths: list):
+    """Reads an image and applies a chain of delta images on top of it
+    image_path: str
+        The path to the image, the base image of the chain if there are delta images
+    delta_paths: list
+        The paths to the delta images in the order they were dumped
+    Returns a dictionary with key filepath and the plain gcda data up to the last image as value
+    """
+    _, sequence, gcdas = read_image(image_path)
+
+    merger = gcda_delta_merger()
+    for delta_path in delta_paths:
+        flags, delta_sequence, deltas = read_image(delta_path)
+        if not flags & IMAGE_DELTA:
+            raise Exception("{} is not a delta image".format(delta_path))
+        if delta_sequence != ((sequence + 1) & 0xffff):
+            print("Warning: {} has sequence {}, expected {}".format(
+                delta_path, delta_sequence, (sequence + 1) & 0xffff))
+        sequence = delta_sequence
+        # all records of an image share the summary, without records no counter changed
+        if not deltas:
+            continue
+        summary = merger.summary(next(iter(deltas.values())))
+        for path, data in deltas.items():
+            gcdas[path] = merger.apply(gcdas[path], data, summary) if path in gcdas else data
+        for path in gcdas.keys() - deltas.keys():
+            gcdas[path] = merger.apply(gcdas[path], None, summary)
+    return gcdas
 
 if __name__ == "__main__":
     parser  = argparse.ArgumentParser()
     parser.add_argument("-p", "--path", help="The path to the raw gcov output from the target application")
+    parser.add_argument("-d", "--delta", nargs="+",
+                        help="Delta images to apply on top of --path, in the order they were dumped")
     args = parser.parse_args()
     if not args.path:
         raise Exception("Missing filepath for gcov input file")
 
 
-    splitter = gcda_splitter()
-    content = ""
-
-    with open(args.path, "rb") as f:
-        content = f.read()
-
-    gcdas = splitter.split_gcda(content)
-
+    gcdas = rebuild_gcdas(args.path, args.delta or [])
     for path, data in gcdas.items():
         with open(path, "wb") as f:
             f.write(data)
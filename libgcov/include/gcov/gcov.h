@@ -76,6 +76,7 @@
 #ifndef LIB_GCOV_H
 #define LIB_GCOV_H
 
+#include <stdbool.h>
 #include <stddef.h>
 
 #if !defined(__GNUC__) || (__GNUC__ != 14)
@@ -90,13 +91,423 @@ typedef long long gcov_type;
 // This is dependent on the gcc/gcov-counter.def and correponds to the number of counters
 // listed in that file, see also gcc/gcov-io.h
 #define GCOV_COUNTERS                9
+#define GCOV_COUNTER_ARCS            0U    // the first type, merged with __gcov_merge_add
+#define GCOV_COUNTER_V_TOPN          3U    // the topn values, merged with __gcov_merge_topn
+#define GCOV_COUNTER_V_INDIR         4U    // the indirect call targets, merged like topn
 #define GCOV_DATA_MAGIC              ((gcov_unsigned_t) 0x67636461)    // "gcda"
 #define GCOV_TAG_FUNCTION            ((gcov_unsigned_t) 0x01000000)
+#define GCOV_TAG_OBJECT_SUMMARY      ((gcov_unsigned_t) 0xa1000000)    // runs, largest arc counter
 #define GCOV_TAG_COUNTER_BASE        ((gcov_unsigned_t) 0x01a10000)
 #define GCOV_TAG_FOR_COUNTER(COUNT)  (GCOV_TAG_COUNTER_BASE + ((gcov_unsigned_t) (COUNT) << 17))
 #define GCOV_WORD_SIZE               4
 #define GCOV_TAG_FUNCTION_LENGTH     (3 * GCOV_WORD_SIZE)
 #define GCOV_TAG_COUNTER_LENGTH(NUM) ((NUM) * 2 * GCOV_WORD_SIZE)
+#define GCOV_TAG_SUMMARY_LENGTH      (2 * GCOV_WORD_SIZE)
+//! Set in the tag of arc counter records of GCOV_IMAGE_HIT_ONLY images. The record length is the
+//! number of counters, the record holds a word per 32 counters with a bit set per hit counter,
+//! the first counter in the LSB of the first byte.
+#define GCOV_TAG_HIT_BITS            ((gcov_unsigned_t) 0x00000001)
+//! The counters of a topn profiler in memory: the number of calls, the number of tracked values
+//! and the list of value/count pairs. In gcda data the list is replaced by the pairs.
+#define GCOV_TOPN_MEM_COUNTERS       3U
+//! The maximum number of values a topn profiler tracks, compare to libgcc/libgcov.h
+#define GCOV_TOPN_MAX_VALUES         32U
+#define GCOV_ACCUMULATOR_MAGIC       ((gcov_unsigned_t) 0x67636163)    // "gcac"
+//! The size of the header in front of the counters of the accumulation area
+#define GCOV_ACCUMULATOR_HEADER_SIZE (4 * GCOV_WORD_SIZE)
+
+// Images start with a header of GCOV_IMAGE_HEADER_SIZE bytes: the magic, the version, the
+// flags, the 16 bit dump sequence number, the length of the image and its CRC-32. Each record
+// consists of the filename with trailing null char and the gcda data terminated by a zero tag.
+// The records are followed by a table of contents with one entry per record, the offset of the
+// table and the number of its entries, and the end marker. All container fields are stored MSB
+// first.
+#define GCOV_IMAGE_MAGIC            "GCIM"
+#define GCOV_IMAGE_VERSION          4U
+#define GCOV_IMAGE_HEADER_SIZE      16U
+//! The header size of images up to version 3, which end with the sequence number
+#define GCOV_IMAGE_V3_HEADER_SIZE   8U
+//! The offset of the image length in the header, followed by the CRC-32 of the image. Both are
+//! zero until a memory sink stored the complete image, the CRC-32 (IEEE 802.3, like zlib) is
+//! calculated over the image with both fields zero.
+#define GCOV_IMAGE_LENGTH_OFFSET    8U
+//! A table of contents entry: the offsets of the record and of its gcda data, the data length
+#define GCOV_IMAGE_TOC_ENTRY_SIZE   12U
+//! The offset of the table of contents and the number of entries in front of the end marker
+#define GCOV_IMAGE_TRAILER_SIZE     8U
+//! Counter records hold zero runs and LEB128 values instead of plain 64 bit counters
+#define GCOV_IMAGE_PACKED_COUNTERS  0x01U
+//! Only functions whose counters changed since the previous delta dump are stored
+#define GCOV_IMAGE_DELTA            0x02U
+//! The counters are taken from the accumulation area instead of the live counters
+#define GCOV_IMAGE_ACCUMULATED      0x04U
+//! Files or functions were left out by the filters registered with gcov_add_filter()
+#define GCOV_IMAGE_FILTERED         0x08U
+//! Each record and each chunk of GCOV_IMAGE_CHUNK_SIZE bytes is followed by its CRC-32
+#define GCOV_IMAGE_CHECKED          0x10U
+//! Arc counters are stored as one bit per counter which tells whether it was hit
+#define GCOV_IMAGE_HIT_ONLY         0x20U
+//! The image of a single test written by gcov_end_test(), the sequence number holds the test id.
+//! Only functions with a non-zero arc counter and files with such functions are stored.
+#define GCOV_IMAGE_TEST             0x40U
+//! Object files were not registered because there were more than GCOV_MAX_FILES of them
+#define GCOV_IMAGE_INCOMPLETE       0x80U
+//! The maximum number of bytes of a LEB128 encoded 64 bit value
+#define GCOV_LEB128_MAX_SIZE        10U
+
+// Checked images (GCOV_IMAGE_CHECKED) are cut into chunks of GCOV_IMAGE_CHUNK_SIZE bytes, the
+// last one may be shorter. Each chunk is followed by the CRC-32 of its bytes, which is not
+// part of the offsets in the image. Each record starts with GCOV_IMAGE_RECORD_MARKER in front of
+// the filename and ends with the CRC-32 of the filename, the gcda data and the zero tag. So a
+// reader can drop corrupted chunks, find the next record behind them and name the lost files.
+// The CRC-32 of the first chunk is calculated with the length and CRC-32 of the header zero.
+#define GCOV_IMAGE_CHUNK_SIZE       512U
+#define GCOV_IMAGE_RECORD_MARKER    "GCRD"
+
+//! gcov_dump_step() wrote the end of the image
+#define GCOV_DUMP_DONE    0
+//! gcov_dump_step() has to be called again to continue the image
+#define GCOV_DUMP_PENDING 1
+//! gcov_dump_step() could not write the image since no sink is set or the sink failed
+#define GCOV_DUMP_FAILED  (-1)
+
+//! The largest test id of gcov_begin_test(), the id is stored in the 16 bit sequence number
+#define GCOV_MAX_TEST_ID 0xFFFFU
+
+#ifdef GCOV_SIZING
+// Upper bounds of the coverage data of the instrumented objects, generated by gcov_sizing
+// after the instrumented targets were built, see cmake/GcovSizing.cmake
+#include <gcov/gcov_sizing.h>
+#endif
+
+//! The maximum number of object files registered by __gcov_init()
+#ifndef GCOV_MAX_FILES
+#ifdef GCOV_SIZING_FILES
+#define GCOV_MAX_FILES GCOV_SIZING_FILES
+#else
+#define GCOV_MAX_FILES 100U
+#endif
+#endif
+
+//! The maximum number of filters registered with gcov_add_filter(), at most 32
+#ifndef GCOV_MAX_FILTERS
+#define GCOV_MAX_FILTERS 8U
+#endif
+
+//! The number of value/count pairs the topn and indirect call profilers of -fprofile-generate
+//! builds track in all files together, each one takes 24 bytes
+#ifndef GCOV_MAX_TOPN_VALUES
+#define GCOV_MAX_TOPN_VALUES 512U
+#endif
+
+// The value profiles of -fprofile-generate builds need the indirect call target in thread local
+// storage if the compiler supports it. Targets whose compiler has no TLS define it empty.
+#ifndef GCOV_THREAD_LOCAL
+#define GCOV_THREAD_LOCAL __thread
+#endif
+
+//! The size of the staging area the image is assembled in before it is handed to the sink
+#ifndef GCOV_STAGING_BUFFER_SIZE
+#define GCOV_STAGING_BUFFER_SIZE 256U
+#endif
+
+// CRC-32s are calculated slicing-by-8 with 8 KiB of tables. Targets short of flash define
+// GCOV_SMALL_CRC32 for a table of 64 bytes, which needs about four times as long.
+
+/*! \brief Called before the first byte of a coverage image is written
+ *
+ *  \param[in]  context The context of the sink
+ *  \return             0 on success, the image is not written otherwise
+ */
+typedef int (*gcov_sink_begin_fn)(void* context);
+
+/*! \brief Called for each chunk of a coverage image
+ *
+ *  \param[in]  context The context of the sink
+ *  \param[in]  data    The chunk of the image
+ *  \param[in]  size    The size of the chunk in bytes, at most GCOV_STAGING_BUFFER_SIZE
+ *  \return             0 on success, the rest of the image is dropped otherwise
+ */
+typedef int (*gcov_sink_write_fn)(void* context, const unsigned char* data, size_t size);
+
+/*! \brief Called after the last byte of a coverage image was written
+ *
+ *  \param[in]  context The context of the sink
+ *  \return             0 on success
+ */
+typedef int (*gcov_sink_end_fn)(void* context);
+
+/*! \brief Output sink the coverage image is streamed to
+ *
+ *  The image is produced in chunks of at most GCOV_STAGING_BUFFER_SIZE bytes which are handed
+ *  to the write callback in order, so the complete image never has to be held in RAM. The
+ *  sink can forward the chunks to a file, a UART, semihosting or a memory area.
+ */
+struct gcov_sink {
+    gcov_sink_begin_fn begin;    //!< Called before the image is written, may be NULL
+    gcov_sink_write_fn write;    //!< Called for each chunk of the image
+    gcov_sink_end_fn end;        //!< Called after the image was written, may be NULL
+    void* context;               //!< Passed to all callbacks
+};
+
+/*! \brief State of a sink collecting the coverage image in a memory area
+ */
+struct gcov_memory_sink_context {
+    unsigned char* buffer;    //!< The start of the memory area
+    size_t size;              //!< The size of the memory area in bytes
+    size_t used;              //!< The number of bytes of the image stored in the area
+    gcov_unsigned_t crc;      //!< The CRC-32 of the bytes stored so far
+    bool overflow;            //!< Set if the image did not fit into the area
+};
+
+#ifdef GCOV_LINKER_ARENAS
+//! The size of the output arena, defaults to the image size of the sizing header
+#ifndef GCOV_OUTPUT_ARENA_SIZE
+#ifdef GCOV_SIZING_IMAGE_SIZE
+#define GCOV_OUTPUT_ARENA_SIZE GCOV_SIZING_IMAGE_SIZE
+#else
+#define GCOV_OUTPUT_ARENA_SIZE 16384U
+#endif
+#endif
+
+/*! \brief The area the image is written to unless another sink is set
+ *
+ *  Placed in the linker section gcov_output, so it needs no setup at startup and a debugger
+ *  can read the image directly, see gcov_arenas.ld.
+ */
+extern unsigned char gcov_output_arena[GCOV_OUTPUT_ARENA_SIZE];
+
+/*! \brief The state of the output arena
+ *
+ *  Holds the address and size of gcov_output_arena, the size of the last image in bytes and
+ *  whether the image did not fit.
+ */
+extern struct gcov_memory_sink_context gcov_output_arena_context;
+
+/*! \brief The staging area of the serializer, placed in the linker section gcov_scratch
+ */
+extern unsigned char gcov_staging_buffer[GCOV_STAGING_BUFFER_SIZE];
+#endif
+
+/*! \brief Sets the sink the coverage image is streamed to
+ *
+ *  \param[in]  sink    The sink to use, NULL to disable the output
+ *
+ *  The sink is not copied and must stay valid until the coverage image was written. With
+ *  GCOV_LINKER_ARENAS the image is written to gcov_output_arena until a sink is set.
+ */
+extern void set_gcov_sink(const struct gcov_sink* sink);
+
+/*! \brief Initializes a sink which collects the coverage image in a memory area
+ *
+ *  \param[out] sink    The sink to initialize
+ *  \param[out] context The state of the sink to initialize
+ *  \param[in]  buffer  The start address of the memory area
+ *  \param[in]  size    The size of the memory area in bytes
+ *
+ *  The image is stored from the start of the area, chunks which do not fit anymore are
+ *  dropped and flagged in \a context. Once the image is complete, its length and CRC-32 are
+ *  stored in its header, so the image can be found and validated in a raw dump of the RAM.
+ */
+extern void gcov_memory_sink_init(struct gcov_sink* sink,
+                                  struct gcov_memory_sink_context* context,
+                                  unsigned char* buffer,
+                                  size_t size);
+
+/*! \brief Baseline of a single function for delta dumps
+ */
+struct gcov_function_baseline {
+    gcov_unsigned_t checksum;    //!< Checksum of the counters at the last dump of the function
+    gcov_unsigned_t sequence;    //!< Sequence number of the last dump containing the function
+};
+
+/*! \brief Sets the layout of the coverage image
+ *
+ *  \param[in]  flags   A combination of GCOV_IMAGE_* flags, 0 for plain gcda records
+ *
+ *  With GCOV_IMAGE_PACKED_COUNTERS the counter arrays in each record are stored as zero runs
+ *  and LEB128 values behind their tag and the number of counters, which typically shrinks the
+ *  image considerably. Such an image has to be expanded by gcov.py to get the .gcda files.
+ *  GCOV_IMAGE_DELTA needs a baseline set with set_gcov_delta_buffer(). GCOV_IMAGE_ACCUMULATED
+ *  dumps the counters merged with gcov_accumulate() instead of the live counters.
+ *  GCOV_IMAGE_HIT_ONLY stores a bit per arc counter, the host tools expand it to counts of 0 or
+ *  1, which is all line and branch coverage needs. Condition and value profiling counters are
+ *  stored as before.
+ */
+extern void set_gcov_image_flags(gcov_unsigned_t flags);
+
+/*! \brief Sets the baseline storage used for delta dumps
+ *
+ *  \param[in]  baseline    The baseline entries, one per instrumented function
+ *  \param[in]  count       The number of baseline entries
+ *
+ *  With GCOV_IMAGE_DELTA each dump only contains the functions whose counter checksum changed
+ *  since the previous delta dump, files without changes are left out completely. The first
+ *  delta dump after this call contains all functions and serves as base image, the following
+ *  ones carry increasing sequence numbers. Functions beyond \a count are always dumped. The
+ *  entries are cleared by this call.
+ */
+extern void set_gcov_delta_buffer(struct gcov_function_baseline* baseline, size_t count);
+
+/*! \brief Selects the files or functions of a file which are dumped
+ *
+ *  A pattern without wildcards is the complete gcda path of a file. In other patterns `*`
+ *  matches any sequence of characters including `/` and `?` matches a single character, so
+ *  a path prefix is written as `prefix*`.
+ */
+struct gcov_filter {
+    const char* pattern;              //!< The files the filter applies to, NULL for all files
+    const gcov_unsigned_t* idents;    //!< Sorted function idents, NULL to filter whole files
+    size_t n_idents;                  //!< The number of function idents
+    bool include;                     //!< Set to include the matches, exclude them otherwise
+};
+
+/*! \brief Registers a filter checked by the following dumps
+ *
+ *  \param[in]  filter  The filter, is not copied and must stay valid until it is cleared
+ *  \return             0 on success, -1 if GCOV_MAX_FILTERS filters are registered already
+ *
+ *  Without include filters for whole files all files are dumped, otherwise only the files
+ *  matching at least one of them. Files matching an exclude filter are never dumped. Filters
+ *  with function idents select the functions of the files they match the same way. Each file
+ *  is matched once after the filters changed, the gcda path is hashed by __gcov_init(), so a
+ *  dump only checks a bit mask per file. Images of filtered dumps are marked with
+ *  GCOV_IMAGE_FILTERED. Must not be called concurrently with a dump.
+ */
+extern int gcov_add_filter(const struct gcov_filter* filter);
+
+/*! \brief Removes all filters registered with gcov_add_filter()
+ */
+extern void gcov_clear_filters(void);
+
+/*! \brief Sets the area counters of successive runs are accumulated in
+ *
+ *  \param[in]  start_address   The start address of the area
+ *  \param[in]  size            The size of the area in bytes
+ *
+ *  The area needs GCOV_ACCUMULATOR_HEADER_SIZE bytes plus the size of all counters and is not
+ *  cleared by this call. Placed in RAM which is not initialized at startup, e.g. a .noinit
+ *  section, the counters of successive boots are accumulated as long as the same build runs.
+ */
+extern void set_gcov_accumulator(unsigned char* start_address, size_t size);
+
+/*! \brief Merges the live counters of all files into the accumulation area
+ *
+ *  \return 0 on success, -1 if no area was set or the area is too small
+ *
+ *  Each counter array is merged with the merge function gcc selected for it, i.e. arc counters
+ *  are summed up, condition counters are OR'ed and topn counters keep their most common value.
+ *  The live counters are taken by the merge and start again from zero afterwards. If the area
+ *  does not hold counters of this build yet, it is cleared first. Must not be called
+ *  concurrently with itself or a dump, nor with value profiled code of -fprofile-generate
+ *  builds, whose topn pairs are released.
+ */
+extern int gcov_accumulate(void);
+
+/*! \brief Discards the counters held in the accumulation area
+ */
+extern void gcov_clear_accumulator(void);
+
+/*! \brief Returns the number of runs merged into the accumulation area
+ *
+ *  \return The number of gcov_accumulate() calls since the area was cleared
+ */
+extern gcov_unsigned_t gcov_accumulated_runs(void);
+
+/*! \brief Reads a free running clock of the target, e.g. a cycle counter
+ *
+ *  \return The current clock value, may wrap around
+ */
+typedef gcov_unsigned_t (*gcov_clock_fn)(void);
+
+/*! \brief Sets the area gcov_snapshot() copies the live counters to
+ *
+ *  \param[in]  start_address   The start address of the area
+ *  \param[in]  size            The size of the area in bytes
+ *
+ *  The area needs the size of all counters plus the counter alignment, GCOV_SIZING_SNAPSHOT_SIZE
+ *  of the sizing header. A snapshot which was not dumped yet is discarded. Must not be called
+ *  while a snapshot is dumped.
+ */
+extern void set_gcov_snapshot_buffer(unsigned char* start_address, size_t size);
+
+/*! \brief Sets the clock the pause of gcov_snapshot() is measured with
+ *
+ *  \param[in]  clock   The clock, NULL to stop measuring
+ */
+extern void set_gcov_clock(gcov_clock_fn clock);
+
+/*! \brief Copies the live counters of all files into the snapshot area
+ *
+ *  \return 0 on success, -1 if no area was set, the area is too small or the previous snapshot
+ *          is dumped right now
+ *
+ *  The counter arrays are copied one after the other with memcpy(), or atomic loads with
+ *  GCOV_ATOMIC_COUNTERS, in the layout of the accumulation area, so the application only pauses
+ *  for the copy. The next dump started by __gcov_dump() or gcov_dump_step() then writes the
+ *  image from the copy instead of the live counters, e.g. in a low priority thread or step by
+ *  step from an idle hook while the application keeps running, and all counters of the image
+ *  are from the same point in time. Accumulated and test images keep reading their counters. A
+ *  snapshot which was not dumped yet is replaced, files registered after the snapshot are left
+ *  out of its image. The live counters are not changed and topn profilers keep their most
+ *  common value, like in the accumulation area. Must not run concurrently with __gcov_reset()
+ *  in -fprofile-generate builds, whose topn pairs are released.
+ */
+extern int gcov_snapshot(void);
+
+/*! \brief Checks whether a snapshot waits for its dump or is being dumped
+ *
+ *  \return True from gcov_snapshot() until the end of the image written from the snapshot
+ */
+extern bool gcov_snapshot_pending(void);
+
+/*! \brief Returns the pause of the last successful gcov_snapshot()
+ *
+ *  \return The ticks of the clock set with set_gcov_clock() the call took, 0 without clock
+ */
+extern gcov_unsigned_t gcov_snapshot_pause(void);
+
+/*! \brief Returns the longest pause of all gcov_snapshot() calls measured so far
+ *
+ *  \return The ticks of the clock set with set_gcov_clock(), 0 without clock
+ */
+extern gcov_unsigned_t gcov_snapshot_max_pause(void);
+
+/*! \brief Returns the number of object files which could not be registered
+ *
+ *  \return The number of __gcov_init() calls beyond GCOV_MAX_FILES
+ *
+ *  The coverage of these files is missing from every image, which is marked with
+ *  GCOV_IMAGE_INCOMPLETE. Size the registration table with the header generated by
+ *  gcov_sizing or define GCOV_MAX_FILES large enough.
+ */
+extern gcov_unsigned_t gcov_unregistered_files(void);
+
+/*! \brief Starts the coverage window of a test
+ *
+ *  \param[in]  test_id The id of the test, e.g. its index in the test list, up to
+ *                      GCOV_MAX_TEST_ID
+ *  \return             0 on success, -1 if the id is too large, a test or a dump is running
+ *
+ *  Sets all counters to zero like __gcov_reset(), so the setup between two tests is not
+ *  attributed to either of them.
+ */
+extern int gcov_begin_test(gcov_unsigned_t test_id);
+
+/*! \brief Ends the coverage window of the running test and writes its image
+ *
+ *  \return GCOV_DUMP_DONE once the image was handed to the sink, GCOV_DUMP_FAILED if no test
+ *          is running, a dump is running, no sink is set or the sink failed
+ *
+ *  Dumps the counters with GCOV_IMAGE_TEST and the test id in the sequence number of the image
+ *  and sets them to zero afterwards. Only the functions executed during the test are stored,
+ *  their function records are what gcov_tests builds the test matrix from. The image flags set
+ *  with set_gcov_image_flags() apply as well, with GCOV_IMAGE_HIT_ONLY the image also lists the
+ *  hit arcs, GCOV_IMAGE_DELTA and GCOV_IMAGE_ACCUMULATED are ignored. A sink which appends,
+ *  e.g. a UART, collects the images of all tests in one stream. Counter increments of other
+ *  threads between the dump and the reset are lost.
+ */
+extern int gcov_end_test(void);
 
 /*! \brief Sets the buffer address for the output of gcov data
  *
@@ -105,32 +516,27 @@ typedef long long gcov_type;
  *
  *  Sets the buffer to use for the gcov data dump. This region will contain the gcov data
  *  of all files which were instrumented and can be read out via JTAG for example.
- *  This is needed to avoid any malloc allocations in this implementation.
+ *  This is needed to avoid any malloc allocations in this implementation. The buffer is
+ *  written through an internal memory sink which replaces the sink set with set_gcov_sink().
  */
 extern void set_gcov_buffer(unsigned char* start_address, gcov_unsigned_t size);
 
-/*! \brief Sets the buffer address for the temporary area used for a single gcda dump
- *
- *  \param[in]  start_address   The start address of the buffer region
- *  \param[in]  size            The size of the buffer in multiples of gcov_unsigned_t
- *
- *  Sets the buffer to use for a single gcda file dump. This will contain the data of
- *  one instrumented object file and will be overwritten for each file. This is necessary
- *  to avoid malloc in this implementation itself.
- */
-extern void set_gcov_gcda_buffer(gcov_unsigned_t* start_address, gcov_unsigned_t size);
-
 /*! \brief Converts the internal gcov data tree into the gcda output format
  *
  *  \param[in]  buffer  The buffer to store the data in, NULL if no data should be stored
+ *  \param[in]  size    The size of the buffer in bytes
  *  \param[in]  info    The pointer to the gcov coverage data
  *  \return             The number of bytes the were/would have been stored in the buffer
  *
- *  Converts the internal gcov data tree into the gcda output format. If this
+ *  Converts the internal gcov data tree into the gcda output format in a single pass. The
+ *  buffer does not need to be aligned. Data which does not fit into \a size bytes is not
+ *  stored, so a return value larger than \a size means the buffer was too small. If this
  *  function is called with a nullptr for \a buffer, the number of bytes needed can be
- *  determined. Compare to libgcc/libgcov-driver.c function write_one_data()
+ *  determined. The object summary holds one run and the largest arc counter of the file,
+ *  which is looked up first if the data is stored. Compare to libgcc/libgcov-driver.c
+ *  function write_one_data()
  */
-extern size_t gcov_convert_to_gcda(gcov_unsigned_t* buffer, struct gcov_info* info);
+extern size_t gcov_convert_to_gcda(unsigned char* buffer, size_t size, struct gcov_info* info);
 
 /*! \brief Called for each object file
  *
@@ -142,26 +548,142 @@ extern void __gcov_init(struct gcov_info* info);
 
 /*! \brief Called for each object file to summarize coverage data
  *
- *  Called for each object file to summarize coverage data
+ *  Called for each object file to summarize coverage data. Writes the coverage image like
+ *  __gcov_dump().
  */
 extern void __gcov_exit(void);
 
-/*! \brief Function must not be called but needs to be defined
+/*! \brief Dumps the current coverage data of all files
+ *
+ *  The coverage image of all files is streamed to the sink set with set_gcov_sink() or
+ *  set_gcov_buffer(). Can be called at any time and as often as needed, e.g. at the end of
+ *  each test phase on targets which never exit. The image is written in a single pass, the
+ *  table of contents at its end allows to locate each record without scanning the image.
+ *  Completes an image started by gcov_dump_step() instead of starting a new one.
+ */
+extern void __gcov_dump(void);
+
+/*! \brief Writes the next part of a coverage image
+ *
+ *  \param[in]  budget  The number of image bytes to write at most, 0 writes a single unit
+ *  \return             GCOV_DUMP_PENDING if the image is not complete yet, GCOV_DUMP_DONE once
+ *                      the end of the image was handed to the sink, GCOV_DUMP_FAILED if no sink
+ *                      is set or the sink failed
+ *
+ *  Writes the same image as __gcov_dump() in several calls, e.g. from the idle loop or a low
+ *  priority task, so coverage can be extracted without stalling the target. The first call
+ *  starts a new image, the following calls continue it where the previous one stopped. A call
+ *  stops as soon as \a budget bytes were written, exceeding it by less than a path or function
+ *  record, since counter arrays are split between counters. The first calls look up the largest
+ *  arc counter of all files for the object summaries, which counts against the budget like
+ *  writing the arc counters. Delta dumps compare all counters of a file in the call which
+ *  starts its record and test images look at its arc counters, which counts against the
+ *  budget the same way, also for files which are skipped then. So a call exceeds the budget
+ *  by at most the counters of one file. Files skipped by the filters and their table of
+ *  contents slots count like a table of contents entry. Apart from that each counter is read
+ *  exactly once, but the counters of different files and functions are read at different
+ *  times, unless the image is written from a snapshot taken with gcov_snapshot(). Calling
+ *  __gcov_dump() completes a running image. The sink, the image flags and the filters must not
+ *  change until the image is complete.
+ */
+extern int gcov_dump_step(size_t budget);
+
+/*! \brief Sets all counters of all files registered via __gcov_init() to zero
+ *
+ *  Together with __gcov_dump() this allows to collect the coverage of several test phases
+ *  separately within one run of the target. The topn pairs of -fprofile-generate builds are
+ *  released, so value profiled code must not run concurrently.
+ */
+extern void __gcov_reset(void);
+
+/*! \brief Adds the counters of a merge source to the given counters
  *
- *  \param[in]   counters   Not specified in gcc documentation / source code
- *  \param[in]   n_counters Not specified in gcc documentation / source code
+ *  \param[in]   counters   The counters to merge into
+ *  \param[in]   n_counters The number of counters
  *
- *  Function must not be called but needs to be defined
+ *  Used by gcov_accumulate() for the arc counters, the source is set by the runtime. Without a
+ *  merge in progress the call has no effect.
  */
 extern void __gcov_merge_add(gcov_type* counters, gcov_unsigned_t n_counters);
 
-/*! \brief Function must not be called but needs to be defined when compiling with MC/DC
+/*! \brief ORs the counters of a merge source into the given counters
  *
- *  \param[in]  counters    Not specified in gcc documentation / source code
- *  \param[in]  n_counters  Not specified in gcc documentation / source code
+ *  \param[in]  counters    The counters to merge into
+ *  \param[in]  n_counters  The number of counters
  *
- *  Function must not be called but needs to be defined when compiling with MC/DC coverage
+ *  Used by gcov_accumulate() for the condition counters of MC/DC coverage, the source is set by
+ *  the runtime. Without a merge in progress the call has no effect.
  */
 extern void __gcov_merge_ior(gcov_type* counters, gcov_unsigned_t n_counters);
 
+/*! \brief Merges the topn counters of a merge source into the given counters
+ *
+ *  \param[in]  counters    The counters to merge into, GCOV_TOPN_MEM_COUNTERS per profiler
+ *  \param[in]  n_counters  The number of counters
+ *
+ *  Used by gcov_accumulate() for the topn and indirect call counters of -fprofile-generate
+ *  builds. The accumulation area holds the number of calls and the most common value with its
+ *  count per profiler instead of a list, the other values of the merged lists are dropped.
+ *  Without a merge in progress the call has no effect.
+ */
+extern void __gcov_merge_topn(gcov_type* counters, gcov_unsigned_t n_counters);
+
+/*! \brief Merges the time profile of a merge source into the given counters
+ *
+ *  \param[in]  counters    The counters to merge into
+ *  \param[in]  n_counters  The number of counters
+ *
+ *  Used by gcov_accumulate() for the time profiler counters of -fprofile-generate builds, each
+ *  counter keeps the earliest non-zero position of the first call. Without a merge in progress
+ *  the call has no effect.
+ */
+extern void __gcov_merge_time_profile(gcov_type* counters, gcov_unsigned_t n_counters);
+
+/*! \brief The target of an indirect call, set by the caller for the indirect call profiler
+ *
+ *  Compare to libgcc/libgcov-profiler.c, the compiler stores the callee and the counters of
+ *  the call site before each profiled indirect call.
+ */
+struct gcov_indirect_call_tuple {
+    void* callee;           //!< The address of the called function
+    gcov_type* counters;    //!< The topn counters of the call site
+};
+
+//! The indirect call in progress, checked by the profiler at the entry of the callee
+extern GCOV_THREAD_LOCAL struct gcov_indirect_call_tuple __gcov_indirect_call;
+
+//! Incremented by the time profiler for each function called the first time
+extern gcov_type __gcov_time_profiler_counter;
+
+/*! \brief Returns the number of values the topn profilers could not track
+ *
+ *  \return The number of values which found no free pair of the GCOV_MAX_TOPN_VALUES pairs
+ *
+ *  The pairs are shared by the topn and indirect call profilers of all files and released
+ *  again by __gcov_reset() and gcov_accumulate(). If values were lost, the value profiles of
+ *  the dump are incomplete and GCOV_MAX_TOPN_VALUES should be increased.
+ */
+extern gcov_unsigned_t gcov_lost_topn_values(void);
+
+// The value profilers called by the code of -fprofile-generate builds, compare to
+// libgcc/libgcov-profiler.c. The _atomic variants are used with -fprofile-update=atomic.
+extern void __gcov_interval_profiler(gcov_type* counters,
+                                     gcov_type value,
+                                     int start,
+                                     unsigned steps);
+extern void __gcov_interval_profiler_atomic(gcov_type* counters,
+                                            gcov_type value,
+                                            int start,
+                                            unsigned steps);
+extern void __gcov_pow2_profiler(gcov_type* counters, gcov_type value);
+extern void __gcov_pow2_profiler_atomic(gcov_type* counters, gcov_type value);
+extern void __gcov_topn_values_profiler(gcov_type* counters, gcov_type value);
+extern void __gcov_topn_values_profiler_atomic(gcov_type* counters, gcov_type value);
+extern void __gcov_indirect_call_profiler_v4(gcov_type value, void* cur_func);
+extern void __gcov_indirect_call_profiler_v4_atomic(gcov_type value, void* cur_func);
+extern void __gcov_average_profiler(gcov_type* counters, gcov_type value);
+extern void __gcov_average_profiler_atomic(gcov_type* counters, gcov_type value);
+extern void __gcov_ior_profiler(gcov_type* counters, gcov_type value);
+extern void __gcov_ior_profiler_atomic(gcov_type* counters, gcov_type value);
+
 #endif
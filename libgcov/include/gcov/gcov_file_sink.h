@@ -0,0 +1,38 @@
+/**********************************************************************/
+/** @addtogroup embedded_gcov
+ * @{
+ * @file
+ *
+ * @brief Sink writing the coverage image to a file on the host.
+ *
+ * The file sink relies on POSIX file functions and is meant for hosted
+ * targets or semihosting setups which provide them.
+ *
+ **********************************************************************/
+
+#ifndef LIB_GCOV_FILE_SINK_H
+#define LIB_GCOV_FILE_SINK_H
+
+#include "gcov/gcov.h"
+
+/*! \brief State of a sink writing the coverage image to a file
+ */
+struct gcov_file_sink_context {
+    const char* path;    //!< The path of the file the image is written to
+    int fd;              //!< The file descriptor while an image is written, -1 otherwise
+    bool failed;         //!< Set if the image could not be written completely
+};
+
+/*! \brief Initializes a sink which writes the coverage image to a file
+ *
+ *  \param[out] sink    The sink to initialize
+ *  \param[out] context The state of the sink to initialize
+ *  \param[in]  path    The path of the file, must stay valid as long as the sink is used
+ *
+ *  The file is created or truncated for each image and closed after the image was written.
+ */
+extern void gcov_file_sink_init(struct gcov_sink* sink,
+                                struct gcov_file_sink_context* context,
+                                const char* path);
+
+#endif
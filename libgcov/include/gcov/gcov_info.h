@@ -0,0 +1,77 @@
+/**********************************************************************/
+/** @addtogroup embedded_gcov
+ * @{
+ * @file
+ *
+ * @brief The coverage data the compiler emits for each instrumented object.
+ *
+ * The layout has to match libgcc/libgcov.h of the compiler, see also the
+ * GCOV_COUNTERS check in gcov.h. Besides the runtime it is used by tools
+ * which synthesize coverage data, e.g. the benchmarks.
+ *
+ **********************************************************************/
+
+#ifndef LIB_GCOV_INFO_H
+#define LIB_GCOV_INFO_H
+
+#include "gcov/gcov.h"
+
+//! Type of function used to merge counters, compare to libgcc/libgcov.h
+typedef void (*gcov_merge_fn)(gcov_type*, gcov_unsigned_t);
+
+/*! \brief Information about counters of a single function
+ *
+ *  \details Contains information about counters for a single function.
+ *  The info is generated at compile time, only the values in the array
+ *  change at run-time.
+ *  \note Compare this struct to the one in libgcc/libgcov.h
+ */
+struct gcov_ctr_info {
+    gcov_unsigned_t num;    //!< The number of counter values for this type
+    gcov_type* values;      //!< The array of counter values for this type
+};
+
+/*! \brief A value tracked by a topn profiler and how often it occurred
+ *
+ *  \details The last of the GCOV_TOPN_MEM_COUNTERS counters of a topn profiler points to a
+ *  list of these pairs, the pairs are taken from a static pool of the runtime.
+ *  \note Compare this struct to the one in libgcc/libgcov.h
+ */
+struct gcov_kvp {
+    gcov_type value;          //!< The profiled value
+    gcov_type count;          //!< The number of occurrences of the value
+    struct gcov_kvp* next;    //!< The next pair of the profiler, NULL for the last one
+};
+
+/*! \brief Describes the profiling meta data per function
+ *
+ *  \details Contains information about a single function. The number of counters
+ *  is determined from the merge pointer array in gcov_info. The key is used to
+ *  detect which of a set of comdat functions was selected. It points to the gcov_info
+ *  object of the object file containing the selected comdat function.
+ *  \note Compare this struct to the one in libgcc/libgcov.h
+ */
+struct gcov_fn_info {
+    const struct gcov_info* key;        //!< Comdat key
+    gcov_unsigned_t ident;              //!< Unique identifier of the function
+    gcov_unsigned_t lineno_checksum;    //!< Functin line number checksum
+    gcov_unsigned_t cfg_checksum;       //!< Function configuration checksum
+    struct gcov_ctr_info ctrs[1];       //!< Instrumented counters
+};
+
+/*! \brief Describes the coverage data and meta data for a single file
+ *
+ *  The structure describes a file's meta data as well as coverage data
+ */
+struct gcov_info {
+    gcov_unsigned_t version;               //!< Expected version number
+    struct gcov_info* next;                //!< link to the next struct
+    gcov_unsigned_t stamp;                 //!< Unique timestamp
+    gcov_unsigned_t checksum;              //!< Unique object checksum
+    const char* filename;                  //!< The output file name
+    gcov_merge_fn merge[GCOV_COUNTERS];    //!< merge function to use (null if unused)
+    unsigned n_functions;                  //!< The number of functions
+    struct gcov_fn_info** functions;       //!< pointer to pointers to function infos
+};
+
+#endif
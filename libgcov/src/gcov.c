@@ -73,308 +73,2075 @@
  *
  */
 
-#include <fcntl.h>    // \TODO: linux only header file to be removed for embedded
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
-#include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
-#include <unistd.h>    //\TODO: linux only header file to be removed for embedded
 
 #include "gcov/gcov.h"
-
-#include <sys/stat.h>    // \TODO: linux only header file to be removed for embedded
-
-//! Type of function used to merge counters, compare to libgcc/libgcov.h
-typedef void (*gcov_merge_fn)(gcov_type*, gcov_unsigned_t);
+#include "gcov/gcov_info.h"
+#ifndef GCOV_SMALL_CRC32
+#include "gcov_crc32_table.h"
+#endif
+#include "gcov_counter_words.h"
 
 typedef struct gcov_info_tag gcov_info_tag;
 
 /*! \brief A struct with a list of coverage data for each file
  */
 struct gcov_info_tag {
-    struct gcov_info* info;        //!< The data belonging to the file
-    struct gcov_info_tag* next;    //!< Pointer to the info of the next file
+    struct gcov_info* info;            //!< The data belonging to the file
+    struct gcov_info_tag* next;        //!< Pointer to the info of the next file
+    gcov_unsigned_t record_offset;     //!< The image offset of the record of the running dump
+    gcov_unsigned_t data_length;       //!< The length of the gcda data of the running dump
+    gcov_unsigned_t filename_hash;     //!< The FNV-1a hash of the gcda path
+    gcov_unsigned_t filter_matches;    //!< Bit mask of the filters matching the file
+    gcov_unsigned_t filter_epoch;      //!< The filter epoch of filter_matches, 0 for none
+    bool dumped;                       //!< Set if the running dump contains a record of the file
 };
 
-/*! \brief Information about counters of a single function
+typedef struct gcov_writer gcov_writer;
+
+/*! \brief Destination of the serializer
  *
- *  \details Contains information about counters for a single function.
- *  The info is generated at compile time, only the values in the array
- *  change at run-time.
- *  \note Compare this struct to the one in libgcc/libgcov.h
+ *  The writer either stores the bytes into a caller provided buffer or uses the buffer as
+ *  staging area which is flushed to a sink whenever it is full. Without a buffer the
+ *  writer only counts the bytes.
  */
-struct gcov_ctr_info {
-    gcov_unsigned_t num;    //!< The number of counter values for this type
-    gcov_type* values;      //!< The array of counter values for this type
+struct gcov_writer {
+    unsigned char* buffer;           //!< The buffer the bytes are stored in, NULL to only count
+    size_t size;                     //!< The size of the buffer in bytes
+    size_t fill;                     //!< The number of bytes currently stored in the buffer
+    size_t total;                    //!< The number of bytes written in total
+    const struct gcov_sink* sink;    //!< The sink a full buffer is flushed to, NULL for none
+    gcov_unsigned_t flags;           //!< The GCOV_IMAGE_* flags of the produced data
+    gcov_unsigned_t chunk_crc;       //!< The CRC-32 of the current chunk of a checked image
+    gcov_unsigned_t record_crc;      //!< The CRC-32 of the current record of a checked image
+    bool failed;                     //!< Set if bytes could not be stored or flushed
+};
+
+typedef enum gcov_cursor_stage gcov_cursor_stage;
+
+//! The next part of the gcda data a cursor writes
+enum gcov_cursor_stage {
+    GCOV_CURSOR_HEADER,      //!< The magic, version, stamp, checksum and object summary
+    GCOV_CURSOR_FUNCTION,    //!< The function record of the next function
+    GCOV_CURSOR_RECORD,      //!< The tag and length of the next counter record of the function
+    GCOV_CURSOR_VALUES,      //!< The remaining counters of the current counter record
+    GCOV_CURSOR_DONE,        //!< Nothing, all data of the file was written
 };
 
-/*! \brief Describes the profiling meta data per function
+typedef struct gcov_info_cursor gcov_info_cursor;
+
+/*! \brief Position of the serializer within the gcda data of a file
  *
- *  \details Contains information about a single function. The number of counters
- *  is determined from the merge pointer array in gcov_info. The key is used to
- *  detect which of a set of comdat functions was selected. It points to the gcov_info
- *  object of the object file containing the selected comdat function.
- *  \note Compare this struct to the one in libgcc/libgcov.h
+ *  The data of a file can be written in several steps, counter arrays are split between two
+ *  counters. Each counter is read exactly once, no matter how the data is split up.
  */
-struct gcov_fn_info {
-    const struct gcov_info* key;        //!< Comdat key
-    gcov_unsigned_t ident;              //!< Unique identifier of the function
-    gcov_unsigned_t lineno_checksum;    //!< Functin line number checksum
-    gcov_unsigned_t cfg_checksum;       //!< Function configuration checksum
-    struct gcov_ctr_info ctrs[1];       //!< Instrumented counters
+struct gcov_info_cursor {
+    const struct gcov_info* info;            //!< The file to serialize
+    size_t function_base;                    //!< The baseline index of the first function
+    gcov_type* accumulated;                  //!< The next accumulated counters, NULL for live ones
+    gcov_unsigned_t function_filters;        //!< The function filters matching the file
+    gcov_unsigned_t runs;                    //!< The number of runs of the object summary
+    gcov_unsigned_t sum_max;                 //!< The largest arc counter of the object summary
+    gcov_cursor_stage stage;                 //!< The next part to write
+    size_t function_idx;                     //!< The index of the current function
+    size_t counter_idx;                      //!< The counter type of the current counter record
+    const struct gcov_ctr_info* counters;    //!< The next counter array of the function
+    struct gcov_ctr_info source;             //!< The counters of the current counter record
+    gcov_unsigned_t value_idx;               //!< The next counter of the current counter record
+    gcov_unsigned_t zero_run;                //!< The zero counters not stored yet (packed)
+    gcov_unsigned_t topn_pairs;              //!< The value pairs of the topn record not stored yet
+    size_t encoded_total;                    //!< The bytes stored for the record so far (packed)
+    bool skipped;                            //!< Set if the current function is left out
 };
 
-/*! \brief Describes the coverage data and meta data for a single file
- *
- *  The structure describes a file's meta data as well as coverage data
+typedef enum gcov_dump_phase gcov_dump_phase;
+
+//! The part of the image the running dump writes
+enum gcov_dump_phase {
+    GCOV_PHASE_IDLE,       //!< No dump is running
+    GCOV_PHASE_SUMMARY,    //!< The largest arc counter of all files for the object summaries
+    GCOV_PHASE_RECORDS,    //!< The records of the files
+    GCOV_PHASE_TOC,        //!< The table of contents, the trailer and the end marker
+    GCOV_PHASE_END,        //!< The image is complete and has to be flushed to the sink
+};
+
+typedef struct gcov_dump_state gcov_dump_state;
+
+/*! \brief The state of a dump which is written by several calls to gcov_dump_step()
  */
-struct gcov_info {
-    gcov_unsigned_t version;               //!< Expected version number
-    struct gcov_info* next;                //!< link to the next struct
-    gcov_unsigned_t stamp;                 //!< Unique timestamp
-    gcov_unsigned_t checksum;              //!< Unique object checksum
-    const char* filename;                  //!< The output file name
-    gcov_merge_fn merge[GCOV_COUNTERS];    //!< merge function to use (null if unused)
-    unsigned n_functions;                  //!< The number of functions
-    struct gcov_fn_info** functions;       //!< pointer to pointers to function infos
+struct gcov_dump_state {
+    gcov_dump_phase phase;          //!< The part of the image written next
+    gcov_writer writer;             //!< The writer streaming the image to the sink
+    gcov_info_tag* file;            //!< The file of the current record or TOC entry
+    bool in_record;                 //!< Set while the gcda data of the file is written
+    gcov_info_cursor cursor;        //!< The position within the gcda data of the file
+    size_t function_base;           //!< The baseline index of the first function of the file
+    gcov_type* accumulated;         //!< The accumulated counters of the file, NULL for live ones
+    gcov_info_tag* summary_file;    //!< The next file whose arc counters are looked at
+    gcov_type* summary_counters;    //!< The accumulated counters of that file, NULL for live ones
+    gcov_unsigned_t runs;           //!< The number of runs of the object summaries
+    gcov_type sum_max;              //!< The largest arc counter of the files looked at so far
+    size_t data_offset;             //!< The image offset of the gcda data of the file
+    gcov_unsigned_t records;        //!< The number of records written so far
+    gcov_unsigned_t toc_offset;     //!< The image offset of the table of contents
+    gcov_info_tag* head;            //!< The first file of the image, also of its TOC
+    bool snapshot;                  //!< Set if the counters are taken from the snapshot
 };
 
-//! The head of the list of coverage data for each file
-static gcov_info_tag* gcov_head = NULL;
+typedef enum gcov_snapshot_state gcov_snapshot_state;
 
-//! The buffer where the coverage data converted to gcda will be stored
-static unsigned char* gcov_output_buffer = (unsigned char*) (NULL);
-//! The index at which the data will be written
-static gcov_unsigned_t gcov_output_index = 0;
+//! The use of the snapshot area
+enum gcov_snapshot_state {
+    GCOV_SNAPSHOT_EMPTY,      //!< The area holds no counters to dump
+    GCOV_SNAPSHOT_COPYING,    //!< gcov_snapshot() copies the live counters into the area
+    GCOV_SNAPSHOT_READY,      //!< The area holds counters the next dump takes
+    GCOV_SNAPSHOT_DUMPING,    //!< The running dump reads the counters of the area
+};
 
-static gcov_unsigned_t gcov_output_buffer_sz = 0U;
+//! The head of the list of coverage data for each file
+static gcov_info_tag* gcov_head = NULL;
 
 //! One Entry for each file that was compiled with coverage info
-static gcov_info_tag gcov_info_file_buf[100];
-//! The number of files __gcov_init() will be called for
+static gcov_info_tag gcov_info_file_buf[GCOV_MAX_FILES];
+#ifdef GCOV_SIZING_FILES
+static_assert(GCOV_MAX_FILES >= GCOV_SIZING_FILES,
+              "GCOV_MAX_FILES is smaller than the number of instrumented object files");
+#endif
+//! The number of files __gcov_init() was called for, may exceed the number of entries
 static gcov_unsigned_t gcov_info_file_idx = 0;
 
-//! Pointer to memory where the gcda data of a single file will be temporarily stored
-static gcov_unsigned_t* gcov_gcda_buffer = NULL;
-//! Space needs to be enough for the largest single file coverage data
-//! The size used depends on the size and complexity of the source code that is
-//! compiled for coverage
-static gcov_unsigned_t gcov_gcda_buffer_sz = 0U;
+// With GCOV_LINKER_ARENAS the areas of the runtime are global symbols in their own linker
+// sections, so they can be placed by the linker script and located by a debugger
+#ifdef GCOV_LINKER_ARENAS
+#define GCOV_ARENA(name) __attribute__((section(name), aligned(8)))
+#else
+#define GCOV_ARENA(name) static
+#endif
+
+#ifdef GCOV_LINKER_ARENAS
+#ifdef GCOV_SIZING_IMAGE_SIZE
+static_assert(GCOV_OUTPUT_ARENA_SIZE >= GCOV_SIZING_IMAGE_SIZE,
+              "GCOV_OUTPUT_ARENA_SIZE is smaller than the image of the instrumented objects");
+#endif
+
+static int gcov_memory_sink_begin(void* context);
+static int gcov_memory_sink_write(void* context, const unsigned char* data, size_t size);
+static int gcov_memory_sink_end(void* context);
+
+GCOV_ARENA("gcov_output") unsigned char gcov_output_arena[GCOV_OUTPUT_ARENA_SIZE];
+
+struct gcov_memory_sink_context gcov_output_arena_context = {
+    .buffer = gcov_output_arena,
+    .size = sizeof(gcov_output_arena),
+};
+
+//! The memory sink of the output arena, used unless another sink is set
+static const struct gcov_sink gcov_output_arena_sink = {
+    .begin = gcov_memory_sink_begin,
+    .write = gcov_memory_sink_write,
+    .end = gcov_memory_sink_end,
+    .context = &gcov_output_arena_context,
+};
+
+//! The sink the coverage image is streamed to by __gcov_dump()
+static const struct gcov_sink* gcov_output_sink = &gcov_output_arena_sink;
+#else
+//! The sink the coverage image is streamed to by __gcov_dump()
+static const struct gcov_sink* gcov_output_sink = NULL;
+#endif
+
+//! The memory sink used for the area registered with set_gcov_buffer()
+static struct gcov_sink gcov_buffer_sink;
+//! The state of the memory sink used for the area registered with set_gcov_buffer()
+static struct gcov_memory_sink_context gcov_buffer_sink_context;
+
+//! Staging area the image is assembled in before it is handed to the sink in chunks
+GCOV_ARENA("gcov_scratch") unsigned char gcov_staging_buffer[GCOV_STAGING_BUFFER_SIZE];
+
+//! The dump started by gcov_dump_step() or __gcov_dump()
+static gcov_dump_state gcov_running_dump;
+
+//! The GCOV_IMAGE_* flags used for the next coverage image
+static gcov_unsigned_t gcov_image_flags = 0U;
+
+//! The per function baseline of delta dumps, one entry per function in list order
+static struct gcov_function_baseline* gcov_delta_baseline = NULL;
+//! The number of entries in the delta baseline
+static size_t gcov_delta_baseline_sz = 0U;
+//! The sequence number of the last delta dump, 0 if no delta dump happened yet
+static gcov_unsigned_t gcov_delta_sequence = 0U;
+
+//! Set between gcov_begin_test() and gcov_end_test()
+static bool gcov_test_running = false;
+//! The id of the running or last test
+static gcov_unsigned_t gcov_test_id = 0U;
+
+static_assert(GCOV_MAX_FILTERS <= 32U, "the filters of a file are tracked in a 32 bit mask");
+
+//! The filters registered with gcov_add_filter()
+static const struct gcov_filter* gcov_filters[GCOV_MAX_FILTERS];
+//! The hashes of the filter patterns without wildcards
+static gcov_unsigned_t gcov_filter_hashes[GCOV_MAX_FILTERS];
+//! The number of registered filters
+static size_t gcov_filter_count = 0U;
+//! Incremented whenever the filters change, so the matches of each file are updated once
+static gcov_unsigned_t gcov_filter_epoch = 1U;
+//! Bit mask of the include filters for whole files
+static gcov_unsigned_t gcov_include_files = 0U;
+//! Bit mask of the exclude filters for whole files
+static gcov_unsigned_t gcov_exclude_files = 0U;
+//! Bit mask of the include filters for functions
+static gcov_unsigned_t gcov_include_functions = 0U;
+//! Bit mask of the exclude filters for functions
+static gcov_unsigned_t gcov_exclude_functions = 0U;
+
+typedef struct gcov_accumulator_header gcov_accumulator_header;
+
+/*! \brief Header in front of the counters of the accumulation area
+ *
+ *  The layout checksum identifies the instrumented files and their counter numbers, so the
+ *  accumulated counters are discarded if the area was written by a different build.
+ */
+struct gcov_accumulator_header {
+    gcov_unsigned_t magic;     //!< GCOV_ACCUMULATOR_MAGIC if the area holds counters
+    gcov_unsigned_t layout;    //!< Checksum of the layout of the accumulated counters
+    gcov_unsigned_t runs;      //!< The number of runs merged into the area
+    gcov_unsigned_t values;    //!< The number of accumulated counters following the header
+};
+
+static_assert(sizeof(gcov_accumulator_header) == GCOV_ACCUMULATOR_HEADER_SIZE,
+              "GCOV_ACCUMULATOR_HEADER_SIZE does not match the accumulator header");
+
+//! The header of the accumulation area, NULL if no area was set
+static gcov_accumulator_header* gcov_accumulator = NULL;
+//! The size of the accumulation area behind the header in bytes
+static size_t gcov_accumulator_sz = 0U;
+
+//! The counters of the snapshot area, in the layout of the accumulation area
+static gcov_type* gcov_snapshot_counters = NULL;
+//! The number of counters fitting into the snapshot area
+static size_t gcov_snapshot_capacity = 0U;
+//! The use of the snapshot area, changed atomically as snapshot and dump may run in two threads
+static gcov_snapshot_state gcov_snapshot_status = GCOV_SNAPSHOT_EMPTY;
+//! The first file of the snapshot, files registered later are not part of its image
+static gcov_info_tag* gcov_snapshot_head = NULL;
+//! The clock the pause of gcov_snapshot() is measured with, NULL if none was set
+static gcov_clock_fn gcov_clock = NULL;
+//! The clock ticks the last gcov_snapshot() took
+static gcov_unsigned_t gcov_snapshot_last_pause = 0U;
+//! The clock ticks the longest gcov_snapshot() took
+static gcov_unsigned_t gcov_snapshot_longest_pause = 0U;
+
+//! The counters the merge functions read from, NULL if no merge is in progress
+static gcov_type* gcov_merge_source = NULL;
+
+//! Releases the pairs of the topn profilers, defined by gcov_profiler.c which is only linked
+//! into -fprofile-generate builds
+extern void release_gcov_topn_values(void) __attribute__((weak));
+
+void set_gcov_sink(const struct gcov_sink* sink) {
+    gcov_output_sink = sink;
+}
+
+void set_gcov_image_flags(const gcov_unsigned_t flags) {
+    gcov_image_flags = flags;
+}
+
+void set_gcov_delta_buffer(struct gcov_function_baseline* baseline, const size_t count) {
+    gcov_delta_baseline = baseline;
+    gcov_delta_baseline_sz = baseline ? count : 0U;
+    gcov_delta_sequence = 0U;
+    for(size_t function_idx = 0U; function_idx < gcov_delta_baseline_sz; ++function_idx) {
+        gcov_delta_baseline[function_idx].checksum = 0U;
+        gcov_delta_baseline[function_idx].sequence = 0U;
+    }
+}
+
+void set_gcov_accumulator(unsigned char* start_address, const size_t size) {
+    const uintptr_t alignment = _Alignof(gcov_type);
+    const uintptr_t padding = (alignment - ((uintptr_t) start_address % alignment)) % alignment;
+
+    gcov_accumulator = NULL;
+    gcov_accumulator_sz = 0U;
+    if(!start_address || (size < (padding + sizeof(gcov_accumulator_header))))
+        return;
+    gcov_accumulator = (gcov_accumulator_header*) (start_address + padding);
+    gcov_accumulator_sz = size - padding - sizeof(gcov_accumulator_header);
+}
+
+void set_gcov_snapshot_buffer(unsigned char* start_address, const size_t size) {
+    const uintptr_t alignment = _Alignof(gcov_type);
+    const uintptr_t padding = (alignment - ((uintptr_t) start_address % alignment)) % alignment;
+
+    gcov_snapshot_counters = NULL;
+    gcov_snapshot_capacity = 0U;
+    __atomic_store_n(&gcov_snapshot_status, GCOV_SNAPSHOT_EMPTY, __ATOMIC_RELEASE);
+    if(!start_address || (size < padding))
+        return;
+    gcov_snapshot_counters = (gcov_type*) (start_address + padding);
+    gcov_snapshot_capacity = (size - padding) / sizeof(gcov_type);
+}
+
+void set_gcov_clock(const gcov_clock_fn clock) {
+    gcov_clock = clock;
+}
 
 void set_gcov_buffer(unsigned char* start_address, const gcov_unsigned_t size) {
-    gcov_output_buffer = start_address;
-    gcov_output_buffer_sz = size;
+    gcov_memory_sink_init(&gcov_buffer_sink, &gcov_buffer_sink_context, start_address, size);
+    set_gcov_sink(&gcov_buffer_sink);
 }
 
-void set_gcov_gcda_buffer(gcov_unsigned_t* start_address, const gcov_unsigned_t size) {
-    gcov_gcda_buffer = start_address;
-    gcov_gcda_buffer_sz = size;
+/*! \brief Updates a CRC-32 (IEEE 802.3) with a byte sequence
+ *
+ *  \param[in]  crc     The CRC-32 of the preceding bytes, 0 for the first bytes
+ *  \param[in]  data    The bytes to add
+ *  \param[in]  size    The number of bytes to add
+ *  \return             The CRC-32 of the preceding bytes and \a data, like zlib's crc32()
+ *
+ *  Eight bytes are folded in at once with one lookup per byte in the slicing-by-8 tables. The
+ *  lookups do not depend on each other, so they overlap in the pipeline instead of waiting for
+ *  the CRC of the previous byte. The bytes are assembled into words with shifts, which the
+ *  compiler turns into plain loads on little endian targets.
+ */
+static gcov_unsigned_t update_gcov_crc32(gcov_unsigned_t crc,
+                                         const unsigned char* data,
+                                         size_t size) {
+#ifndef GCOV_SMALL_CRC32
+    crc = ~crc;
+    for(; size >= 8U; data += 8U, size -= 8U) {
+        const gcov_unsigned_t word = (gcov_unsigned_t) data[0] | ((gcov_unsigned_t) data[1] << 8U)
+                                     | ((gcov_unsigned_t) data[2] << 16U)
+                                     | ((gcov_unsigned_t) data[3] << 24U);
+        const gcov_unsigned_t low = crc ^ word;
+        crc = gcov_crc32_table[7][low & 0xFFU] ^ gcov_crc32_table[6][(low >> 8U) & 0xFFU]
+              ^ gcov_crc32_table[5][(low >> 16U) & 0xFFU] ^ gcov_crc32_table[4][low >> 24U]
+              ^ gcov_crc32_table[3][data[4]] ^ gcov_crc32_table[2][data[5]]
+              ^ gcov_crc32_table[1][data[6]] ^ gcov_crc32_table[0][data[7]];
+    }
+    while(size--)
+        crc = (crc >> 8U) ^ gcov_crc32_table[0][(crc ^ *data++) & 0xFFU];
+    return ~crc;
+#else
+    // two lookups per byte in a table of 16 entries
+    static const gcov_unsigned_t nibble_table[16] = {
+        0x0000'0000U, 0x1DB7'1064U, 0x3B6E'20C8U, 0x26D9'30ACU,
+        0x76DC'4190U, 0x6B6B'51F4U, 0x4DB2'6158U, 0x5005'713CU,
+        0xEDB8'8320U, 0xF00F'9344U, 0xD6D6'A3E8U, 0xCB61'B38CU,
+        0x9B64'C2B0U, 0x86D3'D2D4U, 0xA00A'E278U, 0xBDBD'F21CU,
+    };
+    crc = ~crc;
+    while(size--) {
+        crc ^= *data++;
+        crc = (crc >> 4U) ^ nibble_table[crc & 0x0FU];
+        crc = (crc >> 4U) ^ nibble_table[crc & 0x0FU];
+    }
+    return ~crc;
+#endif
 }
 
-/*! \brief Saves the gcov data to a file
+/*! \brief Stores a uint32 value with MSB first in memory
  *
- *  \param[in]  filename    The name of the file the data will be stored in
- *  \param[in]  data        The pointer to the data to store
- *  \param[in]  size        The size of the data to store in bytes
+ *  \param[out] bytes   The destination, does not need to be aligned
+ *  \param[in]  value   The value to store
+ */
+static void put_gcov_be32(unsigned char* bytes, const gcov_unsigned_t value) {
+    bytes[0] = (unsigned char) ((value >> 24U) & 0xFFU);
+    bytes[1] = (unsigned char) ((value >> 16U) & 0xFFU);
+    bytes[2] = (unsigned char) ((value >> 8U) & 0xFFU);
+    bytes[3] = (unsigned char) (value & 0xFFU);
+}
+
+/*! \brief Resets the memory sink to the start of its buffer
  *
- *  Saves the gcda to a file. \\ TODO: Remove this function for embedded
+ *  \param[in]  context The memory sink context
+ *  \return             Always 0
  */
-void save_file(const char* filename, unsigned char* data, uint32_t size) {
-    if((data == NULL) || (size == 0))
-        return;
+static int gcov_memory_sink_begin(void* context) {
+    struct gcov_memory_sink_context* memory = (struct gcov_memory_sink_context*) context;
+    memory->used = 0U;
+    memory->crc = 0U;
+    memory->overflow = false;
+    return 0;
+}
+
+/*! \brief Appends a chunk to the buffer of the memory sink
+ *
+ *  \param[in]  context The memory sink context
+ *  \param[in]  data    The bytes to append
+ *  \param[in]  size    The number of bytes to append
+ *  \return             0 on success, -1 if the chunk does not fit into the buffer
+ */
+static int gcov_memory_sink_write(void* context, const unsigned char* data, const size_t size) {
+    struct gcov_memory_sink_context* memory = (struct gcov_memory_sink_context*) context;
+    if(!memory->buffer || (size > (memory->size - memory->used))) {
+        memory->overflow = true;
+        return -1;
+    }
+    memcpy(memory->buffer + memory->used, data, size);
+    memory->used += size;
+    memory->crc = update_gcov_crc32(memory->crc, data, size);
+    return 0;
+}
 
-    int f = open(filename, (O_CREAT | O_WRONLY), (S_IRWXU | S_IRWXG | S_IRWXO));
-    if(f < 0) {
+/*! \brief Stores the length and the CRC-32 of the complete image in its header
+ *
+ *  The serializer leaves both fields zero, so the CRC-32 calculated while the image was stored
+ *  covers the image with both fields zero. Images which did not fit keep a zero length.
+ */
+static int gcov_memory_sink_end(void* context) {
+    struct gcov_memory_sink_context* memory = (struct gcov_memory_sink_context*) context;
+    if(memory->overflow || (memory->used < GCOV_IMAGE_HEADER_SIZE))
+        return -1;
+    unsigned char* header = memory->buffer;
+    put_gcov_be32(header + GCOV_IMAGE_LENGTH_OFFSET, (gcov_unsigned_t) memory->used);
+    put_gcov_be32(header + GCOV_IMAGE_LENGTH_OFFSET + 4U, memory->crc);
+    return 0;
+}
+
+void gcov_memory_sink_init(struct gcov_sink* sink,
+                           struct gcov_memory_sink_context* context,
+                           unsigned char* buffer,
+                           const size_t size) {
+    context->buffer = buffer;
+    context->size = buffer ? size : 0U;
+    context->used = 0U;
+    context->crc = 0U;
+    context->overflow = false;
+
+    sink->begin = gcov_memory_sink_begin;
+    sink->write = gcov_memory_sink_write;
+    sink->end = gcov_memory_sink_end;
+    sink->context = context;
+}
+
+/*! \brief Hands the staged bytes of the writer to its sink
+ *
+ *  \param[in]  writer  The writer to flush
+ *  \return             True if the staging buffer is empty afterwards
+ */
+static bool flush_gcov_writer(gcov_writer* writer) {
+    if(writer->failed || !writer->sink) {
+        writer->failed = true;
+        return false;
+    }
+    if(writer->fill
+       && (writer->sink->write(writer->sink->context, writer->buffer, writer->fill) != 0))
+        writer->failed = true;
+    writer->fill = 0U;
+    return !writer->failed;
+}
+
+/*! \brief Stores a byte sequence in the buffer of the writer without counting it
+ *
+ *  \param[in]  writer  The writer to use
+ *  \param[in]  data    The bytes to store
+ *  \param[in]  size    The number of bytes to store
+ *
+ *  A full buffer is flushed to the sink, the bytes are dropped once the writer failed.
+ */
+static void stage_gcov_bytes(gcov_writer* writer, const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*) data;
+    while(size && !writer->failed) {
+        if((writer->fill == writer->size) && !flush_gcov_writer(writer))
+            return;
+        const size_t chunk =
+            (size < (writer->size - writer->fill)) ? size : (writer->size - writer->fill);
+        memcpy(writer->buffer + writer->fill, bytes, chunk);
+        writer->fill += chunk;
+        bytes += chunk;
+        size -= chunk;
+    }
+}
+
+/*! \brief Closes the current chunk of a checked image
+ *
+ *  \param[in]  writer  The writer to use
+ *
+ *  Stores the CRC-32 of the chunk with MSB first behind it, it is not counted as image byte.
+ */
+static void end_gcov_chunk(gcov_writer* writer) {
+    unsigned char crc[4];
+    put_gcov_be32(crc, writer->chunk_crc);
+    stage_gcov_bytes(writer, crc, sizeof(crc));
+    writer->chunk_crc = 0U;
+}
+
+/*! \brief Counts bytes of a checked image which were stored and adds them to the CRC-32s
+ *
+ *  \param[in]  writer  The writer to use
+ *  \param[in]  data    The stored bytes, must not cross the end of the current chunk
+ *  \param[in]  size    The number of stored bytes
+ */
+static void check_gcov_bytes(gcov_writer* writer, const unsigned char* data, const size_t size) {
+    writer->total += size;
+    writer->chunk_crc = update_gcov_crc32(writer->chunk_crc, data, size);
+    writer->record_crc = update_gcov_crc32(writer->record_crc, data, size);
+    if(!(writer->total % GCOV_IMAGE_CHUNK_SIZE))
+        end_gcov_chunk(writer);
+}
+
+/*! \brief Returns the number of bytes left in the current chunk of a checked image
+ */
+static size_t gcov_chunk_room(const gcov_writer* writer) {
+    return GCOV_IMAGE_CHUNK_SIZE - (writer->total % GCOV_IMAGE_CHUNK_SIZE);
+}
+
+/*! \brief Writes a byte sequence with the writer
+ *
+ *  \param[in]  writer  The writer to use
+ *  \param[in]  data    The bytes to write
+ *  \param[in]  size    The number of bytes to write
+ *
+ *  The bytes are always counted, but only stored as long as the writer did not fail. Checked
+ *  images are split at the chunk ends, where the CRC-32 of the chunk is inserted.
+ */
+static void write_gcov_bytes(gcov_writer* writer, const void* data, size_t size) {
+    if(!writer->buffer || !(writer->flags & GCOV_IMAGE_CHECKED)) {
+        writer->total += size;
+        if(writer->buffer)
+            stage_gcov_bytes(writer, data, size);
         return;
     }
-    int result = write(f, data, size);
-    close(f);
-    return;
+
+    const unsigned char* bytes = (const unsigned char*) data;
+    while(size) {
+        const size_t room = gcov_chunk_room(writer);
+        const size_t piece = (size < room) ? size : room;
+        stage_gcov_bytes(writer, bytes, piece);
+        check_gcov_bytes(writer, bytes, piece);
+        bytes += piece;
+        size -= piece;
+    }
 }
 
-/*! \brief Stores a uint32 value to the buffer
+/*! \brief Stores a uint32 value with the writer
  *
- *  \param buffer   The buffer in which to store the values
- *  \param offset   The offset in the buffer at which to place the values
+ *  \param writer   The writer to use
  *  \param value    The value to store
- *  \return         Returns the number of uint32 words stored.
  *
- *  Stores a uint32 value in the provided buffer.
+ *  Stores a uint32 value in the byte order of the target.
  */
-static size_t store_gcov_unsigned(gcov_unsigned_t* buffer, size_t offset, gcov_unsigned_t value) {
-    if(buffer) {
-        gcov_unsigned_t* data = buffer + offset;
-        *data = value;
-    }
-    return sizeof(value) / sizeof(*buffer);
+static void store_gcov_unsigned(gcov_writer* writer, const gcov_unsigned_t value) {
+    write_gcov_bytes(writer, &value, sizeof(value));
+}
+
+/*! \brief Stores a uint32 value with MSB first with the writer
+ *
+ *  \param writer   The writer to use
+ *  \param value    The value to store
+ *
+ *  Used for the container fields of the image which do not depend on the target byte order.
+ */
+static void store_gcov_be32(gcov_writer* writer, const gcov_unsigned_t value) {
+    unsigned char bytes[4];
+    put_gcov_be32(bytes, value);
+    write_gcov_bytes(writer, bytes, sizeof(bytes));
 }
 
-/*! \brief Stores a GCOV Tag with its length in the gcov format to the buffer
+/*! \brief Stores a GCOV Tag with its length in the gcov format with the writer
  *
- *  \param buffer   The buffer in which to store the values
- *  \param offset   The offset in the buffer at which to place the values
+ *  \param writer   The writer to use
  *  \param tag      The tag to store
  *  \param length   The length to store
- *  \return         Returns the number of uint32 words stored.
  *
- *  Stores a gcov tag and length in the provided buffer.
+ *  Stores a gcov tag and length.
  */
-static size_t store_gcov_tag_length(gcov_unsigned_t* buffer,
-                                    const size_t offset,
-                                    const gcov_unsigned_t tag,
-                                    const gcov_unsigned_t length) {
-    if(buffer) {
-        (void) store_gcov_unsigned(buffer, offset, tag);
-        (void) store_gcov_unsigned(buffer, offset + sizeof(tag) / sizeof(*buffer), length);
+static void store_gcov_tag_length(gcov_writer* writer,
+                                  const gcov_unsigned_t tag,
+                                  const gcov_unsigned_t length) {
+    store_gcov_unsigned(writer, tag);
+    store_gcov_unsigned(writer, length);
+}
+
+/*! \brief Sets a counter which may be updated concurrently to zero
+ *
+ *  \param[in]  value   The counter to clear
+ */
+static inline void clear_gcov_counter(gcov_type* value) {
+#ifdef GCOV_ATOMIC_COUNTERS
+    __atomic_store_n(value, 0, __ATOMIC_RELAXED);
+#else
+    *value = 0;
+#endif
+}
+
+/*! \brief Reads a counter value which may be updated concurrently and sets it to zero
+ *
+ *  \param[in]  value   The counter to take
+ *  \return             The value of the counter
+ *
+ *  With GCOV_ATOMIC_COUNTERS both happens in one atomic exchange, so no concurrent
+ *  increment gets lost.
+ */
+static inline gcov_type take_gcov_counter(gcov_type* value) {
+#ifdef GCOV_ATOMIC_COUNTERS
+    return __atomic_exchange_n(value, 0, __ATOMIC_RELAXED);
+#else
+    const gcov_type taken = *value;
+    *value = 0;
+    return taken;
+#endif
+}
+
+/*! \brief Selects the counters of a counter array from the live or the accumulated counters
+ *
+ *  \param[in,out]  accumulated The next accumulated counters, NULL for the live counters
+ *  \param[in]      counters    The live counter array
+ *  \return                     The counter array to use
+ *
+ *  The accumulation area holds the counters of all files in list order, so the position is
+ *  advanced by the number of counters of the array.
+ */
+static struct gcov_ctr_info source_gcov_counters(gcov_type** accumulated,
+                                                 const struct gcov_ctr_info* counters) {
+    struct gcov_ctr_info source = *counters;
+    if(*accumulated) {
+        source.values = *accumulated;
+        *accumulated += counters->num;
     }
-    return (sizeof(tag) + sizeof(length)) / sizeof(*buffer);
+    return source;
 }
 
-/*! \brief Stores a gcov counter which is a uint64 value to the provided buffer
+/*! \brief Converts counters into the word order of the gcda format
  *
- *  \param[in]  buffer  The buffer in which to store the value
- *  \param[in]  offset The offset in the buffer at which to place the value
- *  \param[in]  value  The value to store in the buffer
- *  \return Returns the number of uint32 words stored
+ *  \param[out] words   The destination, does not need to be aligned
+ *  \param[in]  values  The counters to convert
+ *  \param[in]  num     The number of counters
  *
- *  Stores a gcov counter which is a uint64 value to the provided buffer. If the buffer
- *  is a nullptr, nothing is stored.
- *  In GCOV 64 bit numbers are stored as two 32 bit numbers, the low part first.
+ *  On little endian targets the layout of the counter array is the one of the gcda format, so
+ *  the counters are copied as they are unless they have to be loaded atomically. Otherwise
+ *  convert_gcov_counter_words() converts them, swapping the halves on big endian targets.
  */
-static size_t store_gcov_counter(gcov_unsigned_t* buffer, size_t offset, gcov_type value) {
-    if(buffer) {
-        (void) store_gcov_unsigned(buffer, offset, value & 0xFFFF'FFFFUL);
-        (void) store_gcov_unsigned(
-            buffer, offset + sizeof(*buffer) / sizeof(*buffer), value >> 32U);
+static void convert_gcov_counters(unsigned char* words, const gcov_type* values, const size_t num) {
+#if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) && !defined(GCOV_ATOMIC_COUNTERS)
+    memcpy(words, values, num * sizeof(gcov_type));
+#else
+    convert_gcov_counter_words(words, values, num, __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__);
+#endif
+}
+
+/*! \brief Stores a counter array with the writer
+ *
+ *  \param[in]  writer  The writer to use
+ *  \param[in]  values  The counters to store
+ *  \param[in]  num     The number of counters
+ *
+ *  The counters are converted in bulk directly into the staging buffer. A counter which does
+ *  not fit into the rest of the buffer completely is staged on its own, so the chunks handed
+ *  to the sink stay as large as the buffer. In checked images the converted counters are added
+ *  to the CRC-32s while they are still in the cache, a counter crossing the end of a chunk goes
+ *  through write_gcov_bytes().
+ */
+static void store_gcov_counter_array(gcov_writer* writer, const gcov_type* values, size_t num) {
+    const bool checked = writer->buffer && (writer->flags & GCOV_IMAGE_CHECKED);
+    if(!checked)
+        writer->total += num * sizeof(gcov_type);
+    if(!writer->buffer)
+        return;
+
+    while(num && !writer->failed) {
+        size_t chunk = (writer->size - writer->fill) / sizeof(gcov_type);
+        if(checked && (gcov_chunk_room(writer) / sizeof(gcov_type) < chunk))
+            chunk = gcov_chunk_room(writer) / sizeof(gcov_type);
+        if(!chunk) {
+            // the counter is split between two chunks
+            unsigned char words[sizeof(gcov_type)];
+            convert_gcov_counters(words, values, 1U);
+            if(checked)
+                write_gcov_bytes(writer, words, sizeof(words));
+            else
+                stage_gcov_bytes(writer, words, sizeof(words));
+            ++values;
+            --num;
+            continue;
+        }
+        chunk = (num < chunk) ? num : chunk;
+        unsigned char* words = writer->buffer + writer->fill;
+        convert_gcov_counters(words, values, chunk);
+        writer->fill += chunk * sizeof(gcov_type);
+        if(checked)
+            check_gcov_bytes(writer, words, chunk * sizeof(gcov_type));
+        values += chunk;
+        num -= chunk;
+    }
+}
+
+/*! \brief Encodes a value as unsigned LEB128
+ *
+ *  \param[out] encoded The buffer for the encoded value, must hold GCOV_LEB128_MAX_SIZE bytes
+ *  \param[in]  value   The value to encode
+ *  \return             The number of bytes of the encoded value
+ */
+static size_t encode_gcov_leb128(unsigned char* encoded, uint64_t value) {
+    size_t size = 0U;
+    do {
+        encoded[size] = (unsigned char) (value & 0x7FU);
+        value >>= 7U;
+        if(value)
+            encoded[size] |= 0x80U;
+        ++size;
+    } while(value);
+    return size;
+}
+
+/*! \brief Stores the LEB128 encoded length of a run of zero counters
+ *
+ *  \param[in]  writer  The writer to use
+ *  \param[in]  run     The number of zero counters in the run, nothing is stored for 0
+ *  \return             The number of bytes stored
+ */
+static size_t store_gcov_zero_run(gcov_writer* writer, const gcov_unsigned_t run) {
+    unsigned char encoded[1U + GCOV_LEB128_MAX_SIZE] = {0U};
+    if(!run)
+        return 0U;
+    const size_t encoded_sz = 1U + encode_gcov_leb128(encoded + 1U, run);
+    write_gcov_bytes(writer, encoded, encoded_sz);
+    return encoded_sz;
+}
+
+/*! \brief Stores a counter of a packed counter record
+ *
+ *  \param[in]      writer  The writer to use
+ *  \param[in,out]  cursor  The position within the counter record
+ *  \param[in]      value   The counter
+ *
+ *  Zero counters are only counted, the run is stored in front of the next non-zero counter.
+ */
+static inline void store_gcov_packed_value(gcov_writer* writer,
+                                           gcov_info_cursor* cursor,
+                                           const uint64_t value) {
+    unsigned char encoded[GCOV_LEB128_MAX_SIZE];
+    if(!value) {
+        ++cursor->zero_run;
+        return;
+    }
+    cursor->encoded_total += store_gcov_zero_run(writer, cursor->zero_run);
+    cursor->zero_run = 0U;
+
+    const size_t encoded_sz = encode_gcov_leb128(encoded, value);
+    write_gcov_bytes(writer, encoded, encoded_sz);
+    cursor->encoded_total += encoded_sz;
+}
+
+/*! \brief Completes a packed counter record after its last counter
+ *
+ *  \param[in]      writer  The writer to use
+ *  \param[in,out]  cursor  The position within the counter record
+ *
+ *  Stores the pending zero run and pads the encoded values of the record with zeros to a
+ *  multiple of GCOV_WORD_SIZE.
+ */
+static void end_gcov_packed_values(gcov_writer* writer, gcov_info_cursor* cursor) {
+    static const unsigned char padding[GCOV_WORD_SIZE] = {0U};
+    cursor->encoded_total += store_gcov_zero_run(writer, cursor->zero_run);
+    write_gcov_bytes(writer,
+                     padding,
+                     (GCOV_WORD_SIZE - (cursor->encoded_total % GCOV_WORD_SIZE)) % GCOV_WORD_SIZE);
+}
+
+/*! \brief Stores the next counters of a counter record as zero runs and LEB128 values
+ *
+ *  \param[in]      writer  The writer to use
+ *  \param[in,out]  cursor  The position within the counter record
+ *  \param[in]      limit   The total number of bytes of the writer to stop at
+ *
+ *  Each non-zero counter is stored as LEB128 value, a run of zero counters as a zero byte
+ *  followed by the LEB128 encoded length of the run. The encoded values of the record are
+ *  padded with zeros to a multiple of GCOV_WORD_SIZE once its last counter was read.
+ */
+static void store_gcov_packed_values(gcov_writer* writer,
+                                     gcov_info_cursor* cursor,
+                                     const size_t limit) {
+    const struct gcov_ctr_info* counters = &cursor->source;
+    for(; (cursor->value_idx < counters->num) && (writer->total < limit); ++cursor->value_idx)
+        store_gcov_packed_value(
+            writer, cursor, (uint64_t) load_gcov_counter(counters->values + cursor->value_idx));
+    if(cursor->value_idx == counters->num)
+        end_gcov_packed_values(writer, cursor);
+}
+
+/*! \brief Collects the hit bits of up to 32 counters into a word
+ *
+ *  \param[out] bits    The word with the bit of the first counter in the LSB of the first byte
+ *  \param[in]  values  The counters
+ *  \param[in]  num     The number of counters, at most 32
+ *
+ *  The bits are collected without branches, which would mispredict on every other counter of
+ *  sparse coverage.
+ */
+static inline void collect_gcov_hit_bits(unsigned char* bits,
+                                         const gcov_type* values,
+                                         const gcov_unsigned_t num) {
+    gcov_unsigned_t mask = 0U;
+    for(gcov_unsigned_t value_idx = 0U; value_idx < num; ++value_idx)
+        mask |= (gcov_unsigned_t) (load_gcov_counter(values + value_idx) != 0) << value_idx;
+    bits[0] = (unsigned char) mask;
+    bits[1] = (unsigned char) (mask >> 8U);
+    bits[2] = (unsigned char) (mask >> 16U);
+    bits[3] = (unsigned char) (mask >> 24U);
+}
+
+/*! \brief Stores the next counters of a hit bits record, a word per 32 counters
+ *
+ *  \param[in]      writer  The writer to use
+ *  \param[in,out]  cursor  The position within the counter record
+ *  \param[in]      limit   The total number of bytes of the writer to stop at
+ *
+ *  The words are collected directly into the staging buffer like the counters of plain
+ *  records, a word which does not fit into the rest of the buffer or of the chunk of a checked
+ *  image goes through write_gcov_bytes(). Each word is complete, so the record needs no
+ *  padding. If the writer only counts, the counters are not visited.
+ */
+static void store_gcov_hit_bits(gcov_writer* writer,
+                                gcov_info_cursor* cursor,
+                                const size_t limit) {
+    const struct gcov_ctr_info* counters = &cursor->source;
+    if(!writer->buffer) {
+        writer->total += (counters->num - cursor->value_idx + 31U) / 32U * GCOV_WORD_SIZE;
+        cursor->value_idx = counters->num;
+        return;
+    }
+
+    const bool checked = writer->flags & GCOV_IMAGE_CHECKED;
+    while((cursor->value_idx < counters->num) && (writer->total < limit)) {
+        const size_t left = (counters->num - cursor->value_idx + 31U) / 32U;
+        size_t words = (writer->size - writer->fill) / GCOV_WORD_SIZE;
+        if(checked && (gcov_chunk_room(writer) / GCOV_WORD_SIZE < words))
+            words = gcov_chunk_room(writer) / GCOV_WORD_SIZE;
+        if(!words) {
+            // the word is split between two chunks
+            unsigned char bits[GCOV_WORD_SIZE];
+            const gcov_unsigned_t num = counters->num - cursor->value_idx;
+            collect_gcov_hit_bits(
+                bits, counters->values + cursor->value_idx, (num < 32U) ? num : 32U);
+            write_gcov_bytes(writer, bits, sizeof(bits));
+            cursor->value_idx += (num < 32U) ? num : 32U;
+            continue;
+        }
+        // the budget is kept, but a word is stored at least
+        const size_t allowed = (limit - writer->total + GCOV_WORD_SIZE - 1U) / GCOV_WORD_SIZE;
+        words = (left < words) ? left : words;
+        words = (allowed < words) ? allowed : words;
+
+        unsigned char* bits = writer->buffer + writer->fill;
+        for(size_t word_idx = 0U; word_idx < words; ++word_idx) {
+            const gcov_unsigned_t num = counters->num - cursor->value_idx;
+            // full words have a constant trip count, which the compiler vectorizes
+            if(num >= 32U)
+                collect_gcov_hit_bits(
+                    bits + (word_idx * GCOV_WORD_SIZE), counters->values + cursor->value_idx, 32U);
+            else
+                collect_gcov_hit_bits(
+                    bits + (word_idx * GCOV_WORD_SIZE), counters->values + cursor->value_idx, num);
+            cursor->value_idx += (num < 32U) ? num : 32U;
+        }
+        writer->fill += words * GCOV_WORD_SIZE;
+        if(checked)
+            check_gcov_bytes(writer, bits, words * GCOV_WORD_SIZE);
+        else
+            writer->total += words * GCOV_WORD_SIZE;
+    }
+}
+
+/*! \brief Checks whether a counter record of the cursor is stored as hit bits
+ */
+static bool is_gcov_hit_record(const gcov_writer* writer, const gcov_info_cursor* cursor) {
+    return (writer->flags & GCOV_IMAGE_HIT_ONLY) && (cursor->counter_idx == GCOV_COUNTER_ARCS);
+}
+
+/*! \brief Checks whether a counter record of the cursor holds topn profilers
+ *
+ *  The topn and indirect call profilers of -fprofile-generate builds keep their values in
+ *  lists, which are stored as value/count pairs.
+ */
+static bool is_gcov_topn_record(const gcov_info_cursor* cursor) {
+    return (cursor->counter_idx == GCOV_COUNTER_V_TOPN)
+           || (cursor->counter_idx == GCOV_COUNTER_V_INDIR);
+}
+
+/*! \brief Returns the first pair of the list of a live topn profiler
+ *
+ *  \param[in]  profiler    The GCOV_TOPN_MEM_COUNTERS counters of the profiler
+ *  \return                 The first pair, NULL if no value was tracked yet
+ */
+static inline const struct gcov_kvp* first_gcov_kvp(const gcov_type* profiler) {
+    return (const struct gcov_kvp*) (intptr_t) load_gcov_counter(profiler + 2);
+}
+
+/*! \brief Returns the pair behind a pair of the list of a topn profiler
+ */
+static inline const struct gcov_kvp* next_gcov_kvp(const struct gcov_kvp* pair) {
+#ifdef GCOV_ATOMIC_COUNTERS
+    return __atomic_load_n(&pair->next, __ATOMIC_ACQUIRE);
+#else
+    return pair->next;
+#endif
+}
+
+/*! \brief Counts the value/count pairs of a topn profiler
+ *
+ *  \param[in]  profiler    The GCOV_TOPN_MEM_COUNTERS counters of the profiler
+ *  \param[in]  accumulated Set if the counters were taken from the accumulation area
+ *  \return                 The number of pairs, at most GCOV_TOPN_MAX_VALUES
+ *
+ *  The accumulation area holds the number of calls, the most common value and its count
+ *  instead of the list, see __gcov_merge_topn().
+ */
+static gcov_unsigned_t count_gcov_topn_pairs(const gcov_type* profiler, const bool accumulated) {
+    if(accumulated)
+        return profiler[2] != 0;
+    gcov_unsigned_t pairs = 0U;
+    for(const struct gcov_kvp* pair = first_gcov_kvp(profiler);
+        pair && (pairs < GCOV_TOPN_MAX_VALUES); pair = next_gcov_kvp(pair))
+        ++pairs;
+    return pairs;
+}
+
+/*! \brief Stores a single counter of a plain or packed counter record
+ */
+static void store_gcov_value(gcov_writer* writer, gcov_info_cursor* cursor, const gcov_type value) {
+    if(writer->flags & GCOV_IMAGE_PACKED_COUNTERS)
+        store_gcov_packed_value(writer, cursor, (uint64_t) value);
+    else
+        store_gcov_counter_array(writer, &value, 1U);
+}
+
+/*! \brief Stores the next profilers of a topn record like libgcov writes them to gcda files
+ *
+ *  \param[in]      writer  The writer to use
+ *  \param[in,out]  cursor  The position within the counter record
+ *  \param[in]      limit   The total number of bytes of the writer to stop at
+ *
+ *  Each profiler is stored as the number of calls, the number of pairs and the pairs. The
+ *  pairs were counted for the record length by begin_gcov_counters(), so a list which grew in
+ *  between loses the new values and the last profiler is padded with empty pairs if lists were
+ *  released, the record always holds the announced number of pairs.
+ */
+static void store_gcov_topn_values(gcov_writer* writer,
+                                   gcov_info_cursor* cursor,
+                                   const size_t limit) {
+    const struct gcov_ctr_info* counters = &cursor->source;
+    const bool accumulated = cursor->accumulated != NULL;
+    for(; (cursor->value_idx < counters->num) && (writer->total < limit);
+        cursor->value_idx += GCOV_TOPN_MEM_COUNTERS) {
+        const gcov_type* profiler = counters->values + cursor->value_idx;
+        gcov_unsigned_t pairs = count_gcov_topn_pairs(profiler, accumulated);
+        if((pairs > cursor->topn_pairs)
+           || ((cursor->value_idx + GCOV_TOPN_MEM_COUNTERS) >= counters->num))
+            pairs = cursor->topn_pairs;
+        cursor->topn_pairs -= pairs;
+
+        store_gcov_value(writer, cursor, load_gcov_counter(profiler));
+        store_gcov_value(writer, cursor, pairs);
+        const struct gcov_kvp* pair = accumulated ? NULL : first_gcov_kvp(profiler);
+        for(gcov_unsigned_t pair_idx = 0U; pair_idx < pairs; ++pair_idx) {
+            if(accumulated && !pair_idx) {
+                store_gcov_value(writer, cursor, profiler[1]);
+                store_gcov_value(writer, cursor, profiler[2]);
+            } else if(pair) {
+                store_gcov_value(writer, cursor, load_gcov_counter(&pair->value));
+                store_gcov_value(writer, cursor, load_gcov_counter(&pair->count));
+                pair = next_gcov_kvp(pair);
+            } else {
+                store_gcov_value(writer, cursor, 0);
+                store_gcov_value(writer, cursor, 0);
+            }
+        }
+    }
+    if((cursor->value_idx >= counters->num) && (writer->flags & GCOV_IMAGE_PACKED_COUNTERS))
+        end_gcov_packed_values(writer, cursor);
+}
+
+/*! \brief Stores the next counters of a counter record with the writer
+ *
+ *  \param[in]      writer  The writer to use
+ *  \param[in,out]  cursor  The position within the counter record
+ *  \param[in]      limit   The total number of bytes of the writer to stop at
+ *
+ *  At least one counter is stored, the cursor moves on to the next counter record once the
+ *  last counter of the record was stored.
+ */
+static void store_gcov_values(gcov_writer* writer, gcov_info_cursor* cursor, const size_t limit) {
+    const struct gcov_ctr_info* counters = &cursor->source;
+    if(is_gcov_hit_record(writer, cursor)) {
+        store_gcov_hit_bits(writer, cursor, limit);
+    } else if(is_gcov_topn_record(cursor)) {
+        store_gcov_topn_values(writer, cursor, limit);
+    } else if(writer->flags & GCOV_IMAGE_PACKED_COUNTERS) {
+        store_gcov_packed_values(writer, cursor, limit);
+    } else {
+        const size_t allowed = (limit - writer->total) / sizeof(gcov_type);
+        size_t num = counters->num - cursor->value_idx;
+        if(allowed && (allowed < num))
+            num = allowed;
+        else if(!allowed && num)
+            num = 1U;
+        store_gcov_counter_array(writer, counters->values + cursor->value_idx, num);
+        cursor->value_idx += (gcov_unsigned_t) num;
+    }
+
+    if(cursor->value_idx >= counters->num) {
+        ++cursor->counter_idx;
+        cursor->stage = GCOV_CURSOR_RECORD;
+    }
+}
+
+/*! \brief Calculates the FNV-1a hash of a string
+ *
+ *  \param[in]  text    The string to hash
+ *  \return             The hash of the characters without the trailing null char
+ */
+static gcov_unsigned_t hash_gcov_string(const char* text) {
+    gcov_unsigned_t hash = 0x811C'9DC5U;
+    for(; *text; ++text)
+        hash = (hash ^ (unsigned char) *text) * 0x0100'0193U;
+    return hash;
+}
+
+/*! \brief Checks whether a pattern contains wildcards
+ */
+static bool has_gcov_wildcards(const char* pattern) {
+    return strchr(pattern, '*') || strchr(pattern, '?');
+}
+
+/*! \brief Matches a path against a glob pattern
+ *
+ *  \param[in]  pattern The pattern, `*` matches any sequence and `?` any single character
+ *  \param[in]  path    The path to match
+ *  \return             True if the whole path matches
+ *
+ *  On a mismatch the last `*` takes one more character, which needs no recursion.
+ */
+static bool match_gcov_glob(const char* pattern, const char* path) {
+    const char* star = NULL;
+    const char* star_path = NULL;
+    while(*path) {
+        if((*pattern == '?') || ((*pattern != '*') && (*pattern == *path))) {
+            ++pattern;
+            ++path;
+        } else if(*pattern == '*') {
+            star = pattern++;
+            star_path = path;
+        } else if(star) {
+            pattern = star + 1;
+            path = ++star_path;
+        } else {
+            return false;
+        }
+    }
+    while(*pattern == '*')
+        ++pattern;
+    return !*pattern;
+}
+
+/*! \brief Returns the filters matching a file
+ *
+ *  \param[in,out]  tag The file, its cached matches are updated if the filters changed
+ *  \return             Bit mask of the indices of the matching filters
+ *
+ *  Patterns without wildcards are compared by the hash of the path first.
+ */
+static gcov_unsigned_t match_gcov_filters(gcov_info_tag* tag) {
+    if(tag->filter_epoch == gcov_filter_epoch)
+        return tag->filter_matches;
+
+    const char* filename = tag->info->filename ? tag->info->filename : "";
+    gcov_unsigned_t matches = 0U;
+    for(size_t filter_idx = 0U; filter_idx < gcov_filter_count; ++filter_idx) {
+        const char* pattern = gcov_filters[filter_idx]->pattern;
+        bool match = !pattern;
+        if(pattern && !has_gcov_wildcards(pattern))
+            match = (gcov_filter_hashes[filter_idx] == tag->filename_hash)
+                    && !strcmp(pattern, filename);
+        else if(pattern)
+            match = match_gcov_glob(pattern, filename);
+        if(match)
+            matches |= 1U << filter_idx;
+    }
+    tag->filter_matches = matches;
+    tag->filter_epoch = gcov_filter_epoch;
+    return matches;
+}
+
+/*! \brief Checks whether a file is dumped
+ *
+ *  \param[in]  matches The filters matching the file
+ *  \return             True if the file passes the filters for whole files
+ */
+static bool is_gcov_file_selected(const gcov_unsigned_t matches) {
+    if(gcov_include_files && !(matches & gcov_include_files))
+        return false;
+    return !(matches & gcov_exclude_files);
+}
+
+/*! \brief Checks whether the sorted idents of a filter contain a function
+ */
+static bool has_gcov_filter_ident(const struct gcov_filter* filter, const gcov_unsigned_t ident) {
+    size_t first = 0U;
+    size_t last = filter->n_idents;
+    while(first < last) {
+        const size_t middle = first + ((last - first) / 2U);
+        if(filter->idents[middle] == ident)
+            return true;
+        if(filter->idents[middle] < ident)
+            first = middle + 1U;
+        else
+            last = middle;
     }
-    return sizeof(value) / sizeof(*buffer);
+    return false;
 }
 
-size_t gcov_convert_to_gcda(gcov_unsigned_t* buffer, struct gcov_info* info) {
-    size_t buffer_pos = 0U;
-    buffer_pos += store_gcov_tag_length(buffer, buffer_pos, GCOV_DATA_MAGIC, info->version);
-    buffer_pos += store_gcov_unsigned(buffer, buffer_pos, info->stamp);
-    buffer_pos += store_gcov_unsigned(buffer, buffer_pos, info->checksum);
+/*! \brief Checks whether a function is dumped
+ *
+ *  \param[in]  matches The function filters matching the file of the function
+ *  \param[in]  ident   The ident of the function
+ *  \return             True if the function passes the filters
+ */
+static bool is_gcov_function_selected(const gcov_unsigned_t matches, const gcov_unsigned_t ident) {
+    if(!matches)
+        return true;
+    bool included = !(matches & gcov_include_functions);
+    for(size_t filter_idx = 0U; filter_idx < gcov_filter_count; ++filter_idx) {
+        if(!(matches & (1U << filter_idx))
+           || !has_gcov_filter_ident(gcov_filters[filter_idx], ident))
+            continue;
+        if(gcov_filters[filter_idx]->include)
+            included = true;
+        else
+            return false;
+    }
+    return included;
+}
 
+/*! \brief Calculates a checksum over all counters of a function
+ *
+ *  \param[in]      info        The coverage data of the file the function belongs to
+ *  \param[in]      function    The function to calculate the checksum for
+ *  \param[in,out]  accumulated The accumulated counters of the function, NULL for live ones
+ *  \return                     The FNV-1a hash of the counter words of the function
+ */
+static gcov_unsigned_t checksum_gcov_function(const struct gcov_info* info,
+                                              const struct gcov_fn_info* function,
+                                              gcov_type** accumulated) {
+    gcov_unsigned_t checksum = 0x811C'9DC5U;
+    const struct gcov_ctr_info* counters = function->ctrs;
+    for(size_t counter_idx = 0U; counter_idx < GCOV_COUNTERS; ++counter_idx) {
+        if(!info->merge[counter_idx])
+            continue;    // unused counter
+        const struct gcov_ctr_info source = source_gcov_counters(accumulated, counters);
+        for(gcov_unsigned_t value_idx = 0U; value_idx < source.num; ++value_idx) {
+            const uint64_t value = (uint64_t) load_gcov_counter(source.values + value_idx);
+            checksum = (checksum ^ (gcov_unsigned_t) (value & 0xFFFF'FFFFU)) * 0x0100'0193U;
+            checksum = (checksum ^ (gcov_unsigned_t) (value >> 32U)) * 0x0100'0193U;
+        }
+        ++counters;
+    }
+    return checksum;
+}
+
+/*! \brief Selects the functions of a file which changed since the previous delta dump
+ *
+ *  \param[in]  info            The coverage data of the file
+ *  \param[in]  function_base   The baseline index of the first function of the file
+ *  \param[in]  accumulated     The accumulated counters of the file, NULL for the live ones
+ *  \return                     The number of functions of the file which have to be dumped
+ *
+ *  The baseline entry of each changed function is updated with its new checksum and stamped
+ *  with the current sequence number, so the set of functions is fixed before the record is
+ *  written even if the counters change in between. Functions without baseline entry are
+ *  always dumped.
+ */
+static size_t select_gcov_delta_functions(const struct gcov_info* info,
+                                          const size_t function_base,
+                                          gcov_type* accumulated,
+                                          const gcov_unsigned_t function_filters) {
+    size_t changed = 0U;
     for(size_t function_idx = 0U; function_idx < info->n_functions; ++function_idx) {
         const struct gcov_fn_info* function = info->functions[function_idx];
+        const gcov_unsigned_t checksum = checksum_gcov_function(info, function, &accumulated);
+        // filtered functions keep their baseline until they are dumped
+        if(!is_gcov_function_selected(function_filters, function->ident))
+            continue;
+        if((function_base + function_idx) >= gcov_delta_baseline_sz) {
+            ++changed;
+            continue;
+        }
+        struct gcov_function_baseline* baseline =
+            gcov_delta_baseline + function_base + function_idx;
+        // the first delta dump always contains all functions
+        if((gcov_delta_sequence == 1U) || (checksum != baseline->checksum)) {
+            baseline->checksum = checksum;
+            baseline->sequence = gcov_delta_sequence;
+            ++changed;
+        }
+    }
+    return changed;
+}
+
+/*! \brief Checks whether a function is part of the current delta dump
+ *
+ *  \param[in]  function_idx    The baseline index of the function
+ *  \return                     True if the function was selected for the current dump
+ */
+static bool is_gcov_delta_function(const size_t function_idx) {
+    return (function_idx >= gcov_delta_baseline_sz)
+           || (gcov_delta_baseline[function_idx].sequence == gcov_delta_sequence);
+}
+
+/*! \brief Checks whether a function was executed since the counters were reset
+ *
+ *  \param[in]  info        The coverage data of the file
+ *  \param[in]  function    The function
+ *  \return                 True if one of the arc counters of the function is not zero
+ */
+static bool is_gcov_function_hit(const struct gcov_info* info,
+                                 const struct gcov_fn_info* function) {
+    if(!info->merge[GCOV_COUNTER_ARCS])
+        return false;
+    // the arc counters are the first counter type
+    const struct gcov_ctr_info* arcs = function->ctrs;
+    for(gcov_unsigned_t value_idx = 0U; value_idx < arcs->num; ++value_idx) {
+        if(load_gcov_counter(arcs->values + value_idx))
+            return true;
+    }
+    return false;
+}
 
-        buffer_pos +=
-            store_gcov_tag_length(buffer, buffer_pos, GCOV_TAG_FUNCTION, GCOV_TAG_FUNCTION_LENGTH);
-        buffer_pos += store_gcov_unsigned(buffer, buffer_pos, function->ident);
-        buffer_pos += store_gcov_unsigned(buffer, buffer_pos, function->lineno_checksum);
-        buffer_pos += store_gcov_unsigned(buffer, buffer_pos, function->cfg_checksum);
+/*! \brief Checks whether a function of a file was executed since the counters were reset
+ *
+ *  \param[in]  info    The coverage data of the file
+ *  \return             True if one of the functions was executed
+ */
+static bool is_gcov_file_hit(const struct gcov_info* info) {
+    for(size_t function_idx = 0U; function_idx < info->n_functions; ++function_idx) {
+        if(is_gcov_function_hit(info, info->functions[function_idx]))
+            return true;
+    }
+    return false;
+}
 
-        const struct gcov_ctr_info* counters = function->ctrs;
+/*! \brief Starts the next function of a file
+ *
+ *  \param[in]      writer  The writer to use
+ *  \param[in,out]  cursor  The position within the gcda data of the file
+ *
+ *  With GCOV_IMAGE_DELTA only the functions selected by select_gcov_delta_functions() are
+ *  written, with GCOV_IMAGE_TEST only the executed ones. Functions left out by the filters are
+ *  skipped as well. The counters of skipped functions are not visited.
+ */
+static void begin_gcov_function(gcov_writer* writer, gcov_info_cursor* cursor) {
+    if(cursor->function_idx == cursor->info->n_functions) {
+        cursor->stage = GCOV_CURSOR_DONE;
+        return;
+    }
+
+    const struct gcov_fn_info* function = cursor->info->functions[cursor->function_idx];
+    cursor->skipped =
+        ((writer->flags & GCOV_IMAGE_DELTA)
+         && !is_gcov_delta_function(cursor->function_base + cursor->function_idx))
+        || ((writer->flags & GCOV_IMAGE_TEST) && !is_gcov_function_hit(cursor->info, function))
+        || !is_gcov_function_selected(cursor->function_filters, function->ident);
+    if(!cursor->skipped) {
+        store_gcov_tag_length(writer, GCOV_TAG_FUNCTION, GCOV_TAG_FUNCTION_LENGTH);
+        store_gcov_unsigned(writer, function->ident);
+        store_gcov_unsigned(writer, function->lineno_checksum);
+        store_gcov_unsigned(writer, function->cfg_checksum);
+    }
+    cursor->counters = function->ctrs;
+    cursor->counter_idx = 0U;
+    cursor->stage = GCOV_CURSOR_RECORD;
+}
+
+/*! \brief Starts the next counter record of a function
+ *
+ *  \param[in]      writer  The writer to use
+ *  \param[in,out]  cursor  The position within the gcda data of the file
+ *
+ *  Packed and hit bits records store the number of counters instead of the record length.
+ *  The length of topn records depends on the number of value pairs of their profilers, which
+ *  are counted up front.
+ */
+static void begin_gcov_counters(gcov_writer* writer, gcov_info_cursor* cursor) {
+    while((cursor->counter_idx < GCOV_COUNTERS) && !cursor->info->merge[cursor->counter_idx])
+        ++cursor->counter_idx;    // unused counter
+    if(cursor->counter_idx == GCOV_COUNTERS) {
+        ++cursor->function_idx;
+        cursor->stage = GCOV_CURSOR_FUNCTION;
+        return;
+    }
+
+    // the accumulated counters are advanced for skipped functions as well
+    cursor->source = source_gcov_counters(&cursor->accumulated, cursor->counters);
+    ++cursor->counters;
+    if(cursor->skipped) {
+        ++cursor->counter_idx;
+        return;
+    }
+
+    gcov_unsigned_t num = cursor->source.num;
+    cursor->topn_pairs = 0U;
+    if(is_gcov_topn_record(cursor)) {
+        for(gcov_unsigned_t value_idx = 0U; (value_idx + GCOV_TOPN_MEM_COUNTERS) <= num;
+            value_idx += GCOV_TOPN_MEM_COUNTERS)
+            cursor->topn_pairs += count_gcov_topn_pairs(cursor->source.values + value_idx,
+                                                        cursor->accumulated != NULL);
+        // the number of calls and of pairs of each profiler followed by the pairs
+        num = (num / GCOV_TOPN_MEM_COUNTERS * 2U) + (cursor->topn_pairs * 2U);
+    }
+
+    gcov_unsigned_t tag = GCOV_TAG_FOR_COUNTER(cursor->counter_idx);
+    gcov_unsigned_t length = GCOV_TAG_COUNTER_LENGTH(num);
+    if(is_gcov_hit_record(writer, cursor)) {
+        tag |= GCOV_TAG_HIT_BITS;
+        length = num;
+    } else if(writer->flags & GCOV_IMAGE_PACKED_COUNTERS) {
+        length = num;
+    }
+    store_gcov_tag_length(writer, tag, length);
+    cursor->value_idx = 0U;
+    cursor->zero_run = 0U;
+    cursor->encoded_total = 0U;
+    cursor->stage = GCOV_CURSOR_VALUES;
+}
+
+/*! \brief Serializes the coverage data of a single file in the gcda format
+ *
+ *  \param[in]      writer  The writer to use
+ *  \param[in,out]  cursor  The position within the gcda data of the file
+ *  \param[in]      limit   The total number of bytes of the writer to stop at, SIZE_MAX to
+ *                          write the whole file
+ *  \return                 True if all data of the file was written
+ *
+ *  Stops as soon as the writer reached \a limit, which is exceeded by less than the size of a
+ *  function record. If the writer only counts, the counter values of plain records are not
+ *  visited, so sizing a file only costs a walk over its functions.
+ */
+static bool write_gcov_info(gcov_writer* writer, gcov_info_cursor* cursor, const size_t limit) {
+    while((cursor->stage != GCOV_CURSOR_DONE) && (writer->total < limit)) {
+        switch(cursor->stage) {
+        case GCOV_CURSOR_HEADER:
+            store_gcov_tag_length(writer, GCOV_DATA_MAGIC, cursor->info->version);
+            store_gcov_unsigned(writer, cursor->info->stamp);
+            store_gcov_unsigned(writer, cursor->info->checksum);
+            // -fprofile-use tells hot from cold code by the runs and the largest arc counter
+            store_gcov_tag_length(writer, GCOV_TAG_OBJECT_SUMMARY, GCOV_TAG_SUMMARY_LENGTH);
+            store_gcov_unsigned(writer, cursor->runs);
+            store_gcov_unsigned(writer, cursor->sum_max);
+            cursor->stage = GCOV_CURSOR_FUNCTION;
+            break;
+        case GCOV_CURSOR_FUNCTION:
+            begin_gcov_function(writer, cursor);
+            break;
+        case GCOV_CURSOR_RECORD:
+            begin_gcov_counters(writer, cursor);
+            break;
+        default:
+            store_gcov_values(writer, cursor, limit);
+            break;
+        }
+    }
+    return cursor->stage == GCOV_CURSOR_DONE;
+}
+
+/*! \brief Counts the counters of a file
+ *
+ *  \param[in]  info    The coverage data of the file
+ *  \return             The number of counters of all functions and counter types
+ */
+static size_t count_gcov_values(const struct gcov_info* info) {
+    size_t values = 0U;
+    for(size_t function_idx = 0U; function_idx < info->n_functions; ++function_idx) {
+        const struct gcov_ctr_info* counters = info->functions[function_idx]->ctrs;
         for(size_t counter_idx = 0U; counter_idx < GCOV_COUNTERS; ++counter_idx) {
             if(!info->merge[counter_idx])
                 continue;    // unused counter
-            // counter record
-            buffer_pos += store_gcov_tag_length(buffer,
-                                                buffer_pos,
-                                                GCOV_TAG_FOR_COUNTER(counter_idx),
-                                                GCOV_TAG_COUNTER_LENGTH(counters->num));
-            for(size_t counter_value_idx = 0U; counter_value_idx < counters->num;
-                ++counter_value_idx) {
-                buffer_pos +=
-                    store_gcov_counter(buffer, buffer_pos, counters->values[counter_value_idx]);
-            }
+            values += counters->num;
             ++counters;
         }
     }
-    return buffer_pos * sizeof(*buffer);
+    return values;
 }
 
-void __gcov_init(struct gcov_info* info) {
-    gcov_info_tag* new_head = NULL;
+/*! \brief Looks up the largest arc counter of a file
+ *
+ *  \param[in]      info        The coverage data of the file
+ *  \param[in,out]  accumulated The accumulated counters of the file, advanced behind them, NULL
+ *                              for the live counters
+ *  \param[out]     arcs        The number of arc counters of the file
+ *  \return                     The largest arc counter, zero if there are none
+ */
+static gcov_type max_gcov_arc_counter(const struct gcov_info* info,
+                                      gcov_type** accumulated,
+                                      size_t* arcs) {
+    gcov_type sum_max = 0;
+    *arcs = 0U;
+    for(size_t function_idx = 0U; function_idx < info->n_functions; ++function_idx) {
+        const struct gcov_ctr_info* counters = info->functions[function_idx]->ctrs;
+        for(size_t counter_idx = 0U; counter_idx < GCOV_COUNTERS; ++counter_idx) {
+            if(!info->merge[counter_idx])
+                continue;    // unused counter
+            const struct gcov_ctr_info source = source_gcov_counters(accumulated, counters);
+            ++counters;
+            if(counter_idx != GCOV_COUNTER_ARCS)
+                continue;
+            for(gcov_unsigned_t value_idx = 0U; value_idx < source.num; ++value_idx) {
+                const gcov_type value = load_gcov_counter(source.values + value_idx);
+                if(value > sum_max)
+                    sum_max = value;
+            }
+            *arcs += source.num;
+        }
+    }
+    return sum_max;
+}
 
-    // check that we aren't over the maximum allowed number of files
-    if(gcov_info_file_idx >= (sizeof(gcov_info_file_buf) / sizeof(gcov_info_file_buf[0])))
-        new_head = NULL;
-    else
-        new_head = gcov_info_file_buf + gcov_info_file_idx;
+/*! \brief Converts the largest arc counter into the word of the object summary
+ *
+ *  libgcov truncates it to 32 bit, larger counters are saturated here instead.
+ */
+static inline gcov_unsigned_t gcov_summary_max(const gcov_type sum_max) {
+    return (sum_max > (gcov_type) UINT32_MAX) ? UINT32_MAX : (gcov_unsigned_t) sum_max;
+}
+
+/*! \brief Calculates the checksum of the layout of the counters of all registered files
+ *
+ *  \param[out] values  The number of counters of all registered files
+ *  \return             The FNV-1a hash of the stamps, checksums and counter numbers
+ */
+static gcov_unsigned_t checksum_gcov_layout(size_t* values) {
+    gcov_unsigned_t layout = 0x811C'9DC5U;
+    *values = 0U;
+    for(gcov_info_tag* list_ptr = __atomic_load_n(&gcov_head, __ATOMIC_ACQUIRE); list_ptr;
+        list_ptr = list_ptr->next) {
+        const size_t file_values = count_gcov_values(list_ptr->info);
+        layout = (layout ^ list_ptr->info->stamp) * 0x0100'0193U;
+        layout = (layout ^ list_ptr->info->checksum) * 0x0100'0193U;
+        layout = (layout ^ (gcov_unsigned_t) file_values) * 0x0100'0193U;
+        *values += file_values;
+    }
+    return layout;
+}
 
+/*! \brief Checks whether the accumulation area holds counters of this build
+ *
+ *  \param[in]  layout  The checksum of the layout of the counters of all registered files
+ *  \param[in]  values  The number of counters of all registered files
+ *  \return             True if the area holds the accumulated counters of all files
+ */
+static bool is_gcov_accumulator_valid(const gcov_unsigned_t layout, const size_t values) {
+    return gcov_accumulator && (gcov_accumulator->magic == GCOV_ACCUMULATOR_MAGIC)
+           && (gcov_accumulator->layout == layout) && (gcov_accumulator->values == values);
+}
+
+/*! \brief Stores the header of the image
+ *
+ *  \param[in]  writer      The writer to use
+ *  \param[in]  sequence    The sequence number of the dump, 0 for images without sequence
+ *
+ *  The header consists of the GCOV_IMAGE_MAGIC, the GCOV_IMAGE_VERSION, the flags and the
+ *  lower 16 bit of the sequence number with MSB first. The length and the CRC-32 behind are left
+ *  zero, the memory sinks fill them in once the image is complete.
+ */
+static void write_gcov_image_header(gcov_writer* writer, const gcov_unsigned_t sequence) {
+    const unsigned char header[GCOV_IMAGE_HEADER_SIZE] = {
+        GCOV_IMAGE_MAGIC[0],
+        GCOV_IMAGE_MAGIC[1],
+        GCOV_IMAGE_MAGIC[2],
+        GCOV_IMAGE_MAGIC[3],
+        GCOV_IMAGE_VERSION,
+        (unsigned char) (writer->flags & 0xFFU),
+        (unsigned char) ((sequence >> 8U) & 0xFFU),
+        (unsigned char) (sequence & 0xFFU),
+    };
+    write_gcov_bytes(writer, header, sizeof(header));
+}
+
+size_t gcov_convert_to_gcda(unsigned char* buffer, const size_t size, struct gcov_info* info) {
+    gcov_writer writer = {.buffer = buffer, .size = buffer ? size : 0U};
+    gcov_info_cursor cursor = {.info = info, .runs = 1U, .stage = GCOV_CURSOR_HEADER};
+    if(buffer) {
+        gcov_type* accumulated = NULL;
+        size_t arcs = 0U;
+        cursor.sum_max = gcov_summary_max(max_gcov_arc_counter(info, &accumulated, &arcs));
+    }
+    (void) write_gcov_info(&writer, &cursor, SIZE_MAX);
+    return writer.total;
+}
+
+void __gcov_init(struct gcov_info* info) {
+    // reserve an entry, files beyond the maximum allowed number are not registered
+    const gcov_unsigned_t file_idx = __atomic_fetch_add(&gcov_info_file_idx, 1U, __ATOMIC_RELAXED);
+    if(file_idx >= GCOV_MAX_FILES)
+        return;
+
+    gcov_info_tag* new_head = gcov_info_file_buf + file_idx;
     new_head->info = info;
-    new_head->next = gcov_head;
-    gcov_head = new_head;
-    ++gcov_info_file_idx;
+    new_head->filename_hash = hash_gcov_string(info->filename ? info->filename : "");
+    new_head->filter_epoch = 0U;
+    // lock-free push, the entry is published together with its contents
+    new_head->next = __atomic_load_n(&gcov_head, __ATOMIC_RELAXED);
+    while(!__atomic_compare_exchange_n(
+        &gcov_head, &new_head->next, new_head, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+    }
 }
 
-void __gcov_exit(void) {
-    gcov_output_index = 0;
+/*! \brief Starts a new dump
+ *
+ *  \param[out] dump    The state of the dump
+ *  \return             True if the sink accepted the image
+ */
+static bool begin_gcov_dump(gcov_dump_state* dump) {
+    const struct gcov_sink* sink = gcov_output_sink;
+    if(!sink || !sink->write)
+        return false;
+    if(sink->begin && (sink->begin(sink->context) != 0))
+        return false;
 
-    gcov_info_tag* list_ptr = gcov_head;
-    //!< \TODO: replace with embedded allocation to static memory
+    *dump = (gcov_dump_state) {
+        .phase = GCOV_PHASE_SUMMARY,
+        .writer = {.buffer = gcov_staging_buffer,
+                   .size = sizeof(gcov_staging_buffer),
+                   .sink = sink,
+                   .flags = gcov_image_flags},
+        .file = __atomic_load_n(&gcov_head, __ATOMIC_ACQUIRE),
+        .runs = 1U,
+    };
+    dump->head = dump->file;
+    gcov_writer* writer = &dump->writer;
+    if(gcov_unregistered_files())
+        writer->flags |= GCOV_IMAGE_INCOMPLETE;
+    if(gcov_filter_count)
+        writer->flags |= GCOV_IMAGE_FILTERED;
 
-    // Add checks that the output buffer pointer does not exceed the limits of the buffer
-    while(list_ptr) {
-        const uint32_t bytes_needed = gcov_convert_to_gcda(NULL, list_ptr->info);
+    gcov_unsigned_t sequence = 0U;
+    if(writer->flags & GCOV_IMAGE_DELTA)
+        sequence = ++gcov_delta_sequence;
+    else if(writer->flags & GCOV_IMAGE_TEST)
+        sequence = gcov_test_id;
+    write_gcov_image_header(writer, sequence);
 
-        gcov_unsigned_t* buffer = NULL;
-        if(bytes_needed > (gcov_gcda_buffer_sz * sizeof(gcov_unsigned_t))) {
-            buffer = (gcov_unsigned_t*) NULL;
+    // a pending snapshot replaces the live counters, accumulated and test images keep theirs
+    gcov_snapshot_state ready = GCOV_SNAPSHOT_READY;
+    if(!(writer->flags & (GCOV_IMAGE_ACCUMULATED | GCOV_IMAGE_TEST))
+       && __atomic_compare_exchange_n(&gcov_snapshot_status, &ready, GCOV_SNAPSHOT_DUMPING, false,
+                                      __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        dump->snapshot = true;
+        dump->head = gcov_snapshot_head;
+        dump->file = gcov_snapshot_head;
+        dump->accumulated = gcov_snapshot_counters;
+    }
+    // accumulated images hold no records until a run was accumulated
+    if(writer->flags & GCOV_IMAGE_ACCUMULATED) {
+        size_t values = 0U;
+        const gcov_unsigned_t layout = checksum_gcov_layout(&values);
+        if(is_gcov_accumulator_valid(layout, values)) {
+            dump->accumulated = (gcov_type*) (gcov_accumulator + 1);
+            dump->runs = gcov_accumulator->runs;
         } else {
-            // buffer = gcov_buffer; // TODO: use something like this for embedded
-            // clear buffer before use
-            memset(gcov_gcda_buffer, 0U, gcov_gcda_buffer_sz * sizeof(gcov_gcda_buffer_sz));
-            buffer = gcov_gcda_buffer;    // TODO: Replace with embedded allocation
+            dump->file = NULL;
         }
-        // + 6 because of the end string "GCOV End\n" we need to add
-        if(bytes_needed
-           > ((gcov_output_buffer_sz - gcov_output_index) * sizeof(gcov_unsigned_t) + 9U))
-            return;
+    }
+    dump->summary_file = dump->file;
+    dump->summary_counters = dump->accumulated;
+    return true;
+}
 
-        if(!buffer)    //! not enough memory reserved
-            return;
-        // convert the binary data to gcda and store it in a local buffer
-        (void) gcov_convert_to_gcda(buffer, list_ptr->info);
+/*! \brief Looks at the arc counters of the next file for the object summaries
+ *
+ *  \param[in,out]  dump    The state of the dump
+ *  \return                 The size of the arc counters looked at in bytes
+ *
+ *  Like in libgcov the largest arc counter is taken over all files, including the ones left
+ *  out by the filters, so it is known before the first record is written.
+ */
+static size_t step_gcov_summary(gcov_dump_state* dump) {
+    gcov_info_tag* file = dump->summary_file;
+    if(!file) {
+        dump->phase = GCOV_PHASE_RECORDS;
+        return 0U;
+    }
+    size_t arcs = 0U;
+    const gcov_type file_max = max_gcov_arc_counter(file->info, &dump->summary_counters, &arcs);
+    if(file_max > dump->sum_max)
+        dump->sum_max = file_max;
+    dump->summary_file = file->next;
+    return arcs * sizeof(gcov_type);
+}
+
+/*! \brief Moves the dump on to the next file
+ *
+ *  \param[in,out]  dump    The state of the dump
+ */
+static void next_gcov_file(gcov_dump_state* dump) {
+    dump->function_base += dump->file->info->n_functions;
+    dump->file = dump->file->next;
+    dump->in_record = false;
+}
+
+/*! \brief Starts the record of the current file of the dump
+ *
+ *  \param[in,out]  dump    The state of the dump
+ *  \return                 The size of the counters looked at without writing them in bytes
+ *
+ *  Files left out by the filters, without changes since the previous delta dump or without
+ *  executed functions in test images are skipped, the dump moves on to the next file then. A
+ *  skipped file costs at least the size of a table of contents entry, so the files skipped by
+ *  a call of gcov_dump_step() are bounded by its budget as well.
+ */
+static size_t begin_gcov_record(gcov_dump_state* dump) {
+    gcov_writer* writer = &dump->writer;
+    gcov_info_tag* file = dump->file;
+    gcov_type* file_accumulated = dump->accumulated;
+    const size_t values = count_gcov_values(file->info);
+    if(dump->accumulated)
+        dump->accumulated += values;
+
+    const gcov_unsigned_t matches = match_gcov_filters(file);
+    if(!is_gcov_file_selected(matches)) {
+        next_gcov_file(dump);
+        return GCOV_IMAGE_TOC_ENTRY_SIZE;
+    }
+    const gcov_unsigned_t function_filters =
+        matches & (gcov_include_functions | gcov_exclude_functions);
+    // delta dumps compare all counters of the file before its record is started
+    size_t scanned = 0U;
+    if(writer->flags & GCOV_IMAGE_DELTA) {
+        scanned = values * sizeof(gcov_type);
+        // files without changes are left out of delta dumps
+        if(!select_gcov_delta_functions(
+               file->info, dump->function_base, file_accumulated, function_filters)) {
+            next_gcov_file(dump);
+            return scanned + GCOV_IMAGE_TOC_ENTRY_SIZE;
+        }
+    }
+    // the arc counters are looked at up to the first executed one, at most all counters
+    if((writer->flags & GCOV_IMAGE_TEST) && !is_gcov_file_hit(file->info)) {
+        next_gcov_file(dump);
+        return values * sizeof(gcov_type) + GCOV_IMAGE_TOC_ENTRY_SIZE;
+    }
+
+    const char* filename = file->info->filename ? file->info->filename : "";
+    if(writer->flags & GCOV_IMAGE_CHECKED)
+        write_gcov_bytes(writer, GCOV_IMAGE_RECORD_MARKER, sizeof(GCOV_IMAGE_RECORD_MARKER) - 1U);
+    file->record_offset = (gcov_unsigned_t) writer->total;
+    writer->record_crc = 0U;
+    // filename with trailing null char for string completion
+    write_gcov_bytes(writer, filename, strlen(filename) + 1U);
+    dump->data_offset = writer->total;
+    dump->cursor = (gcov_info_cursor) {
+        .info = file->info,
+        .function_base = dump->function_base,
+        .accumulated = file_accumulated,
+        .function_filters = function_filters,
+        .runs = dump->runs,
+        .sum_max = gcov_summary_max(dump->sum_max),
+        .stage = GCOV_CURSOR_HEADER,
+    };
+    dump->in_record = true;
+    return scanned;
+}
+
+/*! \brief Writes the next part of the records of the dump
+ *
+ *  \param[in,out]  dump    The state of the dump
+ *  \param[in]      limit   The total number of bytes of the writer to stop at
+ *  \return                 The size of the counters looked at without writing them in bytes
+ */
+static size_t step_gcov_records(gcov_dump_state* dump, const size_t limit) {
+    gcov_writer* writer = &dump->writer;
+    if(!dump->file || writer->failed) {
+        // a record cut off by a failed sink is not listed in the table of contents
+        dump->phase = GCOV_PHASE_TOC;
+        dump->toc_offset = (gcov_unsigned_t) writer->total;
+        dump->file = dump->head;
+        return 0U;
+    }
+    if(!dump->in_record)
+        return begin_gcov_record(dump);
+    if(!write_gcov_info(writer, &dump->cursor, limit))
+        return 0U;
+
+    // the record ends with a zero tag, so every counter is only read once
+    dump->file->data_length = (gcov_unsigned_t) (writer->total - dump->data_offset);
+    store_gcov_unsigned(writer, 0U);
+    if(writer->flags & GCOV_IMAGE_CHECKED) {
+        const gcov_unsigned_t record_crc = writer->record_crc;
+        store_gcov_be32(writer, record_crc);
+    }
+    dump->file->dumped = true;
+    ++dump->records;
+    next_gcov_file(dump);
+    return 0U;
+}
+
+/*! \brief Writes the next table of contents entry of the dump
+ *
+ *  \param[in,out]  dump    The state of the dump
+ *  \return                 The size of an entry for files without record, 0 otherwise
+ *
+ *  The table of contents follows the records, it is followed by its offset and number of
+ *  entries and the end marker. Files without record are charged like an entry, so the files
+ *  passed over by a call of gcov_dump_step() are bounded by its budget.
+ */
+static size_t step_gcov_toc(gcov_dump_state* dump) {
+    static const char end_marker[] = "Gcov End";
+    gcov_writer* writer = &dump->writer;
+    gcov_info_tag* file = dump->file;
+    if(!file) {
+        store_gcov_be32(writer, dump->toc_offset);
+        store_gcov_be32(writer, dump->records);
+        write_gcov_bytes(writer, end_marker, sizeof(end_marker));
+        // the last chunk of a checked image is shorter unless the image fills it
+        if((writer->flags & GCOV_IMAGE_CHECKED) && (writer->total % GCOV_IMAGE_CHUNK_SIZE))
+            end_gcov_chunk(writer);
+        dump->phase = GCOV_PHASE_END;
+        return 0U;
+    }
+
+    dump->file = file->next;
+    if(!file->dumped)
+        return GCOV_IMAGE_TOC_ENTRY_SIZE;
+    const char* filename = file->info->filename ? file->info->filename : "";
+    store_gcov_be32(writer, file->record_offset);
+    store_gcov_be32(writer, file->record_offset + strlen(filename) + 1U);
+    store_gcov_be32(writer, file->data_length);
+    file->dumped = false;
+    return 0U;
+}
+
+int gcov_dump_step(const size_t budget) {
+    gcov_dump_state* dump = &gcov_running_dump;
+    if((dump->phase == GCOV_PHASE_IDLE) && !begin_gcov_dump(dump))
+        return GCOV_DUMP_FAILED;
+
+    // every call takes at least one step, writing bytes or passing over a file, so the dump
+    // always makes progress
+    gcov_writer* writer = &dump->writer;
+    size_t limit = SIZE_MAX;
+    if(budget < (SIZE_MAX - writer->total))
+        limit = writer->total + (budget ? budget : 1U);
+    // the counters looked at for the object summaries, by delta dumps and test images and the
+    // files passed over count against the budget as well
+    size_t scanned = 0U;
+    while((dump->phase != GCOV_PHASE_END) && ((writer->total + scanned) < limit)) {
+        if(dump->phase == GCOV_PHASE_SUMMARY)
+            scanned += step_gcov_summary(dump);
+        else if(dump->phase == GCOV_PHASE_RECORDS)
+            scanned += step_gcov_records(dump, limit - scanned);
+        else
+            scanned += step_gcov_toc(dump);
+    }
+    if(dump->phase != GCOV_PHASE_END)
+        return GCOV_DUMP_PENDING;
+
+    dump->phase = GCOV_PHASE_IDLE;
+    // all counters of the snapshot were read, the next gcov_snapshot() may overwrite them
+    if(dump->snapshot)
+        __atomic_store_n(&gcov_snapshot_status, GCOV_SNAPSHOT_EMPTY, __ATOMIC_RELEASE);
+    bool written = flush_gcov_writer(writer);
+    if(writer->sink->end && (writer->sink->end(writer->sink->context) != 0))
+        written = false;
+    return written ? GCOV_DUMP_DONE : GCOV_DUMP_FAILED;
+}
+
+void __gcov_dump(void) {
+    // completes a dump started by gcov_dump_step() or writes a new one in a single step
+    while(gcov_dump_step(SIZE_MAX) == GCOV_DUMP_PENDING) {
+    }
+}
+
+void __gcov_reset(void) {
+    for(gcov_info_tag* list_ptr = __atomic_load_n(&gcov_head, __ATOMIC_ACQUIRE); list_ptr;
+        list_ptr = list_ptr->next) {
+        const struct gcov_info* info = list_ptr->info;
+        for(size_t function_idx = 0U; function_idx < info->n_functions; ++function_idx) {
+            const struct gcov_ctr_info* counters = info->functions[function_idx]->ctrs;
+            for(size_t counter_idx = 0U; counter_idx < GCOV_COUNTERS; ++counter_idx) {
+                if(!info->merge[counter_idx])
+                    continue;    // unused counter
+                for(gcov_unsigned_t value_idx = 0U; value_idx < counters->num; ++value_idx)
+                    clear_gcov_counter(counters->values + value_idx);
+                ++counters;
+            }
+        }
+    }
+    // the lists of the topn profilers were cleared as well
+    if(release_gcov_topn_values)
+        release_gcov_topn_values();
+}
+
+void __gcov_exit(void) {
+    __gcov_dump();
+}
+
+int gcov_accumulate(void) {
+    size_t values = 0U;
+    const gcov_unsigned_t layout = checksum_gcov_layout(&values);
+    if(!gcov_accumulator)
+        return -1;
+    if(!is_gcov_accumulator_valid(layout, values)) {
+        if(values > (gcov_accumulator_sz / sizeof(gcov_type)))
+            return -1;
+        // start over with empty counters for this build
+        memset(gcov_accumulator + 1, 0, values * sizeof(gcov_type));
+        gcov_accumulator->magic = GCOV_ACCUMULATOR_MAGIC;
+        gcov_accumulator->layout = layout;
+        gcov_accumulator->runs = 0U;
+        gcov_accumulator->values = (gcov_unsigned_t) values;
+    }
+
+    gcov_type* accumulated = (gcov_type*) (gcov_accumulator + 1);
+    for(gcov_info_tag* list_ptr = __atomic_load_n(&gcov_head, __ATOMIC_ACQUIRE); list_ptr;
+        list_ptr = list_ptr->next) {
+        const struct gcov_info* info = list_ptr->info;
+        for(size_t function_idx = 0U; function_idx < info->n_functions; ++function_idx) {
+            const struct gcov_ctr_info* counters = info->functions[function_idx]->ctrs;
+            for(size_t counter_idx = 0U; counter_idx < GCOV_COUNTERS; ++counter_idx) {
+                if(!info->merge[counter_idx])
+                    continue;    // unused counter
+                // the merge function takes the live counters and merges them into the area
+                gcov_merge_source = counters->values;
+                info->merge[counter_idx](accumulated, counters->num);
+                accumulated += counters->num;
+                ++counters;
+            }
+        }
+    }
+    gcov_merge_source = NULL;
+    // the lists of the topn profilers were taken by the merge
+    if(release_gcov_topn_values)
+        release_gcov_topn_values();
+
+    ++gcov_accumulator->runs;
+    return 0;
+}
+
+void gcov_clear_accumulator(void) {
+    if(gcov_accumulator)
+        gcov_accumulator->magic = 0U;
+}
+
+gcov_unsigned_t gcov_accumulated_runs(void) {
+    size_t values = 0U;
+    const gcov_unsigned_t layout = checksum_gcov_layout(&values);
+    return is_gcov_accumulator_valid(layout, values) ? gcov_accumulator->runs : 0U;
+}
+
+/*! \brief Copies the live counters of a counter array into the snapshot area
+ *
+ *  \param[out] copy    The counters in the snapshot area
+ *  \param[in]  values  The live counters
+ *  \param[in]  num     The number of counters
+ */
+static void copy_gcov_counters(gcov_type* copy, const gcov_type* values, const size_t num) {
+#ifdef GCOV_ATOMIC_COUNTERS
+    for(size_t value_idx = 0U; value_idx < num; ++value_idx)
+        copy[value_idx] = load_gcov_counter(values + value_idx);
+#else
+    memcpy(copy, values, num * sizeof(gcov_type));
+#endif
+}
 
-        // copy the filename to the output buffer
-        for(const char* filename = list_ptr->info->filename; filename && (*filename); ++filename) {
-            gcov_output_buffer[gcov_output_index++] = (*filename);
+/*! \brief Copies the live topn profilers of a counter array into the snapshot area
+ *
+ *  \param[out] copy    The profilers in the snapshot area
+ *  \param[in]  values  The live profilers, GCOV_TOPN_MEM_COUNTERS counters each
+ *  \param[in]  num     The number of counters
+ *
+ *  Like the accumulation area the snapshot holds the number of calls, the most common value and
+ *  its count of each profiler instead of the list of pairs, the live lists are left untouched.
+ */
+static void copy_gcov_topn_counters(gcov_type* copy, const gcov_type* values, const size_t num) {
+    for(size_t value_idx = 0U; (value_idx + GCOV_TOPN_MEM_COUNTERS) <= num;
+        value_idx += GCOV_TOPN_MEM_COUNTERS) {
+        const gcov_type* profiler = values + value_idx;
+        gcov_type* copied = copy + value_idx;
+        copied[0] = load_gcov_counter(profiler);
+        copied[1] = 0;
+        copied[2] = 0;
+        gcov_unsigned_t pair_idx = 0U;
+        for(const struct gcov_kvp* pair = first_gcov_kvp(profiler);
+            pair && (pair_idx < GCOV_TOPN_MAX_VALUES); pair = next_gcov_kvp(pair), ++pair_idx) {
+            const gcov_type count = load_gcov_counter(&pair->count);
+            if(count > copied[2]) {
+                copied[1] = load_gcov_counter(&pair->value);
+                copied[2] = count;
+            }
         }
-        // trailing null char for string completion
-        gcov_output_buffer[gcov_output_index++] = '\0';
-        // store data byte count with MSB first
-        gcov_output_buffer[gcov_output_index++] = (unsigned char) ((bytes_needed >> 24U) & 0xFFFF);
-        gcov_output_buffer[gcov_output_index++] = (unsigned char) ((bytes_needed >> 16U) & 0xFFFF);
-        gcov_output_buffer[gcov_output_index++] = (unsigned char) ((bytes_needed >> 8U) & 0xFFFF);
-        gcov_output_buffer[gcov_output_index++] = (unsigned char) (bytes_needed & 0xFFFF);
-
-        // copy converted gcda data to output location
-        for(size_t i = 0U; i < bytes_needed; ++i) {
-            gcov_output_buffer[gcov_output_index++] =
-                (unsigned char) (((unsigned char*) buffer)[i]);
+    }
+}
+
+int gcov_snapshot(void) {
+    const gcov_clock_fn clock = gcov_clock;
+    const gcov_unsigned_t start = clock ? clock() : 0U;
+    if(!gcov_snapshot_counters)
+        return -1;
+    // a snapshot which was not dumped yet is replaced, one which is dumped right now is kept
+    gcov_snapshot_state state = __atomic_load_n(&gcov_snapshot_status, __ATOMIC_RELAXED);
+    do {
+        if((state != GCOV_SNAPSHOT_EMPTY) && (state != GCOV_SNAPSHOT_READY))
+            return -1;
+    } while(!__atomic_compare_exchange_n(&gcov_snapshot_status, &state, GCOV_SNAPSHOT_COPYING,
+                                         true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+
+    gcov_info_tag* head = __atomic_load_n(&gcov_head, __ATOMIC_ACQUIRE);
+    gcov_type* copy = gcov_snapshot_counters;
+    size_t room = gcov_snapshot_capacity;
+    for(gcov_info_tag* list_ptr = head; list_ptr; list_ptr = list_ptr->next) {
+        const struct gcov_info* info = list_ptr->info;
+        for(size_t function_idx = 0U; function_idx < info->n_functions; ++function_idx) {
+            const struct gcov_ctr_info* counters = info->functions[function_idx]->ctrs;
+            for(size_t counter_idx = 0U; counter_idx < GCOV_COUNTERS; ++counter_idx) {
+                if(!info->merge[counter_idx])
+                    continue;    // unused counter
+                if(counters->num > room) {
+                    __atomic_store_n(&gcov_snapshot_status, GCOV_SNAPSHOT_EMPTY, __ATOMIC_RELEASE);
+                    return -1;
+                }
+                if((counter_idx == GCOV_COUNTER_V_TOPN) || (counter_idx == GCOV_COUNTER_V_INDIR))
+                    copy_gcov_topn_counters(copy, counters->values, counters->num);
+                else
+                    copy_gcov_counters(copy, counters->values, counters->num);
+                copy += counters->num;
+                room -= counters->num;
+                ++counters;
+            }
         }
-        // free(buffer);    //!< TODO: Replace with embedded allocation maybe
-        list_ptr = list_ptr->next;
     }
+    gcov_snapshot_head = head;
+    __atomic_store_n(&gcov_snapshot_status, GCOV_SNAPSHOT_READY, __ATOMIC_RELEASE);
 
-    gcov_output_buffer[gcov_output_index++] = 'G';
-    gcov_output_buffer[gcov_output_index++] = 'c';
-    gcov_output_buffer[gcov_output_index++] = 'o';
-    gcov_output_buffer[gcov_output_index++] = 'v';
-    gcov_output_buffer[gcov_output_index++] = ' ';
-    gcov_output_buffer[gcov_output_index++] = 'E';
-    gcov_output_buffer[gcov_output_index++] = 'n';
-    gcov_output_buffer[gcov_output_index++] = 'd';
-    gcov_output_buffer[gcov_output_index++] = '\0';
+    if(clock) {
+        const gcov_unsigned_t pause = clock() - start;
+        gcov_snapshot_last_pause = pause;
+        if(pause > gcov_snapshot_longest_pause)
+            gcov_snapshot_longest_pause = pause;
+    }
+    return 0;
+}
 
-    save_file("../output/gcov_output.bin", gcov_output_buffer, gcov_output_index);
-    free(gcov_gcda_buffer);
-    free(gcov_output_buffer);
-    return;
+bool gcov_snapshot_pending(void) {
+    return __atomic_load_n(&gcov_snapshot_status, __ATOMIC_ACQUIRE) != GCOV_SNAPSHOT_EMPTY;
+}
+
+gcov_unsigned_t gcov_snapshot_pause(void) {
+    return gcov_snapshot_last_pause;
+}
+
+gcov_unsigned_t gcov_snapshot_max_pause(void) {
+    return gcov_snapshot_longest_pause;
+}
+
+int gcov_add_filter(const struct gcov_filter* filter) {
+    if(!filter || (gcov_filter_count >= GCOV_MAX_FILTERS))
+        return -1;
+    const gcov_unsigned_t bit = 1U << gcov_filter_count;
+    if(filter->idents)
+        *(filter->include ? &gcov_include_functions : &gcov_exclude_functions) |= bit;
+    else
+        *(filter->include ? &gcov_include_files : &gcov_exclude_files) |= bit;
+    gcov_filter_hashes[gcov_filter_count] =
+        filter->pattern ? hash_gcov_string(filter->pattern) : 0U;
+    gcov_filters[gcov_filter_count++] = filter;
+    ++gcov_filter_epoch;
+    return 0;
+}
+
+void gcov_clear_filters(void) {
+    gcov_filter_count = 0U;
+    gcov_include_files = 0U;
+    gcov_exclude_files = 0U;
+    gcov_include_functions = 0U;
+    gcov_exclude_functions = 0U;
+    ++gcov_filter_epoch;
+}
+
+int gcov_begin_test(const gcov_unsigned_t test_id) {
+    if((test_id > GCOV_MAX_TEST_ID) || gcov_test_running
+       || (gcov_running_dump.phase != GCOV_PHASE_IDLE))
+        return -1;
+    __gcov_reset();
+    gcov_test_id = test_id;
+    gcov_test_running = true;
+    return 0;
+}
+
+int gcov_end_test(void) {
+    if(!gcov_test_running || (gcov_running_dump.phase != GCOV_PHASE_IDLE))
+        return GCOV_DUMP_FAILED;
+    gcov_test_running = false;
+
+    // delta and accumulated images would cover more than this test
+    const gcov_unsigned_t flags = gcov_image_flags;
+    gcov_image_flags =
+        (flags & ~(gcov_unsigned_t) (GCOV_IMAGE_DELTA | GCOV_IMAGE_ACCUMULATED)) | GCOV_IMAGE_TEST;
+    const int status = gcov_dump_step(SIZE_MAX);
+    gcov_image_flags = flags;
+    // the next test starts from zero, even if its image could not be written
+    __gcov_reset();
+    return status;
+}
+
+gcov_unsigned_t gcov_unregistered_files(void) {
+    const gcov_unsigned_t files = __atomic_load_n(&gcov_info_file_idx, __ATOMIC_RELAXED);
+    return files > GCOV_MAX_FILES ? files - GCOV_MAX_FILES : 0U;
 }
 
 void __gcov_merge_add(gcov_type* counters, gcov_unsigned_t n_counters) {
-    (void) counters;
-    (void) n_counters;
-    return;
+    if(!gcov_merge_source)
+        return;
+    for(gcov_unsigned_t counter_idx = 0U; counter_idx < n_counters; ++counter_idx)
+        counters[counter_idx] += take_gcov_counter(gcov_merge_source++);
 }
 
 void __gcov_merge_ior(gcov_type* counters, gcov_unsigned_t n_counters) {
-    (void) counters;
-    (void) n_counters;
-    return;
+    if(!gcov_merge_source)
+        return;
+    for(gcov_unsigned_t counter_idx = 0U; counter_idx < n_counters; ++counter_idx)
+        counters[counter_idx] |= take_gcov_counter(gcov_merge_source++);
+}
+
+void __gcov_merge_topn(gcov_type* counters, gcov_unsigned_t n_counters) {
+    if(!gcov_merge_source)
+        return;
+    for(gcov_unsigned_t counter_idx = 0U; (counter_idx + GCOV_TOPN_MEM_COUNTERS) <= n_counters;
+        counter_idx += GCOV_TOPN_MEM_COUNTERS) {
+        // the merged profiler holds the number of calls, the most common value and its count
+        gcov_type* merged = counters + counter_idx;
+        merged[0] += take_gcov_counter(gcov_merge_source);
+        (void) take_gcov_counter(gcov_merge_source + 1);
+        const struct gcov_kvp* list =
+            (const struct gcov_kvp*) (intptr_t) take_gcov_counter(gcov_merge_source + 2);
+        gcov_merge_source += GCOV_TOPN_MEM_COUNTERS;
+
+        gcov_unsigned_t pair_idx = 0U;
+        for(const struct gcov_kvp* pair = list; pair && (pair_idx < GCOV_TOPN_MAX_VALUES);
+            pair = next_gcov_kvp(pair), ++pair_idx) {
+            if(merged[2] && (pair->value == merged[1]))
+                merged[2] += pair->count;
+        }
+        // a value of the run replaces the merged one if it occurred more often
+        pair_idx = 0U;
+        for(const struct gcov_kvp* pair = list; pair && (pair_idx < GCOV_TOPN_MAX_VALUES);
+            pair = next_gcov_kvp(pair), ++pair_idx) {
+            if(pair->count > merged[2]) {
+                merged[1] = pair->value;
+                merged[2] = pair->count;
+            }
+        }
+    }
+}
+
+void __gcov_merge_time_profile(gcov_type* counters, gcov_unsigned_t n_counters) {
+    if(!gcov_merge_source)
+        return;
+    for(gcov_unsigned_t counter_idx = 0U; counter_idx < n_counters; ++counter_idx) {
+        // the earliest first call of all runs is kept
+        const gcov_type value = take_gcov_counter(gcov_merge_source++);
+        if(value && (!counters[counter_idx] || (value < counters[counter_idx])))
+            counters[counter_idx] = value;
+    }
 }
@@ -0,0 +1,56 @@
+/**********************************************************************/
+/** @addtogroup embedded_gcov
+ * @{
+ * @file
+ *
+ * @brief Conversion of counters into the words of the gcda format.
+ *
+ * In GCOV 64 bit numbers are stored as two 32 bit numbers in target byte order, the low part
+ * first. Both conversions are compiled on every target, so a host test can run the one of
+ * big-endian targets on a little-endian build. Included by gcov.c and the tests.
+ *
+ **********************************************************************/
+
+#ifndef LIB_GCOV_COUNTER_WORDS_H
+#define LIB_GCOV_COUNTER_WORDS_H
+
+/*! \brief Reads a counter value which may be updated concurrently
+ *
+ *  \param[in]  value   The counter to read
+ *  \return             The value of the counter
+ *
+ *  With GCOV_ATOMIC_COUNTERS the counter is read with an atomic load, so a 64 bit counter
+ *  which is incremented by another thread (-fprofile-update=atomic) is never read torn.
+ */
+static inline gcov_type load_gcov_counter(const gcov_type* value) {
+#ifdef GCOV_ATOMIC_COUNTERS
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+#else
+    return *value;
+#endif
+}
+
+/*! \brief Converts counters into gcda words counter by counter
+ *
+ *  \param[out] words           The destination, does not need to be aligned
+ *  \param[in]  values          The counters to convert
+ *  \param[in]  num             The number of counters
+ *  \param[in]  swap_halves     Set to swap the two halves of each counter
+ *
+ *  Each counter is stored in the byte order of the build. Big-endian targets swap the halves,
+ *  so the low part comes first, little-endian targets store the counters as they are. The loop
+ *  has no dependencies between iterations so the compiler can vectorize it.
+ */
+static inline void convert_gcov_counter_words(unsigned char* words,
+                                              const gcov_type* values,
+                                              const size_t num,
+                                              const bool swap_halves) {
+    for(size_t value_idx = 0U; value_idx < num; ++value_idx) {
+        uint64_t value = (uint64_t) load_gcov_counter(values + value_idx);
+        if(swap_halves)
+            value = (value << 32U) | (value >> 32U);
+        memcpy(words + (value_idx * sizeof(value)), &value, sizeof(value));
+    }
+}
+
+#endif
@@ -0,0 +1,379 @@
+/**********************************************************************/
+/** @addtogroup embedded_gcov
+ * @{
+ * @file
+ *
+ * @brief Tables of the slicing-by-8 CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320).
+ *
+ * Table 0 is the classic byte-wise table, table k holds the CRC of a byte followed by k zero
+ * bytes, so eight bytes are folded in with eight independent lookups. Only included by gcov.c.
+ *
+ **********************************************************************/
+
+#ifndef LIB_GCOV_CRC32_TABLE_H
+#define LIB_GCOV_CRC32_TABLE_H
+
+static const gcov_unsigned_t gcov_crc32_table[8][256] = {
+    {
+        0x0000'0000U, 0x7707'3096U, 0xEE0E'612CU, 0x9909'51BAU, 0x076D'C419U, 0x706A'F48FU,
+        0xE963'A535U, 0x9E64'95A3U, 0x0EDB'8832U, 0x79DC'B8A4U, 0xE0D5'E91EU, 0x97D2'D988U,
+        0x09B6'4C2BU, 0x7EB1'7CBDU, 0xE7B8'2D07U, 0x90BF'1D91U, 0x1DB7'1064U, 0x6AB0'20F2U,
+        0xF3B9'7148U, 0x84BE'41DEU, 0x1ADA'D47DU, 0x6DDD'E4EBU, 0xF4D4'B551U, 0x83D3'85C7U,
+        0x136C'9856U, 0x646B'A8C0U, 0xFD62'F97AU, 0x8A65'C9ECU, 0x1401'5C4FU, 0x6306'6CD9U,
+        0xFA0F'3D63U, 0x8D08'0DF5U, 0x3B6E'20C8U, 0x4C69'105EU, 0xD560'41E4U, 0xA267'7172U,
+        0x3C03'E4D1U, 0x4B04'D447U, 0xD20D'85FDU, 0xA50A'B56BU, 0x35B5'A8FAU, 0x42B2'986CU,
+        0xDBBB'C9D6U, 0xACBC'F940U, 0x32D8'6CE3U, 0x45DF'5C75U, 0xDCD6'0DCFU, 0xABD1'3D59U,
+        0x26D9'30ACU, 0x51DE'003AU, 0xC8D7'5180U, 0xBFD0'6116U, 0x21B4'F4B5U, 0x56B3'C423U,
+        0xCFBA'9599U, 0xB8BD'A50FU, 0x2802'B89EU, 0x5F05'8808U, 0xC60C'D9B2U, 0xB10B'E924U,
+        0x2F6F'7C87U, 0x5868'4C11U, 0xC161'1DABU, 0xB666'2D3DU, 0x76DC'4190U, 0x01DB'7106U,
+        0x98D2'20BCU, 0xEFD5'102AU, 0x71B1'8589U, 0x06B6'B51FU, 0x9FBF'E4A5U, 0xE8B8'D433U,
+        0x7807'C9A2U, 0x0F00'F934U, 0x9609'A88EU, 0xE10E'9818U, 0x7F6A'0DBBU, 0x086D'3D2DU,
+        0x9164'6C97U, 0xE663'5C01U, 0x6B6B'51F4U, 0x1C6C'6162U, 0x8565'30D8U, 0xF262'004EU,
+        0x6C06'95EDU, 0x1B01'A57BU, 0x8208'F4C1U, 0xF50F'C457U, 0x65B0'D9C6U, 0x12B7'E950U,
+        0x8BBE'B8EAU, 0xFCB9'887CU, 0x62DD'1DDFU, 0x15DA'2D49U, 0x8CD3'7CF3U, 0xFBD4'4C65U,
+        0x4DB2'6158U, 0x3AB5'51CEU, 0xA3BC'0074U, 0xD4BB'30E2U, 0x4ADF'A541U, 0x3DD8'95D7U,
+        0xA4D1'C46DU, 0xD3D6'F4FBU, 0x4369'E96AU, 0x346E'D9FCU, 0xAD67'8846U, 0xDA60'B8D0U,
+        0x4404'2D73U, 0x3303'1DE5U, 0xAA0A'4C5FU, 0xDD0D'7CC9U, 0x5005'713CU, 0x2702'41AAU,
+        0xBE0B'1010U, 0xC90C'2086U, 0x5768'B525U, 0x206F'85B3U, 0xB966'D409U, 0xCE61'E49FU,
+        0x5EDE'F90EU, 0x29D9'C998U, 0xB0D0'9822U, 0xC7D7'A8B4U, 0x59B3'3D17U, 0x2EB4'0D81U,
+        0xB7BD'5C3BU, 0xC0BA'6CADU, 0xEDB8'8320U, 0x9ABF'B3B6U, 0x03B6'E20CU, 0x74B1'D29AU,
+        0xEAD5'4739U, 0x9DD2'77AFU, 0x04DB'2615U, 0x73DC'1683U, 0xE363'0B12U, 0x9464'3B84U,
+        0x0D6D'6A3EU, 0x7A6A'5AA8U, 0xE40E'CF0BU, 0x9309'FF9DU, 0x0A00'AE27U, 0x7D07'9EB1U,
+        0xF00F'9344U, 0x8708'A3D2U, 0x1E01'F268U, 0x6906'C2FEU, 0xF762'575DU, 0x8065'67CBU,
+        0x196C'3671U, 0x6E6B'06E7U, 0xFED4'1B76U, 0x89D3'2BE0U, 0x10DA'7A5AU, 0x67DD'4ACCU,
+        0xF9B9'DF6FU, 0x8EBE'EFF9U, 0x17B7'BE43U, 0x60B0'8ED5U, 0xD6D6'A3E8U, 0xA1D1'937EU,
+        0x38D8'C2C4U, 0x4FDF'F252U, 0xD1BB'67F1U, 0xA6BC'5767U, 0x3FB5'06DDU, 0x48B2'364BU,
+        0xD80D'2BDAU, 0xAF0A'1B4CU, 0x3603'4AF6U, 0x4104'7A60U, 0xDF60'EFC3U, 0xA867'DF55U,
+        0x316E'8EEFU, 0x4669'BE79U, 0xCB61'B38CU, 0xBC66'831AU, 0x256F'D2A0U, 0x5268'E236U,
+        0xCC0C'7795U, 0xBB0B'4703U, 0x2202'16B9U, 0x5505'262FU, 0xC5BA'3BBEU, 0xB2BD'0B28U,
+        0x2BB4'5A92U, 0x5CB3'6A04U, 0xC2D7'FFA7U, 0xB5D0'CF31U, 0x2CD9'9E8BU, 0x5BDE'AE1DU,
+        0x9B64'C2B0U, 0xEC63'F226U, 0x756A'A39CU, 0x026D'930AU, 0x9C09'06A9U, 0xEB0E'363FU,
+        0x7207'6785U, 0x0500'5713U, 0x95BF'4A82U, 0xE2B8'7A14U, 0x7BB1'2BAEU, 0x0CB6'1B38U,
+        0x92D2'8E9BU, 0xE5D5'BE0DU, 0x7CDC'EFB7U, 0x0BDB'DF21U, 0x86D3'D2D4U, 0xF1D4'E242U,
+        0x68DD'B3F8U, 0x1FDA'836EU, 0x81BE'16CDU, 0xF6B9'265BU, 0x6FB0'77E1U, 0x18B7'4777U,
+        0x8808'5AE6U, 0xFF0F'6A70U, 0x6606'3BCAU, 0x1101'0B5CU, 0x8F65'9EFFU, 0xF862'AE69U,
+        0x616B'FFD3U, 0x166C'CF45U, 0xA00A'E278U, 0xD70D'D2EEU, 0x4E04'8354U, 0x3903'B3C2U,
+        0xA767'2661U, 0xD060'16F7U, 0x4969'474DU, 0x3E6E'77DBU, 0xAED1'6A4AU, 0xD9D6'5ADCU,
+        0x40DF'0B66U, 0x37D8'3BF0U, 0xA9BC'AE53U, 0xDEBB'9EC5U, 0x47B2'CF7FU, 0x30B5'FFE9U,
+        0xBDBD'F21CU, 0xCABA'C28AU, 0x53B3'9330U, 0x24B4'A3A6U, 0xBAD0'3605U, 0xCDD7'0693U,
+        0x54DE'5729U, 0x23D9'67BFU, 0xB366'7A2EU, 0xC461'4AB8U, 0x5D68'1B02U, 0x2A6F'2B94U,
+        0xB40B'BE37U, 0xC30C'8EA1U, 0x5A05'DF1BU, 0x2D02'EF8DU,
+    },
+    {
+        0x0000'0000U, 0x191B'3141U, 0x3236'6282U, 0x2B2D'53C3U, 0x646C'C504U, 0x7D77'F445U,
+        0x565A'A786U, 0x4F41'96C7U, 0xC8D9'8A08U, 0xD1C2'BB49U, 0xFAEF'E88AU, 0xE3F4'D9CBU,
+        0xACB5'4F0CU, 0xB5AE'7E4DU, 0x9E83'2D8EU, 0x8798'1CCFU, 0x4AC2'1251U, 0x53D9'2310U,
+        0x78F4'70D3U, 0x61EF'4192U, 0x2EAE'D755U, 0x37B5'E614U, 0x1C98'B5D7U, 0x0583'8496U,
+        0x821B'9859U, 0x9B00'A918U, 0xB02D'FADBU, 0xA936'CB9AU, 0xE677'5D5DU, 0xFF6C'6C1CU,
+        0xD441'3FDFU, 0xCD5A'0E9EU, 0x9584'24A2U, 0x8C9F'15E3U, 0xA7B2'4620U, 0xBEA9'7761U,
+        0xF1E8'E1A6U, 0xE8F3'D0E7U, 0xC3DE'8324U, 0xDAC5'B265U, 0x5D5D'AEAAU, 0x4446'9FEBU,
+        0x6F6B'CC28U, 0x7670'FD69U, 0x3931'6BAEU, 0x202A'5AEFU, 0x0B07'092CU, 0x121C'386DU,
+        0xDF46'36F3U, 0xC65D'07B2U, 0xED70'5471U, 0xF46B'6530U, 0xBB2A'F3F7U, 0xA231'C2B6U,
+        0x891C'9175U, 0x9007'A034U, 0x179F'BCFBU, 0x0E84'8DBAU, 0x25A9'DE79U, 0x3CB2'EF38U,
+        0x73F3'79FFU, 0x6AE8'48BEU, 0x41C5'1B7DU, 0x58DE'2A3CU, 0xF079'4F05U, 0xE962'7E44U,
+        0xC24F'2D87U, 0xDB54'1CC6U, 0x9415'8A01U, 0x8D0E'BB40U, 0xA623'E883U, 0xBF38'D9C2U,
+        0x38A0'C50DU, 0x21BB'F44CU, 0x0A96'A78FU, 0x138D'96CEU, 0x5CCC'0009U, 0x45D7'3148U,
+        0x6EFA'628BU, 0x77E1'53CAU, 0xBABB'5D54U, 0xA3A0'6C15U, 0x888D'3FD6U, 0x9196'0E97U,
+        0xDED7'9850U, 0xC7CC'A911U, 0xECE1'FAD2U, 0xF5FA'CB93U, 0x7262'D75CU, 0x6B79'E61DU,
+        0x4054'B5DEU, 0x594F'849FU, 0x160E'1258U, 0x0F15'2319U, 0x2438'70DAU, 0x3D23'419BU,
+        0x65FD'6BA7U, 0x7CE6'5AE6U, 0x57CB'0925U, 0x4ED0'3864U, 0x0191'AEA3U, 0x188A'9FE2U,
+        0x33A7'CC21U, 0x2ABC'FD60U, 0xAD24'E1AFU, 0xB43F'D0EEU, 0x9F12'832DU, 0x8609'B26CU,
+        0xC948'24ABU, 0xD053'15EAU, 0xFB7E'4629U, 0xE265'7768U, 0x2F3F'79F6U, 0x3624'48B7U,
+        0x1D09'1B74U, 0x0412'2A35U, 0x4B53'BCF2U, 0x5248'8DB3U, 0x7965'DE70U, 0x607E'EF31U,
+        0xE7E6'F3FEU, 0xFEFD'C2BFU, 0xD5D0'917CU, 0xCCCB'A03DU, 0x838A'36FAU, 0x9A91'07BBU,
+        0xB1BC'5478U, 0xA8A7'6539U, 0x3B83'984BU, 0x2298'A90AU, 0x09B5'FAC9U, 0x10AE'CB88U,
+        0x5FEF'5D4FU, 0x46F4'6C0EU, 0x6DD9'3FCDU, 0x74C2'0E8CU, 0xF35A'1243U, 0xEA41'2302U,
+        0xC16C'70C1U, 0xD877'4180U, 0x9736'D747U, 0x8E2D'E606U, 0xA500'B5C5U, 0xBC1B'8484U,
+        0x7141'8A1AU, 0x685A'BB5BU, 0x4377'E898U, 0x5A6C'D9D9U, 0x152D'4F1EU, 0x0C36'7E5FU,
+        0x271B'2D9CU, 0x3E00'1CDDU, 0xB998'0012U, 0xA083'3153U, 0x8BAE'6290U, 0x92B5'53D1U,
+        0xDDF4'C516U, 0xC4EF'F457U, 0xEFC2'A794U, 0xF6D9'96D5U, 0xAE07'BCE9U, 0xB71C'8DA8U,
+        0x9C31'DE6BU, 0x852A'EF2AU, 0xCA6B'79EDU, 0xD370'48ACU, 0xF85D'1B6FU, 0xE146'2A2EU,
+        0x66DE'36E1U, 0x7FC5'07A0U, 0x54E8'5463U, 0x4DF3'6522U, 0x02B2'F3E5U, 0x1BA9'C2A4U,
+        0x3084'9167U, 0x299F'A026U, 0xE4C5'AEB8U, 0xFDDE'9FF9U, 0xD6F3'CC3AU, 0xCFE8'FD7BU,
+        0x80A9'6BBCU, 0x99B2'5AFDU, 0xB29F'093EU, 0xAB84'387FU, 0x2C1C'24B0U, 0x3507'15F1U,
+        0x1E2A'4632U, 0x0731'7773U, 0x4870'E1B4U, 0x516B'D0F5U, 0x7A46'8336U, 0x635D'B277U,
+        0xCBFA'D74EU, 0xD2E1'E60FU, 0xF9CC'B5CCU, 0xE0D7'848DU, 0xAF96'124AU, 0xB68D'230BU,
+        0x9DA0'70C8U, 0x84BB'4189U, 0x0323'5D46U, 0x1A38'6C07U, 0x3115'3FC4U, 0x280E'0E85U,
+        0x674F'9842U, 0x7E54'A903U, 0x5579'FAC0U, 0x4C62'CB81U, 0x8138'C51FU, 0x9823'F45EU,
+        0xB30E'A79DU, 0xAA15'96DCU, 0xE554'001BU, 0xFC4F'315AU, 0xD762'6299U, 0xCE79'53D8U,
+        0x49E1'4F17U, 0x50FA'7E56U, 0x7BD7'2D95U, 0x62CC'1CD4U, 0x2D8D'8A13U, 0x3496'BB52U,
+        0x1FBB'E891U, 0x06A0'D9D0U, 0x5E7E'F3ECU, 0x4765'C2ADU, 0x6C48'916EU, 0x7553'A02FU,
+        0x3A12'36E8U, 0x2309'07A9U, 0x0824'546AU, 0x113F'652BU, 0x96A7'79E4U, 0x8FBC'48A5U,
+        0xA491'1B66U, 0xBD8A'2A27U, 0xF2CB'BCE0U, 0xEBD0'8DA1U, 0xC0FD'DE62U, 0xD9E6'EF23U,
+        0x14BC'E1BDU, 0x0DA7'D0FCU, 0x268A'833FU, 0x3F91'B27EU, 0x70D0'24B9U, 0x69CB'15F8U,
+        0x42E6'463BU, 0x5BFD'777AU, 0xDC65'6BB5U, 0xC57E'5AF4U, 0xEE53'0937U, 0xF748'3876U,
+        0xB809'AEB1U, 0xA112'9FF0U, 0x8A3F'CC33U, 0x9324'FD72U,
+    },
+    {
+        0x0000'0000U, 0x01C2'6A37U, 0x0384'D46EU, 0x0246'BE59U, 0x0709'A8DCU, 0x06CB'C2EBU,
+        0x048D'7CB2U, 0x054F'1685U, 0x0E13'51B8U, 0x0FD1'3B8FU, 0x0D97'85D6U, 0x0C55'EFE1U,
+        0x091A'F964U, 0x08D8'9353U, 0x0A9E'2D0AU, 0x0B5C'473DU, 0x1C26'A370U, 0x1DE4'C947U,
+        0x1FA2'771EU, 0x1E60'1D29U, 0x1B2F'0BACU, 0x1AED'619BU, 0x18AB'DFC2U, 0x1969'B5F5U,
+        0x1235'F2C8U, 0x13F7'98FFU, 0x11B1'26A6U, 0x1073'4C91U, 0x153C'5A14U, 0x14FE'3023U,
+        0x16B8'8E7AU, 0x177A'E44DU, 0x384D'46E0U, 0x398F'2CD7U, 0x3BC9'928EU, 0x3A0B'F8B9U,
+        0x3F44'EE3CU, 0x3E86'840BU, 0x3CC0'3A52U, 0x3D02'5065U, 0x365E'1758U, 0x379C'7D6FU,
+        0x35DA'C336U, 0x3418'A901U, 0x3157'BF84U, 0x3095'D5B3U, 0x32D3'6BEAU, 0x3311'01DDU,
+        0x246B'E590U, 0x25A9'8FA7U, 0x27EF'31FEU, 0x262D'5BC9U, 0x2362'4D4CU, 0x22A0'277BU,
+        0x20E6'9922U, 0x2124'F315U, 0x2A78'B428U, 0x2BBA'DE1FU, 0x29FC'6046U, 0x283E'0A71U,
+        0x2D71'1CF4U, 0x2CB3'76C3U, 0x2EF5'C89AU, 0x2F37'A2ADU, 0x709A'8DC0U, 0x7158'E7F7U,
+        0x731E'59AEU, 0x72DC'3399U, 0x7793'251CU, 0x7651'4F2BU, 0x7417'F172U, 0x75D5'9B45U,
+        0x7E89'DC78U, 0x7F4B'B64FU, 0x7D0D'0816U, 0x7CCF'6221U, 0x7980'74A4U, 0x7842'1E93U,
+        0x7A04'A0CAU, 0x7BC6'CAFDU, 0x6CBC'2EB0U, 0x6D7E'4487U, 0x6F38'FADEU, 0x6EFA'90E9U,
+        0x6BB5'866CU, 0x6A77'EC5BU, 0x6831'5202U, 0x69F3'3835U, 0x62AF'7F08U, 0x636D'153FU,
+        0x612B'AB66U, 0x60E9'C151U, 0x65A6'D7D4U, 0x6464'BDE3U, 0x6622'03BAU, 0x67E0'698DU,
+        0x48D7'CB20U, 0x4915'A117U, 0x4B53'1F4EU, 0x4A91'7579U, 0x4FDE'63FCU, 0x4E1C'09CBU,
+        0x4C5A'B792U, 0x4D98'DDA5U, 0x46C4'9A98U, 0x4706'F0AFU, 0x4540'4EF6U, 0x4482'24C1U,
+        0x41CD'3244U, 0x400F'5873U, 0x4249'E62AU, 0x438B'8C1DU, 0x54F1'6850U, 0x5533'0267U,
+        0x5775'BC3EU, 0x56B7'D609U, 0x53F8'C08CU, 0x523A'AABBU, 0x507C'14E2U, 0x51BE'7ED5U,
+        0x5AE2'39E8U, 0x5B20'53DFU, 0x5966'ED86U, 0x58A4'87B1U, 0x5DEB'9134U, 0x5C29'FB03U,
+        0x5E6F'455AU, 0x5FAD'2F6DU, 0xE135'1B80U, 0xE0F7'71B7U, 0xE2B1'CFEEU, 0xE373'A5D9U,
+        0xE63C'B35CU, 0xE7FE'D96BU, 0xE5B8'6732U, 0xE47A'0D05U, 0xEF26'4A38U, 0xEEE4'200FU,
+        0xECA2'9E56U, 0xED60'F461U, 0xE82F'E2E4U, 0xE9ED'88D3U, 0xEBAB'368AU, 0xEA69'5CBDU,
+        0xFD13'B8F0U, 0xFCD1'D2C7U, 0xFE97'6C9EU, 0xFF55'06A9U, 0xFA1A'102CU, 0xFBD8'7A1BU,
+        0xF99E'C442U, 0xF85C'AE75U, 0xF300'E948U, 0xF2C2'837FU, 0xF084'3D26U, 0xF146'5711U,
+        0xF409'4194U, 0xF5CB'2BA3U, 0xF78D'95FAU, 0xF64F'FFCDU, 0xD978'5D60U, 0xD8BA'3757U,
+        0xDAFC'890EU, 0xDB3E'E339U, 0xDE71'F5BCU, 0xDFB3'9F8BU, 0xDDF5'21D2U, 0xDC37'4BE5U,
+        0xD76B'0CD8U, 0xD6A9'66EFU, 0xD4EF'D8B6U, 0xD52D'B281U, 0xD062'A404U, 0xD1A0'CE33U,
+        0xD3E6'706AU, 0xD224'1A5DU, 0xC55E'FE10U, 0xC49C'9427U, 0xC6DA'2A7EU, 0xC718'4049U,
+        0xC257'56CCU, 0xC395'3CFBU, 0xC1D3'82A2U, 0xC011'E895U, 0xCB4D'AFA8U, 0xCA8F'C59FU,
+        0xC8C9'7BC6U, 0xC90B'11F1U, 0xCC44'0774U, 0xCD86'6D43U, 0xCFC0'D31AU, 0xCE02'B92DU,
+        0x91AF'9640U, 0x906D'FC77U, 0x922B'422EU, 0x93E9'2819U, 0x96A6'3E9CU, 0x9764'54ABU,
+        0x9522'EAF2U, 0x94E0'80C5U, 0x9FBC'C7F8U, 0x9E7E'ADCFU, 0x9C38'1396U, 0x9DFA'79A1U,
+        0x98B5'6F24U, 0x9977'0513U, 0x9B31'BB4AU, 0x9AF3'D17DU, 0x8D89'3530U, 0x8C4B'5F07U,
+        0x8E0D'E15EU, 0x8FCF'8B69U, 0x8A80'9DECU, 0x8B42'F7DBU, 0x8904'4982U, 0x88C6'23B5U,
+        0x839A'6488U, 0x8258'0EBFU, 0x801E'B0E6U, 0x81DC'DAD1U, 0x8493'CC54U, 0x8551'A663U,
+        0x8717'183AU, 0x86D5'720DU, 0xA9E2'D0A0U, 0xA820'BA97U, 0xAA66'04CEU, 0xABA4'6EF9U,
+        0xAEEB'787CU, 0xAF29'124BU, 0xAD6F'AC12U, 0xACAD'C625U, 0xA7F1'8118U, 0xA633'EB2FU,
+        0xA475'5576U, 0xA5B7'3F41U, 0xA0F8'29C4U, 0xA13A'43F3U, 0xA37C'FDAAU, 0xA2BE'979DU,
+        0xB5C4'73D0U, 0xB406'19E7U, 0xB640'A7BEU, 0xB782'CD89U, 0xB2CD'DB0CU, 0xB30F'B13BU,
+        0xB149'0F62U, 0xB08B'6555U, 0xBBD7'2268U, 0xBA15'485FU, 0xB853'F606U, 0xB991'9C31U,
+        0xBCDE'8AB4U, 0xBD1C'E083U, 0xBF5A'5EDAU, 0xBE98'34EDU,
+    },
+    {
+        0x0000'0000U, 0xB8BC'6765U, 0xAA09'C88BU, 0x12B5'AFEEU, 0x8F62'9757U, 0x37DE'F032U,
+        0x256B'5FDCU, 0x9DD7'38B9U, 0xC5B4'28EFU, 0x7D08'4F8AU, 0x6FBD'E064U, 0xD701'8701U,
+        0x4AD6'BFB8U, 0xF26A'D8DDU, 0xE0DF'7733U, 0x5863'1056U, 0x5019'579FU, 0xE8A5'30FAU,
+        0xFA10'9F14U, 0x42AC'F871U, 0xDF7B'C0C8U, 0x67C7'A7ADU, 0x7572'0843U, 0xCDCE'6F26U,
+        0x95AD'7F70U, 0x2D11'1815U, 0x3FA4'B7FBU, 0x8718'D09EU, 0x1ACF'E827U, 0xA273'8F42U,
+        0xB0C6'20ACU, 0x087A'47C9U, 0xA032'AF3EU, 0x188E'C85BU, 0x0A3B'67B5U, 0xB287'00D0U,
+        0x2F50'3869U, 0x97EC'5F0CU, 0x8559'F0E2U, 0x3DE5'9787U, 0x6586'87D1U, 0xDD3A'E0B4U,
+        0xCF8F'4F5AU, 0x7733'283FU, 0xEAE4'1086U, 0x5258'77E3U, 0x40ED'D80DU, 0xF851'BF68U,
+        0xF02B'F8A1U, 0x4897'9FC4U, 0x5A22'302AU, 0xE29E'574FU, 0x7F49'6FF6U, 0xC7F5'0893U,
+        0xD540'A77DU, 0x6DFC'C018U, 0x359F'D04EU, 0x8D23'B72BU, 0x9F96'18C5U, 0x272A'7FA0U,
+        0xBAFD'4719U, 0x0241'207CU, 0x10F4'8F92U, 0xA848'E8F7U, 0x9B14'583DU, 0x23A8'3F58U,
+        0x311D'90B6U, 0x89A1'F7D3U, 0x1476'CF6AU, 0xACCA'A80FU, 0xBE7F'07E1U, 0x06C3'6084U,
+        0x5EA0'70D2U, 0xE61C'17B7U, 0xF4A9'B859U, 0x4C15'DF3CU, 0xD1C2'E785U, 0x697E'80E0U,
+        0x7BCB'2F0EU, 0xC377'486BU, 0xCB0D'0FA2U, 0x73B1'68C7U, 0x6104'C729U, 0xD9B8'A04CU,
+        0x446F'98F5U, 0xFCD3'FF90U, 0xEE66'507EU, 0x56DA'371BU, 0x0EB9'274DU, 0xB605'4028U,
+        0xA4B0'EFC6U, 0x1C0C'88A3U, 0x81DB'B01AU, 0x3967'D77FU, 0x2BD2'7891U, 0x936E'1FF4U,
+        0x3B26'F703U, 0x839A'9066U, 0x912F'3F88U, 0x2993'58EDU, 0xB444'6054U, 0x0CF8'0731U,
+        0x1E4D'A8DFU, 0xA6F1'CFBAU, 0xFE92'DFECU, 0x462E'B889U, 0x549B'1767U, 0xEC27'7002U,
+        0x71F0'48BBU, 0xC94C'2FDEU, 0xDBF9'8030U, 0x6345'E755U, 0x6B3F'A09CU, 0xD383'C7F9U,
+        0xC136'6817U, 0x798A'0F72U, 0xE45D'37CBU, 0x5CE1'50AEU, 0x4E54'FF40U, 0xF6E8'9825U,
+        0xAE8B'8873U, 0x1637'EF16U, 0x0482'40F8U, 0xBC3E'279DU, 0x21E9'1F24U, 0x9955'7841U,
+        0x8BE0'D7AFU, 0x335C'B0CAU, 0xED59'B63BU, 0x55E5'D15EU, 0x4750'7EB0U, 0xFFEC'19D5U,
+        0x623B'216CU, 0xDA87'4609U, 0xC832'E9E7U, 0x708E'8E82U, 0x28ED'9ED4U, 0x9051'F9B1U,
+        0x82E4'565FU, 0x3A58'313AU, 0xA78F'0983U, 0x1F33'6EE6U, 0x0D86'C108U, 0xB53A'A66DU,
+        0xBD40'E1A4U, 0x05FC'86C1U, 0x1749'292FU, 0xAFF5'4E4AU, 0x3222'76F3U, 0x8A9E'1196U,
+        0x982B'BE78U, 0x2097'D91DU, 0x78F4'C94BU, 0xC048'AE2EU, 0xD2FD'01C0U, 0x6A41'66A5U,
+        0xF796'5E1CU, 0x4F2A'3979U, 0x5D9F'9697U, 0xE523'F1F2U, 0x4D6B'1905U, 0xF5D7'7E60U,
+        0xE762'D18EU, 0x5FDE'B6EBU, 0xC209'8E52U, 0x7AB5'E937U, 0x6800'46D9U, 0xD0BC'21BCU,
+        0x88DF'31EAU, 0x3063'568FU, 0x22D6'F961U, 0x9A6A'9E04U, 0x07BD'A6BDU, 0xBF01'C1D8U,
+        0xADB4'6E36U, 0x1508'0953U, 0x1D72'4E9AU, 0xA5CE'29FFU, 0xB77B'8611U, 0x0FC7'E174U,
+        0x9210'D9CDU, 0x2AAC'BEA8U, 0x3819'1146U, 0x80A5'7623U, 0xD8C6'6675U, 0x607A'0110U,
+        0x72CF'AEFEU, 0xCA73'C99BU, 0x57A4'F122U, 0xEF18'9647U, 0xFDAD'39A9U, 0x4511'5ECCU,
+        0x764D'EE06U, 0xCEF1'8963U, 0xDC44'268DU, 0x64F8'41E8U, 0xF92F'7951U, 0x4193'1E34U,
+        0x5326'B1DAU, 0xEB9A'D6BFU, 0xB3F9'C6E9U, 0x0B45'A18CU, 0x19F0'0E62U, 0xA14C'6907U,
+        0x3C9B'51BEU, 0x8427'36DBU, 0x9692'9935U, 0x2E2E'FE50U, 0x2654'B999U, 0x9EE8'DEFCU,
+        0x8C5D'7112U, 0x34E1'1677U, 0xA936'2ECEU, 0x118A'49ABU, 0x033F'E645U, 0xBB83'8120U,
+        0xE3E0'9176U, 0x5B5C'F613U, 0x49E9'59FDU, 0xF155'3E98U, 0x6C82'0621U, 0xD43E'6144U,
+        0xC68B'CEAAU, 0x7E37'A9CFU, 0xD67F'4138U, 0x6EC3'265DU, 0x7C76'89B3U, 0xC4CA'EED6U,
+        0x591D'D66FU, 0xE1A1'B10AU, 0xF314'1EE4U, 0x4BA8'7981U, 0x13CB'69D7U, 0xAB77'0EB2U,
+        0xB9C2'A15CU, 0x017E'C639U, 0x9CA9'FE80U, 0x2415'99E5U, 0x36A0'360BU, 0x8E1C'516EU,
+        0x8666'16A7U, 0x3EDA'71C2U, 0x2C6F'DE2CU, 0x94D3'B949U, 0x0904'81F0U, 0xB1B8'E695U,
+        0xA30D'497BU, 0x1BB1'2E1EU, 0x43D2'3E48U, 0xFB6E'592DU, 0xE9DB'F6C3U, 0x5167'91A6U,
+        0xCCB0'A91FU, 0x740C'CE7AU, 0x66B9'6194U, 0xDE05'06F1U,
+    },
+    {
+        0x0000'0000U, 0x3D60'29B0U, 0x7AC0'5360U, 0x47A0'7AD0U, 0xF580'A6C0U, 0xC8E0'8F70U,
+        0x8F40'F5A0U, 0xB220'DC10U, 0x3070'4BC1U, 0x0D10'6271U, 0x4AB0'18A1U, 0x77D0'3111U,
+        0xC5F0'ED01U, 0xF890'C4B1U, 0xBF30'BE61U, 0x8250'97D1U, 0x60E0'9782U, 0x5D80'BE32U,
+        0x1A20'C4E2U, 0x2740'ED52U, 0x9560'3142U, 0xA800'18F2U, 0xEFA0'6222U, 0xD2C0'4B92U,
+        0x5090'DC43U, 0x6DF0'F5F3U, 0x2A50'8F23U, 0x1730'A693U, 0xA510'7A83U, 0x9870'5333U,
+        0xDFD0'29E3U, 0xE2B0'0053U, 0xC1C1'2F04U, 0xFCA1'06B4U, 0xBB01'7C64U, 0x8661'55D4U,
+        0x3441'89C4U, 0x0921'A074U, 0x4E81'DAA4U, 0x73E1'F314U, 0xF1B1'64C5U, 0xCCD1'4D75U,
+        0x8B71'37A5U, 0xB611'1E15U, 0x0431'C205U, 0x3951'EBB5U, 0x7EF1'9165U, 0x4391'B8D5U,
+        0xA121'B886U, 0x9C41'9136U, 0xDBE1'EBE6U, 0xE681'C256U, 0x54A1'1E46U, 0x69C1'37F6U,
+        0x2E61'4D26U, 0x1301'6496U, 0x9151'F347U, 0xAC31'DAF7U, 0xEB91'A027U, 0xD6F1'8997U,
+        0x64D1'5587U, 0x59B1'7C37U, 0x1E11'06E7U, 0x2371'2F57U, 0x58F3'5849U, 0x6593'71F9U,
+        0x2233'0B29U, 0x1F53'2299U, 0xAD73'FE89U, 0x9013'D739U, 0xD7B3'ADE9U, 0xEAD3'8459U,
+        0x6883'1388U, 0x55E3'3A38U, 0x1243'40E8U, 0x2F23'6958U, 0x9D03'B548U, 0xA063'9CF8U,
+        0xE7C3'E628U, 0xDAA3'CF98U, 0x3813'CFCBU, 0x0573'E67BU, 0x42D3'9CABU, 0x7FB3'B51BU,
+        0xCD93'690BU, 0xF0F3'40BBU, 0xB753'3A6BU, 0x8A33'13DBU, 0x0863'840AU, 0x3503'ADBAU,
+        0x72A3'D76AU, 0x4FC3'FEDAU, 0xFDE3'22CAU, 0xC083'0B7AU, 0x8723'71AAU, 0xBA43'581AU,
+        0x9932'774DU, 0xA452'5EFDU, 0xE3F2'242DU, 0xDE92'0D9DU, 0x6CB2'D18DU, 0x51D2'F83DU,
+        0x1672'82EDU, 0x2B12'AB5DU, 0xA942'3C8CU, 0x9422'153CU, 0xD382'6FECU, 0xEEE2'465CU,
+        0x5CC2'9A4CU, 0x61A2'B3FCU, 0x2602'C92CU, 0x1B62'E09CU, 0xF9D2'E0CFU, 0xC4B2'C97FU,
+        0x8312'B3AFU, 0xBE72'9A1FU, 0x0C52'460FU, 0x3132'6FBFU, 0x7692'156FU, 0x4BF2'3CDFU,
+        0xC9A2'AB0EU, 0xF4C2'82BEU, 0xB362'F86EU, 0x8E02'D1DEU, 0x3C22'0DCEU, 0x0142'247EU,
+        0x46E2'5EAEU, 0x7B82'771EU, 0xB1E6'B092U, 0x8C86'9922U, 0xCB26'E3F2U, 0xF646'CA42U,
+        0x4466'1652U, 0x7906'3FE2U, 0x3EA6'4532U, 0x03C6'6C82U, 0x8196'FB53U, 0xBCF6'D2E3U,
+        0xFB56'A833U, 0xC636'8183U, 0x7416'5D93U, 0x4976'7423U, 0x0ED6'0EF3U, 0x33B6'2743U,
+        0xD106'2710U, 0xEC66'0EA0U, 0xABC6'7470U, 0x96A6'5DC0U, 0x2486'81D0U, 0x19E6'A860U,
+        0x5E46'D2B0U, 0x6326'FB00U, 0xE176'6CD1U, 0xDC16'4561U, 0x9BB6'3FB1U, 0xA6D6'1601U,
+        0x14F6'CA11U, 0x2996'E3A1U, 0x6E36'9971U, 0x5356'B0C1U, 0x7027'9F96U, 0x4D47'B626U,
+        0x0AE7'CCF6U, 0x3787'E546U, 0x85A7'3956U, 0xB8C7'10E6U, 0xFF67'6A36U, 0xC207'4386U,
+        0x4057'D457U, 0x7D37'FDE7U, 0x3A97'8737U, 0x07F7'AE87U, 0xB5D7'7297U, 0x88B7'5B27U,
+        0xCF17'21F7U, 0xF277'0847U, 0x10C7'0814U, 0x2DA7'21A4U, 0x6A07'5B74U, 0x5767'72C4U,
+        0xE547'AED4U, 0xD827'8764U, 0x9F87'FDB4U, 0xA2E7'D404U, 0x20B7'43D5U, 0x1DD7'6A65U,
+        0x5A77'10B5U, 0x6717'3905U, 0xD537'E515U, 0xE857'CCA5U, 0xAFF7'B675U, 0x9297'9FC5U,
+        0xE915'E8DBU, 0xD475'C16BU, 0x93D5'BBBBU, 0xAEB5'920BU, 0x1C95'4E1BU, 0x21F5'67ABU,
+        0x6655'1D7BU, 0x5B35'34CBU, 0xD965'A31AU, 0xE405'8AAAU, 0xA3A5'F07AU, 0x9EC5'D9CAU,
+        0x2CE5'05DAU, 0x1185'2C6AU, 0x5625'56BAU, 0x6B45'7F0AU, 0x89F5'7F59U, 0xB495'56E9U,
+        0xF335'2C39U, 0xCE55'0589U, 0x7C75'D999U, 0x4115'F029U, 0x06B5'8AF9U, 0x3BD5'A349U,
+        0xB985'3498U, 0x84E5'1D28U, 0xC345'67F8U, 0xFE25'4E48U, 0x4C05'9258U, 0x7165'BBE8U,
+        0x36C5'C138U, 0x0BA5'E888U, 0x28D4'C7DFU, 0x15B4'EE6FU, 0x5214'94BFU, 0x6F74'BD0FU,
+        0xDD54'611FU, 0xE034'48AFU, 0xA794'327FU, 0x9AF4'1BCFU, 0x18A4'8C1EU, 0x25C4'A5AEU,
+        0x6264'DF7EU, 0x5F04'F6CEU, 0xED24'2ADEU, 0xD044'036EU, 0x97E4'79BEU, 0xAA84'500EU,
+        0x4834'505DU, 0x7554'79EDU, 0x32F4'033DU, 0x0F94'2A8DU, 0xBDB4'F69DU, 0x80D4'DF2DU,
+        0xC774'A5FDU, 0xFA14'8C4DU, 0x7844'1B9CU, 0x4524'322CU, 0x0284'48FCU, 0x3FE4'614CU,
+        0x8DC4'BD5CU, 0xB0A4'94ECU, 0xF704'EE3CU, 0xCA64'C78CU,
+    },
+    {
+        0x0000'0000U, 0xCB5C'D3A5U, 0x4DC8'A10BU, 0x8694'72AEU, 0x9B91'4216U, 0x50CD'91B3U,
+        0xD659'E31DU, 0x1D05'30B8U, 0xEC53'826DU, 0x270F'51C8U, 0xA19B'2366U, 0x6AC7'F0C3U,
+        0x77C2'C07BU, 0xBC9E'13DEU, 0x3A0A'6170U, 0xF156'B2D5U, 0x03D6'029BU, 0xC88A'D13EU,
+        0x4E1E'A390U, 0x8542'7035U, 0x9847'408DU, 0x531B'9328U, 0xD58F'E186U, 0x1ED3'3223U,
+        0xEF85'80F6U, 0x24D9'5353U, 0xA24D'21FDU, 0x6911'F258U, 0x7414'C2E0U, 0xBF48'1145U,
+        0x39DC'63EBU, 0xF280'B04EU, 0x07AC'0536U, 0xCCF0'D693U, 0x4A64'A43DU, 0x8138'7798U,
+        0x9C3D'4720U, 0x5761'9485U, 0xD1F5'E62BU, 0x1AA9'358EU, 0xEBFF'875BU, 0x20A3'54FEU,
+        0xA637'2650U, 0x6D6B'F5F5U, 0x706E'C54DU, 0xBB32'16E8U, 0x3DA6'6446U, 0xF6FA'B7E3U,
+        0x047A'07ADU, 0xCF26'D408U, 0x49B2'A6A6U, 0x82EE'7503U, 0x9FEB'45BBU, 0x54B7'961EU,
+        0xD223'E4B0U, 0x197F'3715U, 0xE829'85C0U, 0x2375'5665U, 0xA5E1'24CBU, 0x6EBD'F76EU,
+        0x73B8'C7D6U, 0xB8E4'1473U, 0x3E70'66DDU, 0xF52C'B578U, 0x0F58'0A6CU, 0xC404'D9C9U,
+        0x4290'AB67U, 0x89CC'78C2U, 0x94C9'487AU, 0x5F95'9BDFU, 0xD901'E971U, 0x125D'3AD4U,
+        0xE30B'8801U, 0x2857'5BA4U, 0xAEC3'290AU, 0x659F'FAAFU, 0x789A'CA17U, 0xB3C6'19B2U,
+        0x3552'6B1CU, 0xFE0E'B8B9U, 0x0C8E'08F7U, 0xC7D2'DB52U, 0x4146'A9FCU, 0x8A1A'7A59U,
+        0x971F'4AE1U, 0x5C43'9944U, 0xDAD7'EBEAU, 0x118B'384FU, 0xE0DD'8A9AU, 0x2B81'593FU,
+        0xAD15'2B91U, 0x6649'F834U, 0x7B4C'C88CU, 0xB010'1B29U, 0x3684'6987U, 0xFDD8'BA22U,
+        0x08F4'0F5AU, 0xC3A8'DCFFU, 0x453C'AE51U, 0x8E60'7DF4U, 0x9365'4D4CU, 0x5839'9EE9U,
+        0xDEAD'EC47U, 0x15F1'3FE2U, 0xE4A7'8D37U, 0x2FFB'5E92U, 0xA96F'2C3CU, 0x6233'FF99U,
+        0x7F36'CF21U, 0xB46A'1C84U, 0x32FE'6E2AU, 0xF9A2'BD8FU, 0x0B22'0DC1U, 0xC07E'DE64U,
+        0x46EA'ACCAU, 0x8DB6'7F6FU, 0x90B3'4FD7U, 0x5BEF'9C72U, 0xDD7B'EEDCU, 0x1627'3D79U,
+        0xE771'8FACU, 0x2C2D'5C09U, 0xAAB9'2EA7U, 0x61E5'FD02U, 0x7CE0'CDBAU, 0xB7BC'1E1FU,
+        0x3128'6CB1U, 0xFA74'BF14U, 0x1EB0'14D8U, 0xD5EC'C77DU, 0x5378'B5D3U, 0x9824'6676U,
+        0x8521'56CEU, 0x4E7D'856BU, 0xC8E9'F7C5U, 0x03B5'2460U, 0xF2E3'96B5U, 0x39BF'4510U,
+        0xBF2B'37BEU, 0x7477'E41BU, 0x6972'D4A3U, 0xA22E'0706U, 0x24BA'75A8U, 0xEFE6'A60DU,
+        0x1D66'1643U, 0xD63A'C5E6U, 0x50AE'B748U, 0x9BF2'64EDU, 0x86F7'5455U, 0x4DAB'87F0U,
+        0xCB3F'F55EU, 0x0063'26FBU, 0xF135'942EU, 0x3A69'478BU, 0xBCFD'3525U, 0x77A1'E680U,
+        0x6AA4'D638U, 0xA1F8'059DU, 0x276C'7733U, 0xEC30'A496U, 0x191C'11EEU, 0xD240'C24BU,
+        0x54D4'B0E5U, 0x9F88'6340U, 0x828D'53F8U, 0x49D1'805DU, 0xCF45'F2F3U, 0x0419'2156U,
+        0xF54F'9383U, 0x3E13'4026U, 0xB887'3288U, 0x73DB'E12DU, 0x6EDE'D195U, 0xA582'0230U,
+        0x2316'709EU, 0xE84A'A33BU, 0x1ACA'1375U, 0xD196'C0D0U, 0x5702'B27EU, 0x9C5E'61DBU,
+        0x815B'5163U, 0x4A07'82C6U, 0xCC93'F068U, 0x07CF'23CDU, 0xF699'9118U, 0x3DC5'42BDU,
+        0xBB51'3013U, 0x700D'E3B6U, 0x6D08'D30EU, 0xA654'00ABU, 0x20C0'7205U, 0xEB9C'A1A0U,
+        0x11E8'1EB4U, 0xDAB4'CD11U, 0x5C20'BFBFU, 0x977C'6C1AU, 0x8A79'5CA2U, 0x4125'8F07U,
+        0xC7B1'FDA9U, 0x0CED'2E0CU, 0xFDBB'9CD9U, 0x36E7'4F7CU, 0xB073'3DD2U, 0x7B2F'EE77U,
+        0x662A'DECFU, 0xAD76'0D6AU, 0x2BE2'7FC4U, 0xE0BE'AC61U, 0x123E'1C2FU, 0xD962'CF8AU,
+        0x5FF6'BD24U, 0x94AA'6E81U, 0x89AF'5E39U, 0x42F3'8D9CU, 0xC467'FF32U, 0x0F3B'2C97U,
+        0xFE6D'9E42U, 0x3531'4DE7U, 0xB3A5'3F49U, 0x78F9'ECECU, 0x65FC'DC54U, 0xAEA0'0FF1U,
+        0x2834'7D5FU, 0xE368'AEFAU, 0x1644'1B82U, 0xDD18'C827U, 0x5B8C'BA89U, 0x90D0'692CU,
+        0x8DD5'5994U, 0x4689'8A31U, 0xC01D'F89FU, 0x0B41'2B3AU, 0xFA17'99EFU, 0x314B'4A4AU,
+        0xB7DF'38E4U, 0x7C83'EB41U, 0x6186'DBF9U, 0xAADA'085CU, 0x2C4E'7AF2U, 0xE712'A957U,
+        0x1592'1919U, 0xDECE'CABCU, 0x585A'B812U, 0x9306'6BB7U, 0x8E03'5B0FU, 0x455F'88AAU,
+        0xC3CB'FA04U, 0x0897'29A1U, 0xF9C1'9B74U, 0x329D'48D1U, 0xB409'3A7FU, 0x7F55'E9DAU,
+        0x6250'D962U, 0xA90C'0AC7U, 0x2F98'7869U, 0xE4C4'ABCCU,
+    },
+    {
+        0x0000'0000U, 0xA677'0BB4U, 0x979F'1129U, 0x31E8'1A9DU, 0xF44F'2413U, 0x5238'2FA7U,
+        0x63D0'353AU, 0xC5A7'3E8EU, 0x33EF'4E67U, 0x9598'45D3U, 0xA470'5F4EU, 0x0207'54FAU,
+        0xC7A0'6A74U, 0x61D7'61C0U, 0x503F'7B5DU, 0xF648'70E9U, 0x67DE'9CCEU, 0xC1A9'977AU,
+        0xF041'8DE7U, 0x5636'8653U, 0x9391'B8DDU, 0x35E6'B369U, 0x040E'A9F4U, 0xA279'A240U,
+        0x5431'D2A9U, 0xF246'D91DU, 0xC3AE'C380U, 0x65D9'C834U, 0xA07E'F6BAU, 0x0609'FD0EU,
+        0x37E1'E793U, 0x9196'EC27U, 0xCFBD'399CU, 0x69CA'3228U, 0x5822'28B5U, 0xFE55'2301U,
+        0x3BF2'1D8FU, 0x9D85'163BU, 0xAC6D'0CA6U, 0x0A1A'0712U, 0xFC52'77FBU, 0x5A25'7C4FU,
+        0x6BCD'66D2U, 0xCDBA'6D66U, 0x081D'53E8U, 0xAE6A'585CU, 0x9F82'42C1U, 0x39F5'4975U,
+        0xA863'A552U, 0x0E14'AEE6U, 0x3FFC'B47BU, 0x998B'BFCFU, 0x5C2C'8141U, 0xFA5B'8AF5U,
+        0xCBB3'9068U, 0x6DC4'9BDCU, 0x9B8C'EB35U, 0x3DFB'E081U, 0x0C13'FA1CU, 0xAA64'F1A8U,
+        0x6FC3'CF26U, 0xC9B4'C492U, 0xF85C'DE0FU, 0x5E2B'D5BBU, 0x440B'7579U, 0xE27C'7ECDU,
+        0xD394'6450U, 0x75E3'6FE4U, 0xB044'516AU, 0x1633'5ADEU, 0x27DB'4043U, 0x81AC'4BF7U,
+        0x77E4'3B1EU, 0xD193'30AAU, 0xE07B'2A37U, 0x460C'2183U, 0x83AB'1F0DU, 0x25DC'14B9U,
+        0x1434'0E24U, 0xB243'0590U, 0x23D5'E9B7U, 0x85A2'E203U, 0xB44A'F89EU, 0x123D'F32AU,
+        0xD79A'CDA4U, 0x71ED'C610U, 0x4005'DC8DU, 0xE672'D739U, 0x103A'A7D0U, 0xB64D'AC64U,
+        0x87A5'B6F9U, 0x21D2'BD4DU, 0xE475'83C3U, 0x4202'8877U, 0x73EA'92EAU, 0xD59D'995EU,
+        0x8BB6'4CE5U, 0x2DC1'4751U, 0x1C29'5DCCU, 0xBA5E'5678U, 0x7FF9'68F6U, 0xD98E'6342U,
+        0xE866'79DFU, 0x4E11'726BU, 0xB859'0282U, 0x1E2E'0936U, 0x2FC6'13ABU, 0x89B1'181FU,
+        0x4C16'2691U, 0xEA61'2D25U, 0xDB89'37B8U, 0x7DFE'3C0CU, 0xEC68'D02BU, 0x4A1F'DB9FU,
+        0x7BF7'C102U, 0xDD80'CAB6U, 0x1827'F438U, 0xBE50'FF8CU, 0x8FB8'E511U, 0x29CF'EEA5U,
+        0xDF87'9E4CU, 0x79F0'95F8U, 0x4818'8F65U, 0xEE6F'84D1U, 0x2BC8'BA5FU, 0x8DBF'B1EBU,
+        0xBC57'AB76U, 0x1A20'A0C2U, 0x8816'EAF2U, 0x2E61'E146U, 0x1F89'FBDBU, 0xB9FE'F06FU,
+        0x7C59'CEE1U, 0xDA2E'C555U, 0xEBC6'DFC8U, 0x4DB1'D47CU, 0xBBF9'A495U, 0x1D8E'AF21U,
+        0x2C66'B5BCU, 0x8A11'BE08U, 0x4FB6'8086U, 0xE9C1'8B32U, 0xD829'91AFU, 0x7E5E'9A1BU,
+        0xEFC8'763CU, 0x49BF'7D88U, 0x7857'6715U, 0xDE20'6CA1U, 0x1B87'522FU, 0xBDF0'599BU,
+        0x8C18'4306U, 0x2A6F'48B2U, 0xDC27'385BU, 0x7A50'33EFU, 0x4BB8'2972U, 0xEDCF'22C6U,
+        0x2868'1C48U, 0x8E1F'17FCU, 0xBFF7'0D61U, 0x1980'06D5U, 0x47AB'D36EU, 0xE1DC'D8DAU,
+        0xD034'C247U, 0x7643'C9F3U, 0xB3E4'F77DU, 0x1593'FCC9U, 0x247B'E654U, 0x820C'EDE0U,
+        0x7444'9D09U, 0xD233'96BDU, 0xE3DB'8C20U, 0x45AC'8794U, 0x800B'B91AU, 0x267C'B2AEU,
+        0x1794'A833U, 0xB1E3'A387U, 0x2075'4FA0U, 0x8602'4414U, 0xB7EA'5E89U, 0x119D'553DU,
+        0xD43A'6BB3U, 0x724D'6007U, 0x43A5'7A9AU, 0xE5D2'712EU, 0x139A'01C7U, 0xB5ED'0A73U,
+        0x8405'10EEU, 0x2272'1B5AU, 0xE7D5'25D4U, 0x41A2'2E60U, 0x704A'34FDU, 0xD63D'3F49U,
+        0xCC1D'9F8BU, 0x6A6A'943FU, 0x5B82'8EA2U, 0xFDF5'8516U, 0x3852'BB98U, 0x9E25'B02CU,
+        0xAFCD'AAB1U, 0x09BA'A105U, 0xFFF2'D1ECU, 0x5985'DA58U, 0x686D'C0C5U, 0xCE1A'CB71U,
+        0x0BBD'F5FFU, 0xADCA'FE4BU, 0x9C22'E4D6U, 0x3A55'EF62U, 0xABC3'0345U, 0x0DB4'08F1U,
+        0x3C5C'126CU, 0x9A2B'19D8U, 0x5F8C'2756U, 0xF9FB'2CE2U, 0xC813'367FU, 0x6E64'3DCBU,
+        0x982C'4D22U, 0x3E5B'4696U, 0x0FB3'5C0BU, 0xA9C4'57BFU, 0x6C63'6931U, 0xCA14'6285U,
+        0xFBFC'7818U, 0x5D8B'73ACU, 0x03A0'A617U, 0xA5D7'ADA3U, 0x943F'B73EU, 0x3248'BC8AU,
+        0xF7EF'8204U, 0x5198'89B0U, 0x6070'932DU, 0xC607'9899U, 0x304F'E870U, 0x9638'E3C4U,
+        0xA7D0'F959U, 0x01A7'F2EDU, 0xC400'CC63U, 0x6277'C7D7U, 0x539F'DD4AU, 0xF5E8'D6FEU,
+        0x647E'3AD9U, 0xC209'316DU, 0xF3E1'2BF0U, 0x5596'2044U, 0x9031'1ECAU, 0x3646'157EU,
+        0x07AE'0FE3U, 0xA1D9'0457U, 0x5791'74BEU, 0xF1E6'7F0AU, 0xC00E'6597U, 0x6679'6E23U,
+        0xA3DE'50ADU, 0x05A9'5B19U, 0x3441'4184U, 0x9236'4A30U,
+    },
+    {
+        0x0000'0000U, 0xCCAA'009EU, 0x4225'077DU, 0x8E8F'07E3U, 0x844A'0EFAU, 0x48E0'0E64U,
+        0xC66F'0987U, 0x0AC5'0919U, 0xD3E5'1BB5U, 0x1F4F'1B2BU, 0x91C0'1CC8U, 0x5D6A'1C56U,
+        0x57AF'154FU, 0x9B05'15D1U, 0x158A'1232U, 0xD920'12ACU, 0x7CBB'312BU, 0xB011'31B5U,
+        0x3E9E'3656U, 0xF234'36C8U, 0xF8F1'3FD1U, 0x345B'3F4FU, 0xBAD4'38ACU, 0x767E'3832U,
+        0xAF5E'2A9EU, 0x63F4'2A00U, 0xED7B'2DE3U, 0x21D1'2D7DU, 0x2B14'2464U, 0xE7BE'24FAU,
+        0x6931'2319U, 0xA59B'2387U, 0xF976'6256U, 0x35DC'62C8U, 0xBB53'652BU, 0x77F9'65B5U,
+        0x7D3C'6CACU, 0xB196'6C32U, 0x3F19'6BD1U, 0xF3B3'6B4FU, 0x2A93'79E3U, 0xE639'797DU,
+        0x68B6'7E9EU, 0xA41C'7E00U, 0xAED9'7719U, 0x6273'7787U, 0xECFC'7064U, 0x2056'70FAU,
+        0x85CD'537DU, 0x4967'53E3U, 0xC7E8'5400U, 0x0B42'549EU, 0x0187'5D87U, 0xCD2D'5D19U,
+        0x43A2'5AFAU, 0x8F08'5A64U, 0x5628'48C8U, 0x9A82'4856U, 0x140D'4FB5U, 0xD8A7'4F2BU,
+        0xD262'4632U, 0x1EC8'46ACU, 0x9047'414FU, 0x5CED'41D1U, 0x299D'C2EDU, 0xE537'C273U,
+        0x6BB8'C590U, 0xA712'C50EU, 0xADD7'CC17U, 0x617D'CC89U, 0xEFF2'CB6AU, 0x2358'CBF4U,
+        0xFA78'D958U, 0x36D2'D9C6U, 0xB85D'DE25U, 0x74F7'DEBBU, 0x7E32'D7A2U, 0xB298'D73CU,
+        0x3C17'D0DFU, 0xF0BD'D041U, 0x5526'F3C6U, 0x998C'F358U, 0x1703'F4BBU, 0xDBA9'F425U,
+        0xD16C'FD3CU, 0x1DC6'FDA2U, 0x9349'FA41U, 0x5FE3'FADFU, 0x86C3'E873U, 0x4A69'E8EDU,
+        0xC4E6'EF0EU, 0x084C'EF90U, 0x0289'E689U, 0xCE23'E617U, 0x40AC'E1F4U, 0x8C06'E16AU,
+        0xD0EB'A0BBU, 0x1C41'A025U, 0x92CE'A7C6U, 0x5E64'A758U, 0x54A1'AE41U, 0x980B'AEDFU,
+        0x1684'A93CU, 0xDA2E'A9A2U, 0x030E'BB0EU, 0xCFA4'BB90U, 0x412B'BC73U, 0x8D81'BCEDU,
+        0x8744'B5F4U, 0x4BEE'B56AU, 0xC561'B289U, 0x09CB'B217U, 0xAC50'9190U, 0x60FA'910EU,
+        0xEE75'96EDU, 0x22DF'9673U, 0x281A'9F6AU, 0xE4B0'9FF4U, 0x6A3F'9817U, 0xA695'9889U,
+        0x7FB5'8A25U, 0xB31F'8ABBU, 0x3D90'8D58U, 0xF13A'8DC6U, 0xFBFF'84DFU, 0x3755'8441U,
+        0xB9DA'83A2U, 0x7570'833CU, 0x533B'85DAU, 0x9F91'8544U, 0x111E'82A7U, 0xDDB4'8239U,
+        0xD771'8B20U, 0x1BDB'8BBEU, 0x9554'8C5DU, 0x59FE'8CC3U, 0x80DE'9E6FU, 0x4C74'9EF1U,
+        0xC2FB'9912U, 0x0E51'998CU, 0x0494'9095U, 0xC83E'900BU, 0x46B1'97E8U, 0x8A1B'9776U,
+        0x2F80'B4F1U, 0xE32A'B46FU, 0x6DA5'B38CU, 0xA10F'B312U, 0xABCA'BA0BU, 0x6760'BA95U,
+        0xE9EF'BD76U, 0x2545'BDE8U, 0xFC65'AF44U, 0x30CF'AFDAU, 0xBE40'A839U, 0x72EA'A8A7U,
+        0x782F'A1BEU, 0xB485'A120U, 0x3A0A'A6C3U, 0xF6A0'A65DU, 0xAA4D'E78CU, 0x66E7'E712U,
+        0xE868'E0F1U, 0x24C2'E06FU, 0x2E07'E976U, 0xE2AD'E9E8U, 0x6C22'EE0BU, 0xA088'EE95U,
+        0x79A8'FC39U, 0xB502'FCA7U, 0x3B8D'FB44U, 0xF727'FBDAU, 0xFDE2'F2C3U, 0x3148'F25DU,
+        0xBFC7'F5BEU, 0x736D'F520U, 0xD6F6'D6A7U, 0x1A5C'D639U, 0x94D3'D1DAU, 0x5879'D144U,
+        0x52BC'D85DU, 0x9E16'D8C3U, 0x1099'DF20U, 0xDC33'DFBEU, 0x0513'CD12U, 0xC9B9'CD8CU,
+        0x4736'CA6FU, 0x8B9C'CAF1U, 0x8159'C3E8U, 0x4DF3'C376U, 0xC37C'C495U, 0x0FD6'C40BU,
+        0x7AA6'4737U, 0xB60C'47A9U, 0x3883'404AU, 0xF429'40D4U, 0xFEEC'49CDU, 0x3246'4953U,
+        0xBCC9'4EB0U, 0x7063'4E2EU, 0xA943'5C82U, 0x65E9'5C1CU, 0xEB66'5BFFU, 0x27CC'5B61U,
+        0x2D09'5278U, 0xE1A3'52E6U, 0x6F2C'5505U, 0xA386'559BU, 0x061D'761CU, 0xCAB7'7682U,
+        0x4438'7161U, 0x8892'71FFU, 0x8257'78E6U, 0x4EFD'7878U, 0xC072'7F9BU, 0x0CD8'7F05U,
+        0xD5F8'6DA9U, 0x1952'6D37U, 0x97DD'6AD4U, 0x5B77'6A4AU, 0x51B2'6353U, 0x9D18'63CDU,
+        0x1397'642EU, 0xDF3D'64B0U, 0x83D0'2561U, 0x4F7A'25FFU, 0xC1F5'221CU, 0x0D5F'2282U,
+        0x079A'2B9BU, 0xCB30'2B05U, 0x45BF'2CE6U, 0x8915'2C78U, 0x5035'3ED4U, 0x9C9F'3E4AU,
+        0x1210'39A9U, 0xDEBA'3937U, 0xD47F'302EU, 0x18D5'30B0U, 0x965A'3753U, 0x5AF0'37CDU,
+        0xFF6B'144AU, 0x33C1'14D4U, 0xBD4E'1337U, 0x71E4'13A9U, 0x7B21'1AB0U, 0xB78B'1A2EU,
+        0x3904'1DCDU, 0xF5AE'1D53U, 0x2C8E'0FFFU, 0xE024'0F61U, 0x6EAB'0882U, 0xA201'081CU,
+        0xA8C4'0105U, 0x646E'019BU, 0xEAE1'0678U, 0x264B'06E6U,
+    },
+};
+
+#endif
@@ -0,0 +1,80 @@
+/**********************************************************************/
+/** @addtogroup embedded_gcov
+ * @{
+ * @file
+ *
+ * @brief Sink writing the coverage image to a file on the host.
+ *
+ **********************************************************************/
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <unistd.h>
+
+#include "gcov/gcov_file_sink.h"
+
+#include <sys/stat.h>
+
+/*! \brief Creates or truncates the output file
+ *
+ *  \param[in]  context The file sink context
+ *  \return             0 on success, -1 if the file could not be opened
+ */
+static int gcov_file_sink_begin(void* context) {
+    struct gcov_file_sink_context* file = (struct gcov_file_sink_context*) context;
+    file->failed = false;
+    file->fd = open(file->path, (O_CREAT | O_WRONLY | O_TRUNC), (S_IRWXU | S_IRWXG | S_IRWXO));
+    if(file->fd < 0) {
+        file->failed = true;
+        return -1;
+    }
+    return 0;
+}
+
+/*! \brief Appends a chunk to the output file
+ *
+ *  \param[in]  context The file sink context
+ *  \param[in]  data    The bytes to append
+ *  \param[in]  size    The number of bytes to append
+ *  \return             0 on success, -1 if the chunk could not be written completely
+ */
+static int gcov_file_sink_write(void* context, const unsigned char* data, size_t size) {
+    struct gcov_file_sink_context* file = (struct gcov_file_sink_context*) context;
+    while(size) {
+        const ssize_t written = write(file->fd, data, size);
+        if(written <= 0) {
+            file->failed = true;
+            return -1;
+        }
+        data += written;
+        size -= (size_t) written;
+    }
+    return 0;
+}
+
+/*! \brief Closes the output file
+ *
+ *  \param[in]  context The file sink context
+ *  \return             0 on success, -1 if the file could not be closed
+ */
+static int gcov_file_sink_end(void* context) {
+    struct gcov_file_sink_context* file = (struct gcov_file_sink_context*) context;
+    const int result = close(file->fd);
+    file->fd = -1;
+    if(result != 0)
+        file->failed = true;
+    return result;
+}
+
+void gcov_file_sink_init(struct gcov_sink* sink,
+                         struct gcov_file_sink_context* context,
+                         const char* path) {
+    context->path = path;
+    context->fd = -1;
+    context->failed = false;
+
+    sink->begin = gcov_file_sink_begin;
+    sink->write = gcov_file_sink_write;
+    sink->end = gcov_file_sink_end;
+    sink->context = context;
+}
@@ -0,0 +1,262 @@
+/**********************************************************************/
+/** @addtogroup embedded_gcov
+ * @{
+ * @file
+ *
+ * @brief Value profilers called by the code of -fprofile-generate builds.
+ *
+ * Compare to libgcc/libgcov-profiler.c of the compiler. The module is only linked if the
+ * instrumented code references the profilers, so coverage builds do not carry the pool of
+ * topn pairs.
+ *
+ **********************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gcov/gcov.h"
+#include "gcov/gcov_info.h"
+
+GCOV_THREAD_LOCAL struct gcov_indirect_call_tuple __gcov_indirect_call;
+
+gcov_type __gcov_time_profiler_counter = 0;
+
+//! The value/count pairs of all topn profilers
+static struct gcov_kvp gcov_topn_pool[GCOV_MAX_TOPN_VALUES];
+//! The number of pairs taken from the pool, may exceed its size
+static gcov_unsigned_t gcov_topn_pool_used = 0U;
+//! The number of values which found no free pair since the pairs were released
+static gcov_unsigned_t gcov_topn_lost = 0U;
+
+/*! \brief Adds to a counter
+ *
+ *  \param[in,out]  counter     The counter
+ *  \param[in]      value       The value to add
+ *  \param[in]      use_atomic  Set for the profilers of -fprofile-update=atomic builds
+ */
+static inline void add_gcov_counter(gcov_type* counter,
+                                    const gcov_type value,
+                                    const bool use_atomic) {
+    if(use_atomic)
+        __atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+    else
+        *counter += value;
+}
+
+/*! \brief Takes a pair from the pool
+ *
+ *  \param[in]  use_atomic  Set for the profilers of -fprofile-update=atomic builds
+ *  \return                 The unlinked pair, NULL if all pairs are taken
+ */
+static struct gcov_kvp* allocate_gcov_kvp(const bool use_atomic) {
+    // the pool is checked first, so the number of taken pairs never wraps around
+    gcov_unsigned_t pair_idx = __atomic_load_n(&gcov_topn_pool_used, __ATOMIC_RELAXED);
+    if(pair_idx < GCOV_MAX_TOPN_VALUES) {
+        if(use_atomic)
+            pair_idx = __atomic_fetch_add(&gcov_topn_pool_used, 1U, __ATOMIC_RELAXED);
+        else
+            ++gcov_topn_pool_used;
+    }
+    if(pair_idx >= GCOV_MAX_TOPN_VALUES) {
+        __atomic_fetch_add(&gcov_topn_lost, 1U, __ATOMIC_RELAXED);
+        return NULL;
+    }
+    struct gcov_kvp* pair = gcov_topn_pool + pair_idx;
+    pair->next = NULL;
+    return pair;
+}
+
+/*! \brief Counts a value of a topn profiler
+ *
+ *  \param[in,out]  counters    The GCOV_TOPN_MEM_COUNTERS counters of the profiler
+ *  \param[in]      value       The value to count
+ *  \param[in]      use_atomic  Set for the profilers of -fprofile-update=atomic builds
+ *
+ *  Values which are tracked already are counted in their pair, new values are appended to the
+ *  list. Once GCOV_TOPN_MAX_VALUES values are tracked, a new value decrements the count of
+ *  the least common one and replaces it when the count dropped to zero, like libgcov does.
+ */
+static inline void add_gcov_topn_value(gcov_type* counters,
+                                       const gcov_type value,
+                                       const bool use_atomic) {
+    add_gcov_counter(counters, 1, use_atomic);
+
+    struct gcov_kvp* last = NULL;
+    struct gcov_kvp* minimal = NULL;
+    for(struct gcov_kvp* pair = (struct gcov_kvp*) (intptr_t) counters[2]; pair;
+        pair = pair->next) {
+        if(pair->value == value) {
+            add_gcov_counter(&pair->count, 1, use_atomic);
+            return;
+        }
+        if(!minimal || (pair->count < minimal->count))
+            minimal = pair;
+        last = pair;
+    }
+
+    if(minimal && (counters[1] >= GCOV_TOPN_MAX_VALUES)) {
+        if(--minimal->count < 1) {
+            minimal->value = value;
+            minimal->count = 1;
+        }
+        return;
+    }
+
+    struct gcov_kvp* pair = allocate_gcov_kvp(use_atomic);
+    if(!pair)
+        return;
+    pair->value = value;
+    pair->count = 1;
+    // a concurrently appended pair wins, the pair taken here is lost
+    bool linked = true;
+    if(!use_atomic) {
+        if(last)
+            last->next = pair;
+        else
+            counters[2] = (gcov_type) (intptr_t) pair;
+    } else if(last) {
+        struct gcov_kvp* expected = NULL;
+        linked = __atomic_compare_exchange_n(
+            &last->next, &expected, pair, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+    } else {
+        gcov_type expected = 0;
+        linked = __atomic_compare_exchange_n(
+            counters + 2, &expected, (gcov_type) (intptr_t) pair, false, __ATOMIC_RELEASE,
+            __ATOMIC_RELAXED);
+    }
+    if(linked)
+        add_gcov_counter(counters + 1, 1, use_atomic);
+}
+
+/*! \brief Counts a value in the interval counters of a profiler
+ *
+ *  The counters hold one counter per value of the interval starting at \a start, followed by
+ *  one for larger and one for smaller values.
+ */
+static inline void profile_gcov_interval(gcov_type* counters,
+                                         const gcov_type value,
+                                         const int start,
+                                         const unsigned steps,
+                                         const bool use_atomic) {
+    const gcov_type delta = value - start;
+    if(delta < 0)
+        add_gcov_counter(counters + steps + 1U, 1, use_atomic);
+    else if(delta >= steps)
+        add_gcov_counter(counters + steps, 1, use_atomic);
+    else
+        add_gcov_counter(counters + delta, 1, use_atomic);
+}
+
+/*! \brief Counts whether a value is a power of two in the second or else in the first counter
+ */
+static inline void profile_gcov_pow2(gcov_type* counters,
+                                     const gcov_type value,
+                                     const bool use_atomic) {
+    if(!value || (value & (value - 1)))
+        add_gcov_counter(counters, 1, use_atomic);
+    else
+        add_gcov_counter(counters + 1, 1, use_atomic);
+}
+
+/*! \brief Counts the callee of an indirect call in the topn counters of the call site
+ *
+ *  The caller stored the callee and the counters of the call site in __gcov_indirect_call
+ *  before the call, the profiler runs at the entry of each function which may be called
+ *  indirectly and only counts if it is the expected callee.
+ */
+static inline void profile_gcov_indirect_call(const gcov_type value,
+                                              void* cur_func,
+                                              const bool use_atomic) {
+    if(cur_func == __gcov_indirect_call.callee)
+        add_gcov_topn_value(__gcov_indirect_call.counters, value, use_atomic);
+    __gcov_indirect_call.callee = NULL;
+}
+
+/*! \brief Sums up the values and counts them for their average
+ */
+static inline void profile_gcov_average(gcov_type* counters,
+                                        const gcov_type value,
+                                        const bool use_atomic) {
+    add_gcov_counter(counters, value, use_atomic);
+    add_gcov_counter(counters + 1, 1, use_atomic);
+}
+
+/*! \brief ORs the values, e.g. the addresses of memory operations to find their alignment
+ */
+static inline void profile_gcov_ior(gcov_type* counters,
+                                    const gcov_type value,
+                                    const bool use_atomic) {
+    if(use_atomic)
+        __atomic_fetch_or(counters, value, __ATOMIC_RELAXED);
+    else
+        *counters |= value;
+}
+
+/*! \brief Releases all topn pairs, called once the lists of all profilers were cleared
+ *
+ *  Referenced weakly by __gcov_reset() and gcov_accumulate(), so coverage builds which do not
+ *  link this module skip it.
+ */
+void release_gcov_topn_values(void) {
+    __atomic_store_n(&gcov_topn_pool_used, 0U, __ATOMIC_RELAXED);
+    __atomic_store_n(&gcov_topn_lost, 0U, __ATOMIC_RELAXED);
+}
+
+gcov_unsigned_t gcov_lost_topn_values(void) {
+    return __atomic_load_n(&gcov_topn_lost, __ATOMIC_RELAXED);
+}
+
+void __gcov_interval_profiler(gcov_type* counters,
+                              const gcov_type value,
+                              const int start,
+                              const unsigned steps) {
+    profile_gcov_interval(counters, value, start, steps, false);
+}
+
+void __gcov_interval_profiler_atomic(gcov_type* counters,
+                                     const gcov_type value,
+                                     const int start,
+                                     const unsigned steps) {
+    profile_gcov_interval(counters, value, start, steps, true);
+}
+
+void __gcov_pow2_profiler(gcov_type* counters, const gcov_type value) {
+    profile_gcov_pow2(counters, value, false);
+}
+
+void __gcov_pow2_profiler_atomic(gcov_type* counters, const gcov_type value) {
+    profile_gcov_pow2(counters, value, true);
+}
+
+void __gcov_topn_values_profiler(gcov_type* counters, const gcov_type value) {
+    add_gcov_topn_value(counters, value, false);
+}
+
+void __gcov_topn_values_profiler_atomic(gcov_type* counters, const gcov_type value) {
+    add_gcov_topn_value(counters, value, true);
+}
+
+void __gcov_indirect_call_profiler_v4(const gcov_type value, void* cur_func) {
+    profile_gcov_indirect_call(value, cur_func, false);
+}
+
+void __gcov_indirect_call_profiler_v4_atomic(const gcov_type value, void* cur_func) {
+    profile_gcov_indirect_call(value, cur_func, true);
+}
+
+void __gcov_average_profiler(gcov_type* counters, const gcov_type value) {
+    profile_gcov_average(counters, value, false);
+}
+
+void __gcov_average_profiler_atomic(gcov_type* counters, const gcov_type value) {
+    profile_gcov_average(counters, value, true);
+}
+
+void __gcov_ior_profiler(gcov_type* counters, const gcov_type value) {
+    profile_gcov_ior(counters, value, false);
+}
+
+void __gcov_ior_profiler_atomic(gcov_type* counters, const gcov_type value) {
+    profile_gcov_ior(counters, value, true);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gcovhost/gcda.hpp"
+#include "gcovhost/gcno.hpp"
+
+namespace gcovhost {
+
+/*! \brief The outcome of a conditional branch
+ */
+struct branch_coverage {
+    bool exceptional;    //!< Set if the branch is taken by an exception
+    bool executed;       //!< Set if the block of the branch was executed
+    uint64_t taken;      //!< The number of times the branch was taken
+};
+
+/*! \brief The MC/DC coverage of a boolean expression
+ */
+struct condition_coverage {
+    uint32_t terms;            //!< The number of conditions of the expression
+    uint64_t covered_true;     //!< Bit mask of the conditions shown to independently be true
+    uint64_t covered_false;    //!< Bit mask of the conditions shown to independently be false
+};
+
+/*! \brief The coverage of a function
+ */
+struct function_coverage {
+    uint32_t start_line;    //!< The first line of the function
+    uint32_t end_line;      //!< The last line of the function
+    uint64_t count;         //!< The number of calls
+};
+
+/*! \brief The coverage of a source file
+ */
+struct source_coverage {
+    std::map<uint32_t, uint64_t> lines;                                //!< Count per line
+    std::map<uint32_t, std::vector<branch_coverage>> branches;         //!< Branches per line
+    std::map<uint32_t, std::vector<condition_coverage>> conditions;    //!< Conditions per line
+    std::map<std::string, function_coverage> functions;                //!< Functions by name
+};
+
+/*! \brief An arc of a function which has a counter
+ */
+struct arc_counter {
+    uint32_t source;         //!< The index of the source block
+    uint32_t destination;    //!< The index of the destination block
+    uint64_t count;          //!< The number of times the arc was taken
+};
+
+//! The coverage of all source files by their absolute path
+using coverage_map = std::map<std::string, source_coverage>;
+
+/*! \brief Adds the coverage of a compilation unit
+ *
+ *  \param[in,out]  coverage    The coverage to add to
+ *  \param[in]      notes       The gcno file of the compilation unit
+ *  \param[in]      counters    The counters of the compilation unit, nullptr if it never ran
+ *
+ *  The counts of the arcs without counter are derived from the flow graph and the line,
+ *  branch and condition coverage is derived from the arcs the same way gcov does it, i.e. a
+ *  line counts how often it was entered and loops within a line are counted once per
+ *  iteration. Counts of lines, branches and functions already in \a coverage are summed up,
+ *  conditions are OR'ed. Throws gcda_error if the counters do not belong to the notes.
+ */
+void add_coverage(coverage_map& coverage, const gcno_file& notes, const gcda_file* counters);
+
+/*! \brief Resolves a source path recorded by the compiler
+ *
+ *  \param[in]  cwd     The working directory of the compiler from the gcno file
+ *  \param[in]  source  The source path
+ *  \return             The normalized path, a relative \a source is taken relative to \a cwd
+ */
+std::string resolve_source(const std::string& cwd, const std::string& source);
+
+/*! \brief Assigns the arc counters of a function to the arcs of its flow graph
+ *
+ *  \param[in]  function    The notes of the function
+ *  \param[in]  counters    The counters of the function
+ *  \return                 The arcs with counter in counter order
+ *
+ *  Each traversal of such an arc increments its counter, the other arcs are derived by gcov
+ *  and cost nothing at runtime. Throws gcda_error if the counters do not belong to the notes.
+ */
+std::vector<arc_counter> list_arc_counters(const gcno_function& function,
+                                           const gcda_function& counters);
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace gcovhost {
+
+/*! \brief Raised if gcda or gcno data can not be parsed or does not belong to the same build
+ */
+class gcda_error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/*! \brief The counters of one counter type of a function
+ */
+struct gcda_counters {
+    unsigned kind;                   //!< The counter type, the index of the GCOV_TAG_FOR_COUNTER
+    std::vector<uint64_t> values;    //!< The counter values as stored on disk
+};
+
+/*! \brief The counters of a single function
+ */
+struct gcda_function {
+    uint32_t ident;                         //!< The unique function ident
+    uint32_t lineno_checksum;               //!< The checksum of the function source lines
+    uint32_t cfg_checksum;                  //!< The checksum of the control flow graph
+    std::vector<gcda_counters> counters;    //!< The counter records in file order
+};
+
+/*! \brief The contents of a gcda file
+ */
+struct gcda_file {
+    uint32_t version = 0U;                   //!< The gcov version of the compiler
+    uint32_t stamp = 0U;                     //!< The time stamp of the compilation unit
+    uint32_t checksum = 0U;                  //!< The checksum of the compilation unit
+    uint32_t runs = 0U;                      //!< The runs of the object summary, 0 without one
+    uint32_t sum_max = 0U;                   //!< The largest arc counter of the object summary
+    bool big_endian = false;                 //!< Set if the data was written by a big-endian target
+    std::vector<gcda_function> functions;    //!< The functions in file order
+};
+
+/*! \brief Parses gcda data
+ *
+ *  \param[in]  data        The gcda data
+ *  \param[in]  size        The size of the data in bytes
+ *  \param[in]  packed      Set if the counter records hold packed counters, see
+ *                          GCOV_IMAGE_PACKED_COUNTERS
+ *  \param[out] consumed    The number of bytes parsed up to and including the terminating zero
+ *                          tag, nullptr if the data is not terminated
+ *  \return                 The parsed file
+ *
+ *  Parsing stops at the end of the data or at a zero tag. If \a consumed is given, the data has
+ *  to end with a zero tag like the records of images without table of contents. Counter records
+ *  tagged with GCOV_TAG_HIT_BITS are expanded to counts of 0 or 1. Throws gcda_error if the
+ *  data is malformed or truncated.
+ */
+gcda_file parse_gcda(const uint8_t* data, size_t size, bool packed, size_t* consumed = nullptr);
+
+/*! \brief Serializes a file into the plain gcda format in the byte order it was read in
+ *
+ *  \param[in]  file    The file to serialize
+ *  \return             The gcda data
+ */
+std::vector<uint8_t> serialize_gcda(const gcda_file& file);
+
+/*! \brief Merges the counters of a file into another one of the same compilation unit
+ *
+ *  \param[in,out]  into    The file to merge into
+ *  \param[in]      from    The file to merge
+ *
+ *  Each counter type is merged like libgcov does when it merges a run into an existing gcda
+ *  file: arcs, intervals, pow2 and averages are summed up, ior and condition counters OR'ed,
+ *  the time profile keeps the earliest run and the topn pairs of equal values are combined.
+ *  The runs and the largest arc counters of the object summaries are summed up as well.
+ *  Throws gcda_error without modifying \a into if the stamp, a checksum or the layout of the
+ *  counters does not match.
+ */
+void merge_gcda(gcda_file& into, const gcda_file& from);
+
+}
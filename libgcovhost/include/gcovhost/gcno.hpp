@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gcovhost {
+
+// Arc flags of the gcno format, see gcc/gcov-io.h
+constexpr uint32_t gcno_arc_on_tree = 1U;        //!< The arc has no counter, its count is derived
+constexpr uint32_t gcno_arc_fake = 2U;           //!< Exceptional or non-local exit of a call
+constexpr uint32_t gcno_arc_fallthrough = 4U;    //!< The arc falls through to the next block
+
+/*! \brief An arc of the control flow graph of a function
+ */
+struct gcno_arc {
+    uint32_t source;         //!< The index of the source block
+    uint32_t destination;    //!< The index of the destination block
+    uint32_t flags;          //!< A combination of the gcno_arc_* flags
+};
+
+/*! \brief The source lines of a block within one source file
+ */
+struct gcno_location {
+    std::string source;             //!< The source file as recorded by the compiler
+    std::vector<uint32_t> lines;    //!< The lines in the order they were recorded
+};
+
+/*! \brief A basic block of a function
+ */
+struct gcno_block {
+    std::vector<gcno_location> locations;    //!< The source lines of the block
+    uint32_t condition_terms = 0U;           //!< The number of terms of the block's condition
+};
+
+/*! \brief The control flow graph of a function
+ */
+struct gcno_function {
+    uint32_t ident;                      //!< The unique function ident
+    uint32_t lineno_checksum;            //!< The checksum of the function source lines
+    uint32_t cfg_checksum;               //!< The checksum of the control flow graph
+    std::string name;                    //!< The assembler name of the function
+    bool artificial;                     //!< Set for functions generated by the compiler
+    std::string source;                  //!< The source file of the function
+    uint32_t start_line;                 //!< The first line of the function
+    uint32_t start_column;               //!< The first column of the function
+    uint32_t end_line;                   //!< The last line of the function
+    uint32_t end_column;                 //!< The last column of the function
+    std::vector<gcno_block> blocks;      //!< The blocks, the entry block comes first
+    std::vector<gcno_arc> arcs;          //!< The arcs in file order
+    std::vector<uint32_t> conditions;    //!< The blocks of the conditions in counter order
+};
+
+/*! \brief The contents of a gcno file
+ */
+struct gcno_file {
+    uint32_t version = 0U;                   //!< The gcov version of the compiler
+    uint32_t stamp = 0U;                     //!< The time stamp of the compilation unit
+    uint32_t checksum = 0U;                  //!< Reserved for the checksum of the unit, 0
+    std::string cwd;                         //!< The working directory of the compiler
+    std::vector<gcno_function> functions;    //!< The functions in file order
+};
+
+/*! \brief Parses the notes file the compiler writes next to an instrumented object
+ *
+ *  \param[in]  data    The gcno data
+ *  \param[in]  size    The size of the data in bytes
+ *  \return             The parsed file
+ *
+ *  Throws gcda_error if the data is malformed.
+ */
+gcno_file parse_gcno(const uint8_t* data, size_t size);
+
+/*! \brief Maps and parses a gcno file
+ *
+ *  \param[in]  path    The path of the gcno file
+ *  \return             The parsed file
+ */
+gcno_file read_gcno(const std::string& path);
+
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gcovhost/gcda.hpp"
+
+namespace gcovhost {
+
+/*! \brief Raised if a coverage image can not be read
+ */
+class image_error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/*! \brief The state of an image according to the length and the CRC-32 in its header
+ */
+enum class image_state {
+    complete,      //!< The length, the end marker and the CRC-32 match
+    unfinished,    //!< The header holds no length, the image was streamed or is still written
+    truncated,     //!< The image is longer than the available data
+    corrupted,     //!< The end marker is missing or the CRC-32 does not match
+};
+
+/*! \brief The record of a single file in a coverage image
+ */
+struct image_record {
+    std::string path;    //!< The path of the gcda file on the build host
+    gcda_file data;      //!< The coverage data of the file
+};
+
+/*! \brief A record of a checked image which was dropped since its CRC-32 does not match
+ */
+struct lost_record {
+    size_t offset = 0U;    //!< The offset of the record in the image without the chunk CRC-32s
+    std::string path;      //!< The path of the gcda file, empty if it was corrupted as well
+};
+
+/*! \brief A parsed coverage image
+ */
+struct image {
+    unsigned version = 0U;                //!< The image version, 0 for the headerless layout
+    unsigned flags = 0U;                  //!< The GCOV_IMAGE_* flags the image was written with
+    uint16_t sequence = 0U;               //!< The dump sequence number, the id of test images
+    bool verified = false;                //!< Set if the length and CRC-32 of the header match
+    bool truncated = false;               //!< Set if the image ends within a record
+    std::vector<image_record> records;    //!< The records in image order
+    std::vector<lost_record> lost;        //!< The dropped records of checked images
+};
+
+/*! \brief A read-only memory mapping of a file
+ */
+class mapped_file {
+public:
+    /*! \brief Maps a file, throws image_error if the file can not be mapped
+     *
+     *  \param[in]  path    The path of the file
+     */
+    explicit mapped_file(const std::string& path);
+    ~mapped_file();
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    const uint8_t* data() const {
+        return address;
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+private:
+    const uint8_t* address;
+    size_t length;
+};
+
+/*! \brief Calculates the CRC-32 (IEEE 802.3) of a byte sequence
+ *
+ *  \param[in]  data    The bytes
+ *  \param[in]  size    The number of bytes
+ *  \param[in]  crc     The CRC-32 of the preceding bytes, 0 for the first bytes
+ *  \return             The CRC-32, like zlib's crc32()
+ */
+uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0U);
+
+/*! \brief Checks the length and the CRC-32 in the header of an image
+ *
+ *  \param[in]  data    The image, starts with GCOV_IMAGE_MAGIC
+ *  \param[in]  size    The number of bytes available at \a data
+ *  \param[out] length  The length of the image from its header, 0 if it holds none
+ *  \return             The state of the image, images before version 4 are always unfinished
+ */
+image_state check_image(const uint8_t* data, size_t size, size_t& length);
+
+/*! \brief Parses a coverage image written by libgcov
+ *
+ *  \param[in]  data    The raw image
+ *  \param[in]  size    The size of the image in bytes
+ *  \return             The parsed image
+ *
+ *  Images with table of contents are read via the table, images without one or with a
+ *  truncated one are walked record by record. If the header holds the length of the image,
+ *  bytes behind it are ignored, so a dump of the whole buffer can be read. Headerless images
+ *  of the legacy layout are split by the length in front of each record. Throws image_error
+ *  or gcda_error if the image is malformed or its CRC-32 does not match.
+ *
+ *  Corrupted chunks of checked images are skipped instead: the reader resynchronizes on the
+ *  next chunk whose CRC-32 matches, keeps every record whose CRC-32 matches and lists the
+ *  others in image::lost.
+ */
+image parse_image(const uint8_t* data, size_t size);
+
+/*! \brief Maps and parses a coverage image file
+ *
+ *  \param[in]  path    The path of the image
+ *  \return             The parsed image
+ */
+image read_image(const std::string& path);
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "gcovhost/image.hpp"
+
+namespace gcovhost {
+
+/*! \brief A coverage image found in a raw memory dump
+ */
+struct located_image {
+    size_t offset = 0U;                             //!< The offset of the image in the dump
+    unsigned version = 0U;                          //!< The image version
+    unsigned flags = 0U;                            //!< The GCOV_IMAGE_* flags of the image
+    uint16_t sequence = 0U;                         //!< The dump sequence number
+    size_t length = 0U;                             //!< The length from the header, 0 if unknown
+    image_state state = image_state::unfinished;    //!< The result of check_image()
+};
+
+/*! \brief Finds the coverage images in a raw memory dump
+ *
+ *  \param[in]  data    The dump, e.g. a RAM region or an ELF core file
+ *  \param[in]  size    The size of the dump in bytes
+ *  \return             The images in the order of their offsets
+ *
+ *  Every GCOV_IMAGE_MAGIC followed by a known image version is checked with check_image(),
+ *  the search continues behind complete images. The magic is searched 16 positions at a time
+ *  with vector compares, so a dump is scanned at about the speed it can be read from memory.
+ */
+std::vector<located_image> locate_images(const uint8_t* data, size_t size);
+
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gcovhost/image.hpp"
+
+namespace gcovhost {
+
+/*! \brief Raised if a test matrix can not be built or read
+ */
+class test_matrix_error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/*! \brief A function of the test matrix
+ */
+struct matrix_function {
+    std::string path;       //!< The path of the gcda file on the build host
+    uint32_t ident = 0U;    //!< The unique function ident
+    std::string name;       //!< The assembler name from the gcno file, empty without one
+    std::string source;     //!< The source file from the gcno file, empty without one
+};
+
+/*! \brief Which test executed which function
+ *
+ *  Each function has a row of words_per_row() words, bit t of a row is set if the test
+ *  tests[t] executed the function.
+ */
+struct test_matrix {
+    std::vector<uint32_t> tests;               //!< The test ids in ascending order
+    std::vector<matrix_function> functions;    //!< The functions ordered by path and ident
+    std::vector<uint64_t> rows;                //!< The rows of all functions in function order
+
+    size_t words_per_row() const {
+        return (tests.size() + 63U) / 64U;
+    }
+};
+
+/*! \brief Collects the test images written by gcov_end_test()
+ */
+class test_matrix_builder {
+public:
+    /*! \brief Adds the functions of a test image to the column of its test
+     *
+     *  \param[in]  test_image  The image, written with GCOV_IMAGE_TEST
+     *
+     *  The test id is the sequence number of the image, several images of the same test are
+     *  combined. Throws test_matrix_error if the image is no test image.
+     */
+    void add_image(const image& test_image);
+
+    /*! \brief Builds the matrix of all added images
+     *
+     *  \return The matrix, the names and sources of the functions are left empty
+     */
+    test_matrix build() const;
+
+private:
+    //! The functions by gcda path and ident, mapped to their index in the columns
+    std::map<std::pair<std::string, uint32_t>, size_t> functions;
+    //! The indices of the functions each test executed, by test id
+    std::map<uint32_t, std::vector<size_t>> columns;
+};
+
+/*! \brief Serializes a test matrix into the file format read by test_matrix_file
+ *
+ *  \param[in]  matrix  The matrix
+ *  \return             The file contents
+ *
+ *  The file holds a header, the test ids, the functions, a string table with the paths, names
+ *  and sources and the rows as 64 bit little-endian words, so it is read without parsing each
+ *  bit.
+ */
+std::vector<uint8_t> serialize_test_matrix(const test_matrix& matrix);
+
+/*! \brief A test matrix file written by serialize_test_matrix()
+ *
+ *  The file is mapped and only the rows of the functions passed to select_tests() are read, so
+ *  a query takes about as long as reading the functions.
+ */
+class test_matrix_file {
+public:
+    /*! \brief Maps a test matrix file, throws test_matrix_error if it is malformed
+     *
+     *  \param[in]  path    The path of the file
+     */
+    explicit test_matrix_file(const std::string& path);
+
+    //! The test ids in ascending order
+    const std::vector<uint32_t>& tests() const {
+        return test_ids;
+    }
+
+    //! The functions ordered by path and ident
+    const std::vector<matrix_function>& functions() const {
+        return function_entries;
+    }
+
+    /*! \brief Finds the tests which executed at least one of the given functions
+     *
+     *  \param[in]  functions   The indices of the functions in functions()
+     *  \return                 The ids of the tests in ascending order
+     */
+    std::vector<uint32_t> select_tests(const std::vector<size_t>& functions) const;
+
+private:
+    mapped_file file;
+    std::vector<uint32_t> test_ids;
+    std::vector<matrix_function> function_entries;
+    const uint8_t* rows;
+};
+
+}
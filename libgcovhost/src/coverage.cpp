@@ -0,0 +1,479 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gcovhost/coverage.hpp"
+#include "gcovhost/gcda.hpp"
+#include "gcovhost/gcno.hpp"
+
+namespace {
+
+// Blocks and counter types with a fixed meaning, see gcc/basic-block.h and gcov-counter.def
+constexpr uint32_t entry_block = 0U;
+constexpr uint32_t exit_block = 1U;
+constexpr unsigned gcov_counter_arcs = 0U;
+constexpr unsigned gcov_counter_conditions = 8U;
+//! Marks blocks without condition
+constexpr size_t no_condition = std::numeric_limits<size_t>::max();
+
+/*! \brief An arc of the flow graph of the compilation unit
+ */
+struct flow_arc {
+    size_t source;                 //!< The flow block the arc leaves
+    size_t destination;            //!< The flow block the arc enters
+    uint32_t flags;                //!< A combination of the gcno_arc_* flags
+    uint64_t count = 0U;           //!< The number of times the arc was taken
+    bool valid = false;            //!< Set once the count is known
+    bool unconditional = false;    //!< Set if the arc is the only regular exit of its block
+    bool exceptional = false;      //!< Set if the arc is taken by an exception
+    int64_t cycle_count = 0;       //!< The count not yet attributed to a cycle within a line
+};
+
+/*! \brief A block of the flow graph of the compilation unit
+ */
+struct flow_block {
+    std::vector<size_t> successors;      //!< The leaving arcs
+    std::vector<size_t> predecessors;    //!< The entering arcs
+    uint64_t count = 0U;                 //!< The number of times the block was executed
+    bool valid = false;                  //!< Set once the count is known
+    size_t unknown_successors = 0U;      //!< The number of leaving arcs without known count
+    size_t unknown_predecessors = 0U;    //!< The number of entering arcs without known count
+    size_t condition = no_condition;     //!< The index of the MC/DC of the block
+};
+
+/*! \brief A source line of the compilation unit
+ */
+struct flow_line {
+    uint64_t count = 0U;           //!< The sum of the counts of the blocks on the line
+    std::vector<size_t> blocks;    //!< The blocks which end on this line
+    std::vector<size_t> arcs;      //!< The leaving arcs of these blocks
+};
+
+/*! \brief The flow graph of all functions of a compilation unit
+ *
+ *  Blocks and arcs of all functions are numbered consecutively, so the blocks of a function
+ *  keep their order like gcov relies on when it searches for cycles.
+ */
+struct flow_graph {
+    std::vector<flow_block> blocks;
+    std::vector<flow_arc> arcs;
+    std::vector<gcovhost::condition_coverage> conditions;
+    std::map<std::string, std::map<uint32_t, flow_line>> lines;
+};
+
+/*! \brief Sets the count of an arc which was derived from the flow graph
+ */
+void set_arc_count(flow_graph& graph, const size_t arc_idx, const uint64_t count) {
+    flow_arc& arc = graph.arcs[arc_idx];
+    arc.count = count;
+    arc.valid = true;
+    --graph.blocks[arc.source].unknown_successors;
+    --graph.blocks[arc.destination].unknown_predecessors;
+}
+
+/*! \brief Sums the counts of arcs whose count is known
+ */
+uint64_t sum_known_arcs(const flow_graph& graph, const std::vector<size_t>& arcs) {
+    uint64_t sum = 0U;
+    for(const size_t arc_idx : arcs)
+        if(graph.arcs[arc_idx].valid)
+            sum += graph.arcs[arc_idx].count;
+    return sum;
+}
+
+/*! \brief Derives the counts of all blocks and of the arcs without counter
+ *
+ *  \param[in,out]  graph   The flow graph
+ *  \param[in]      first   The first block of the function
+ *  \param[in]      last    The block behind the last block of the function
+ *
+ *  A block count is known once all entering or all leaving arcs are known, an arc count once
+ *  it is the only unknown arc of a block with known count. The entry block is only solved via
+ *  its leaving arcs and the exit block via its entering arcs.
+ */
+void solve_flow_graph(flow_graph& graph, const size_t first, const size_t last) {
+    for(bool changed = true; changed;) {
+        changed = false;
+        for(size_t block_idx = first; block_idx < last; ++block_idx) {
+            flow_block& block = graph.blocks[block_idx];
+            if(!block.valid) {
+                if(block_idx != first + entry_block && !block.unknown_predecessors) {
+                    block.count = sum_known_arcs(graph, block.predecessors);
+                    block.valid = true;
+                } else if(block_idx != first + exit_block && !block.unknown_successors) {
+                    block.count = sum_known_arcs(graph, block.successors);
+                    block.valid = true;
+                } else {
+                    continue;
+                }
+                changed = true;
+            }
+            for(const auto& [arcs, unknown] :
+                {std::pair(&block.successors, block.unknown_successors),
+                 std::pair(&block.predecessors, block.unknown_predecessors)}) {
+                if(unknown != 1U)
+                    continue;
+                const uint64_t known = sum_known_arcs(graph, *arcs);
+                for(const size_t arc_idx : *arcs) {
+                    if(!graph.arcs[arc_idx].valid) {
+                        const uint64_t count = block.count > known ? block.count - known : 0U;
+                        set_arc_count(graph, arc_idx, count);
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*! \brief Adds a function to the flow graph
+ *
+ *  \param[in,out]  graph       The flow graph
+ *  \param[in]      function    The notes of the function
+ *  \param[in]      counters    The counters of the function, nullptr if there are none
+ */
+void add_flow_function(flow_graph& graph,
+                       const gcovhost::gcno_function& function,
+                       const gcovhost::gcda_function* counters) {
+    const std::vector<uint64_t>* arc_counters = nullptr;
+    const std::vector<uint64_t>* condition_counters = nullptr;
+    if(counters) {
+        for(const gcovhost::gcda_counters& values : counters->counters) {
+            if(values.kind == gcov_counter_arcs)
+                arc_counters = &values.values;
+            else if(values.kind == gcov_counter_conditions)
+                condition_counters = &values.values;
+        }
+    }
+
+    const size_t first_block = graph.blocks.size();
+    graph.blocks.resize(first_block + function.blocks.size());
+    for(const gcovhost::gcno_arc& arc : function.arcs) {
+        const size_t arc_idx = graph.arcs.size();
+        graph.arcs.push_back({first_block + arc.source, first_block + arc.destination, arc.flags});
+        flow_block& source = graph.blocks[first_block + arc.source];
+        flow_block& destination = graph.blocks[first_block + arc.destination];
+        source.successors.push_back(arc_idx);
+        ++source.unknown_successors;
+        destination.predecessors.push_back(arc_idx);
+        ++destination.unknown_predecessors;
+    }
+
+    // the counters belong to the arcs off the spanning tree in block and file order
+    size_t counter_idx = 0U;
+    for(size_t block_idx = first_block; block_idx < graph.blocks.size(); ++block_idx) {
+        for(const size_t arc_idx : graph.blocks[block_idx].successors) {
+            if(graph.arcs[arc_idx].flags & gcovhost::gcno_arc_on_tree)
+                continue;
+            uint64_t count = 0U;
+            if(arc_counters) {
+                if(counter_idx >= arc_counters->size())
+                    throw gcovhost::gcda_error("arc counters of " + function.name
+                                               + " do not match its notes");
+                count = (*arc_counters)[counter_idx++];
+            }
+            set_arc_count(graph, arc_idx, count);
+        }
+    }
+    if(arc_counters && counter_idx != arc_counters->size())
+        throw gcovhost::gcda_error("arc counters of " + function.name + " do not match its notes");
+
+    solve_flow_graph(graph, first_block, graph.blocks.size());
+
+    for(size_t block_idx = first_block; block_idx < graph.blocks.size(); ++block_idx) {
+        flow_block& block = graph.blocks[block_idx];
+        const bool call_site = std::any_of(
+            block.successors.begin(), block.successors.end(), [&graph](const size_t arc_idx) {
+                return graph.arcs[arc_idx].flags & gcovhost::gcno_arc_fake;
+            });
+        size_t regular_successors = 0U;
+        for(const size_t arc_idx : block.successors) {
+            flow_arc& arc = graph.arcs[arc_idx];
+            if(arc.flags & gcovhost::gcno_arc_fake)
+                continue;
+            ++regular_successors;
+            // calls which may throw leave their block by fake arcs
+            arc.exceptional = call_site && block_idx != first_block + entry_block
+                              && !(arc.flags & gcovhost::gcno_arc_fallthrough);
+        }
+        for(const size_t arc_idx : block.successors)
+            graph.arcs[arc_idx].unconditional = regular_successors == 1U
+                                                && !(graph.arcs[arc_idx].flags
+                                                     & gcovhost::gcno_arc_fake);
+        // branches are reported in the order of their destination
+        std::stable_sort(block.successors.begin(),
+                         block.successors.end(),
+                         [&graph](const size_t lhs, const size_t rhs) {
+                             return graph.arcs[lhs].destination < graph.arcs[rhs].destination;
+                         });
+    }
+
+    for(size_t condition = 0U; condition < function.conditions.size(); ++condition) {
+        const uint32_t terms = function.blocks[function.conditions[condition]].condition_terms;
+        const uint64_t mask = terms >= 64U ? ~uint64_t(0U) : (uint64_t(1U) << terms) - 1U;
+        gcovhost::condition_coverage coverage = {terms, 0U, 0U};
+        if(condition_counters && 2U * condition + 1U < condition_counters->size()) {
+            coverage.covered_true = (*condition_counters)[2U * condition] & mask;
+            coverage.covered_false = (*condition_counters)[2U * condition + 1U] & mask;
+        }
+        graph.blocks[first_block + function.conditions[condition]].condition =
+            graph.conditions.size();
+        graph.conditions.push_back(coverage);
+    }
+}
+
+/*! \brief Assigns the blocks of a function to the source lines
+ *
+ *  Like gcov, every line of a block gets the block count, but only the last line of the
+ *  block gets the block itself for the entry count and its arcs as branches.
+ */
+void add_flow_lines(flow_graph& graph,
+                    const std::string& cwd,
+                    const gcovhost::gcno_function& function,
+                    const size_t first_block) {
+    for(size_t block_idx = 0U; block_idx < function.blocks.size(); ++block_idx) {
+        const gcovhost::gcno_block& notes = function.blocks[block_idx];
+        const flow_block& block = graph.blocks[first_block + block_idx];
+        flow_line* line = nullptr;
+        for(const gcovhost::gcno_location& location : notes.locations) {
+            std::map<uint32_t, flow_line>& lines =
+                graph.lines[gcovhost::resolve_source(cwd, location.source)];
+            for(const uint32_t line_number : location.lines) {
+                line = &lines[line_number];
+                line->count += block.count;
+            }
+        }
+        // the entry and exit block are not attributed to a line
+        if(!line || block_idx == entry_block || block_idx + 1U == function.blocks.size())
+            continue;
+        line->blocks.push_back(first_block + block_idx);
+        line->arcs.insert(line->arcs.end(), block.successors.begin(), block.successors.end());
+    }
+}
+
+/*! \brief Finds the elementary cycles through a block within a line
+ *
+ *  Implements the circuit search of Hawick and James like gcov does: the count of each cycle
+ *  is its smallest arc count, which is then removed from all arcs of the cycle.
+ */
+bool find_line_cycles(flow_graph& graph,
+                      const flow_line& line,
+                      const size_t block_idx,
+                      const size_t start,
+                      std::vector<size_t>& path,
+                      std::vector<size_t>& blocked,
+                      std::vector<std::vector<size_t>>& blocked_by,
+                      int64_t& count) {
+    const auto on_line = [&line](const size_t block) {
+        return std::find(line.blocks.begin(), line.blocks.end(), block) != line.blocks.end();
+    };
+    const auto unblock = [&blocked, &blocked_by](size_t block, auto& self) -> void {
+        const auto found = std::find(blocked.begin(), blocked.end(), block);
+        if(found == blocked.end())
+            return;
+        const size_t index = size_t(found - blocked.begin());
+        blocked.erase(found);
+        const std::vector<size_t> released = blocked_by[index];
+        blocked_by.erase(blocked_by.begin() + std::ptrdiff_t(index));
+        for(const size_t other : released)
+            self(other, self);
+    };
+
+    bool found_cycle = false;
+    blocked.push_back(block_idx);
+    blocked_by.emplace_back();
+
+    for(const size_t arc_idx : graph.blocks[block_idx].successors) {
+        const size_t next = graph.arcs[arc_idx].destination;
+        if(next < start || graph.arcs[arc_idx].cycle_count <= 0 || !on_line(next))
+            continue;
+        path.push_back(arc_idx);
+        if(next == start) {
+            int64_t cycle_count = std::numeric_limits<int64_t>::max();
+            for(const size_t cycle_arc : path)
+                cycle_count = std::min(cycle_count, graph.arcs[cycle_arc].cycle_count);
+            for(const size_t cycle_arc : path)
+                graph.arcs[cycle_arc].cycle_count -= cycle_count;
+            count += cycle_count;
+            found_cycle = true;
+        } else if(std::none_of(path.begin(),
+                               path.end(),
+                               [&graph](const size_t path_arc) {
+                                   return graph.arcs[path_arc].cycle_count <= 0;
+                               })
+                  && std::find(blocked.begin(), blocked.end(), next) == blocked.end()) {
+            found_cycle |=
+                find_line_cycles(graph, line, next, start, path, blocked, blocked_by, count);
+        }
+        path.pop_back();
+    }
+
+    if(found_cycle) {
+        unblock(block_idx, unblock);
+        return true;
+    }
+    for(const size_t arc_idx : graph.blocks[block_idx].successors) {
+        const size_t next = graph.arcs[arc_idx].destination;
+        if(next < start || graph.arcs[arc_idx].cycle_count <= 0 || !on_line(next))
+            continue;
+        const auto index = std::find(blocked.begin(), blocked.end(), next) - blocked.begin();
+        std::vector<size_t>& list = blocked_by[size_t(index)];
+        if(std::find(list.begin(), list.end(), block_idx) == list.end())
+            list.push_back(block_idx);
+    }
+    return false;
+}
+
+/*! \brief Calculates how often a line was entered
+ *
+ *  The count is the sum of the arcs entering the blocks of the line from other lines plus the
+ *  number of iterations of loops entirely within the line.
+ */
+uint64_t count_line(flow_graph& graph, const flow_line& line) {
+    int64_t count = 0;
+    for(const size_t block_idx : line.blocks) {
+        for(const size_t arc_idx : graph.blocks[block_idx].predecessors) {
+            const flow_arc& arc = graph.arcs[arc_idx];
+            if(std::find(line.blocks.begin(), line.blocks.end(), arc.source) == line.blocks.end())
+                count += int64_t(arc.count);
+        }
+        for(const size_t arc_idx : graph.blocks[block_idx].successors)
+            graph.arcs[arc_idx].cycle_count = int64_t(graph.arcs[arc_idx].count);
+    }
+    for(const size_t block_idx : line.blocks) {
+        std::vector<size_t> path;
+        std::vector<size_t> blocked;
+        std::vector<std::vector<size_t>> blocked_by;
+        find_line_cycles(graph, line, block_idx, block_idx, path, blocked, blocked_by, count);
+    }
+    return uint64_t(count);
+}
+
+}
+
+void gcovhost::add_coverage(coverage_map& coverage,
+                            const gcno_file& notes,
+                            const gcda_file* counters) {
+    // like gcov only the stamp is compared, the notes do not carry the checksum of the unit
+    if(counters && counters->stamp != notes.stamp)
+        throw gcda_error("stamp does not match the notes, the data is stale");
+    std::unordered_map<uint32_t, const gcda_function*> counter_functions;
+    if(counters)
+        for(const gcda_function& function : counters->functions)
+            counter_functions.emplace(function.ident, &function);
+
+    flow_graph graph;
+    for(const gcno_function& function : notes.functions) {
+        // functions generated by the compiler are not reported
+        if(function.artificial)
+            continue;
+        const auto found = counter_functions.find(function.ident);
+        const gcda_function* function_counters =
+            found == counter_functions.end() ? nullptr : found->second;
+        if(function_counters
+           && (function_counters->lineno_checksum != function.lineno_checksum
+               || function_counters->cfg_checksum != function.cfg_checksum))
+            throw gcda_error("checksum of " + function.name + " does not match the notes");
+
+        const size_t first_block = graph.blocks.size();
+        add_flow_function(graph, function, function_counters);
+        add_flow_lines(graph, notes.cwd, function, first_block);
+
+        function_coverage& entry =
+            coverage[resolve_source(notes.cwd, function.source)].functions[function.name];
+        entry.start_line = function.start_line;
+        entry.end_line = function.end_line;
+        entry.count += graph.blocks[first_block + entry_block].count;
+    }
+
+    for(auto& [source, lines] : graph.lines) {
+        source_coverage& source_coverage = coverage[source];
+        for(auto& [line_number, line] : lines) {
+            source_coverage.lines[line_number] +=
+                line.blocks.empty() ? line.count : count_line(graph, line);
+
+            std::vector<branch_coverage> branches;
+            std::vector<condition_coverage> conditions;
+            for(const size_t arc_idx : line.arcs) {
+                const flow_arc& arc = graph.arcs[arc_idx];
+                // calls which do not return are no branches
+                if(arc.unconditional || (arc.flags & gcno_arc_fake))
+                    continue;
+                branches.push_back(
+                    {arc.exceptional, graph.blocks[arc.source].count != 0U, arc.count});
+            }
+            for(const size_t block_idx : line.blocks) {
+                const size_t condition = graph.blocks[block_idx].condition;
+                if(condition != no_condition && graph.conditions[condition].terms)
+                    conditions.push_back(graph.conditions[condition]);
+            }
+
+            if(!branches.empty()) {
+                std::vector<branch_coverage>& known = source_coverage.branches[line_number];
+                for(size_t branch = 0U; branch < branches.size(); ++branch) {
+                    if(branch >= known.size()) {
+                        known.push_back(branches[branch]);
+                        continue;
+                    }
+                    known[branch].executed |= branches[branch].executed;
+                    known[branch].taken += branches[branch].taken;
+                }
+            }
+            if(!conditions.empty()) {
+                std::vector<condition_coverage>& known = source_coverage.conditions[line_number];
+                for(size_t condition = 0U; condition < conditions.size(); ++condition) {
+                    if(condition >= known.size()) {
+                        known.push_back(conditions[condition]);
+                        continue;
+                    }
+                    known[condition].covered_true |= conditions[condition].covered_true;
+                    known[condition].covered_false |= conditions[condition].covered_false;
+                }
+            }
+        }
+    }
+}
+
+std::string gcovhost::resolve_source(const std::string& cwd, const std::string& source) {
+    const std::filesystem::path path(source);
+    if(path.is_absolute() || cwd.empty())
+        return path.lexically_normal().string();
+    return (std::filesystem::path(cwd) / path).lexically_normal().string();
+}
+
+std::vector<gcovhost::arc_counter> gcovhost::list_arc_counters(const gcno_function& function,
+                                                               const gcda_function& counters) {
+    const std::vector<uint64_t>* arc_counters = nullptr;
+    for(const gcda_counters& values : counters.counters) {
+        if(values.kind == gcov_counter_arcs)
+            arc_counters = &values.values;
+    }
+    std::vector<std::vector<const gcno_arc*>> successors(function.blocks.size());
+    for(const gcno_arc& arc : function.arcs) {
+        if(arc.source >= successors.size() || arc.destination >= successors.size())
+            throw gcda_error("arc of " + function.name + " leaves the flow graph");
+        successors[arc.source].push_back(&arc);
+    }
+
+    // the counters belong to the arcs off the spanning tree in block and file order
+    std::vector<arc_counter> arcs;
+    for(const std::vector<const gcno_arc*>& block_successors : successors) {
+        for(const gcno_arc* arc : block_successors) {
+            if(arc->flags & gcno_arc_on_tree)
+                continue;
+            if(!arc_counters || arcs.size() >= arc_counters->size())
+                throw gcda_error("arc counters of " + function.name + " do not match its notes");
+            arcs.push_back({arc->source, arc->destination, (*arc_counters)[arcs.size()]});
+        }
+    }
+    if(arc_counters && arcs.size() != arc_counters->size())
+        throw gcda_error("arc counters of " + function.name + " do not match its notes");
+    return arcs;
+}
@@ -0,0 +1,342 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+}
+
+#include "gcovhost/gcda.hpp"
+#include "record_reader.hpp"
+
+namespace {
+
+// Counter types of gcc/gcov-counter.def and the merge function gcc assigns to them
+constexpr unsigned gcov_counter_topn = 3U;
+constexpr unsigned gcov_counter_indirect_call = 4U;
+constexpr unsigned gcov_counter_ior = 6U;
+constexpr unsigned gcov_counter_time_profiler = 7U;
+constexpr unsigned gcov_counter_conditions = 8U;
+//! The maximum number of value/count pairs libgcov tracks per topn counter
+constexpr size_t gcov_topn_maximum_tracked_values = 32U;
+
+/*! \brief Writes words in the byte order of the target
+ */
+class gcda_writer {
+public:
+    explicit gcda_writer(const bool big_endian) : big_endian(big_endian) {
+    }
+
+    void write_word(const uint32_t value) {
+        if(big_endian)
+            output.insert(output.end(),
+                          {uint8_t(value >> 24U), uint8_t(value >> 16U), uint8_t(value >> 8U),
+                           uint8_t(value)});
+        else
+            output.insert(output.end(),
+                          {uint8_t(value), uint8_t(value >> 8U), uint8_t(value >> 16U),
+                           uint8_t(value >> 24U)});
+    }
+
+    void write_counter(const uint64_t value) {
+        write_word(uint32_t(value));
+        write_word(uint32_t(value >> 32U));
+    }
+
+    std::vector<uint8_t> output;
+
+private:
+    bool big_endian;
+};
+
+/*! \brief Reads the values of a hit bits record as counts of 0 or 1
+ *
+ *  \param[in]  reader  The reader positioned behind the record length
+ *  \param[in]  num     The number of counters of the record
+ *  \return             The counter values
+ */
+std::vector<uint64_t> read_hit_bits(gcovhost::record_reader& reader, const uint32_t num) {
+    // a word per 32 counters, the byte order does not matter
+    const uint8_t* bits = reader.read_bytes((size_t(num) + 31U) / 32U * GCOV_WORD_SIZE);
+    std::vector<uint64_t> values(num);
+    for(size_t idx = 0U; idx < values.size(); ++idx)
+        values[idx] = (bits[idx / 8U] >> (idx % 8U)) & 1U;
+    return values;
+}
+
+/*! \brief Reads the values of a packed counter record
+ *
+ *  \param[in]  reader  The reader positioned behind the record length
+ *  \param[in]  num     The number of counters of the record
+ *  \return             The counter values
+ */
+std::vector<uint64_t> read_packed_counters(gcovhost::record_reader& reader, const uint32_t num) {
+    const size_t start = reader.position();
+    std::vector<uint64_t> values;
+    // each value takes a byte at least, runs of zeros are appended as they come
+    values.reserve(std::min<size_t>(num, reader.remaining()));
+    while(values.size() < num) {
+        const uint64_t value = reader.read_leb128();
+        if(value) {
+            values.push_back(value);
+            continue;
+        }
+        const uint64_t run = reader.read_leb128();
+        if(run > num - values.size())
+            throw gcovhost::gcda_error("packed counters exceed their record");
+        values.resize(values.size() + run, 0U);
+    }
+    // the encoded values are padded to a multiple of the word size
+    reader.skip((GCOV_WORD_SIZE - (reader.position() - start) % GCOV_WORD_SIZE) % GCOV_WORD_SIZE);
+    return values;
+}
+
+/*! \brief Splits topn counters into their groups of total, number of pairs and pairs
+ *
+ *  \param[in]  values  The topn counters as stored on disk
+ *  \return             The start index of each group
+ */
+std::vector<size_t> split_topn_groups(const std::vector<uint64_t>& values) {
+    std::vector<size_t> groups;
+    for(size_t idx = 0U; idx < values.size();) {
+        if(values.size() - idx < 2U || (values.size() - idx - 2U) / 2U < values[idx + 1U])
+            throw gcovhost::gcda_error("malformed topn counters");
+        groups.push_back(idx);
+        idx += 2U + 2U * values[idx + 1U];
+    }
+    return groups;
+}
+
+/*! \brief Merges topn counters group by group
+ *
+ *  \param[in]  into    The counters to merge into
+ *  \param[in]  from    The counters to merge
+ *  \return             The merged counters
+ *
+ *  The totals are summed up, counts of equal values are combined and only the values with
+ *  the highest counts are kept, like libgcov limits the number of tracked values.
+ */
+std::vector<uint64_t> merge_topn_counters(const std::vector<uint64_t>& into,
+                                          const std::vector<uint64_t>& from) {
+    const std::vector<size_t> into_groups = split_topn_groups(into);
+    const std::vector<size_t> from_groups = split_topn_groups(from);
+    if(into_groups.size() != from_groups.size())
+        throw gcovhost::gcda_error("number of topn counters does not match");
+
+    std::vector<uint64_t> merged;
+    merged.reserve(into.size() + from.size());
+    for(size_t group = 0U; group < into_groups.size(); ++group) {
+        std::vector<std::pair<uint64_t, uint64_t>> pairs;
+        for(const auto& [values, start] :
+            {std::pair(&into, into_groups[group]), std::pair(&from, from_groups[group])}) {
+            for(size_t pair = 0U; pair < (*values)[start + 1U]; ++pair) {
+                const uint64_t value = (*values)[start + 2U + 2U * pair];
+                const uint64_t count = (*values)[start + 3U + 2U * pair];
+                auto found = std::find_if(pairs.begin(), pairs.end(), [value](const auto& entry) {
+                    return entry.first == value;
+                });
+                if(found == pairs.end())
+                    pairs.emplace_back(value, count);
+                else
+                    found->second += count;
+            }
+        }
+        std::stable_sort(pairs.begin(), pairs.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.second > rhs.second;
+        });
+        if(pairs.size() > gcov_topn_maximum_tracked_values)
+            pairs.resize(gcov_topn_maximum_tracked_values);
+
+        merged.push_back(into[into_groups[group]] + from[from_groups[group]]);
+        merged.push_back(pairs.size());
+        for(const auto& [value, count] : pairs) {
+            merged.push_back(value);
+            merged.push_back(count);
+        }
+    }
+    return merged;
+}
+
+/*! \brief Checks that two counter records can be merged
+ *
+ *  \param[in]  into    The counters to merge into
+ *  \param[in]  from    The counters to merge
+ */
+void check_counters(const gcovhost::gcda_counters& into, const gcovhost::gcda_counters& from) {
+    if(into.kind != from.kind)
+        throw gcovhost::gcda_error("counter types do not match");
+    if(into.kind == gcov_counter_topn || into.kind == gcov_counter_indirect_call) {
+        // the number of tracked values differs between runs
+        if(split_topn_groups(into.values).size() != split_topn_groups(from.values).size())
+            throw gcovhost::gcda_error("number of topn counters does not match");
+    } else if(into.values.size() != from.values.size()) {
+        throw gcovhost::gcda_error("number of counters does not match");
+    }
+}
+
+/*! \brief Merges the counters of one counter record
+ *
+ *  \param[in,out]  into    The counters to merge into
+ *  \param[in]      from    The counters to merge, checked with check_counters()
+ */
+void merge_counters(gcovhost::gcda_counters& into, const gcovhost::gcda_counters& from) {
+    if(into.kind == gcov_counter_topn || into.kind == gcov_counter_indirect_call) {
+        into.values = merge_topn_counters(into.values, from.values);
+        return;
+    }
+    for(size_t idx = 0U; idx < into.values.size(); ++idx) {
+        uint64_t& value = into.values[idx];
+        if(into.kind == gcov_counter_ior || into.kind == gcov_counter_conditions)
+            value |= from.values[idx];
+        else if(into.kind == gcov_counter_time_profiler)
+            // the first run which executed the function, zero if it was never executed
+            value = !value              ? from.values[idx]
+                    : !from.values[idx] ? value
+                                        : std::min(value, from.values[idx]);
+        else
+            value += from.values[idx];
+    }
+}
+
+}
+
+gcovhost::gcda_file gcovhost::parse_gcda(const uint8_t* data,
+                                         const size_t size,
+                                         const bool packed,
+                                         size_t* consumed) {
+    gcovhost::record_reader reader(data, size);
+    gcda_file file;
+
+    // the byte order follows from the magic
+    const uint32_t magic = reader.read_word();
+    if(magic != GCOV_DATA_MAGIC) {
+        reader.set_big_endian(true);
+        if(__builtin_bswap32(magic) != GCOV_DATA_MAGIC)
+            throw gcda_error("missing gcda magic");
+        file.big_endian = true;
+    }
+    file.version = reader.read_word();
+    file.stamp = reader.read_word();
+    file.checksum = reader.read_word();
+
+    for(;;) {
+        // records of images without length end with a zero tag
+        if(!consumed && reader.at_end())
+            break;
+        const uint32_t tag = reader.read_word();
+        if(!tag)
+            break;
+        const uint32_t length = reader.read_word();
+
+        if(tag == GCOV_TAG_FUNCTION) {
+            if(length != GCOV_TAG_FUNCTION_LENGTH)
+                throw gcda_error("unexpected function record length");
+            gcda_function& function = file.functions.emplace_back();
+            function.ident = reader.read_word();
+            function.lineno_checksum = reader.read_word();
+            function.cfg_checksum = reader.read_word();
+        } else if(tag == GCOV_TAG_OBJECT_SUMMARY && length == GCOV_TAG_SUMMARY_LENGTH) {
+            file.runs = reader.read_word();
+            file.sum_max = reader.read_word();
+        } else if(tag >= GCOV_TAG_COUNTER_BASE && tag < GCOV_TAG_FOR_COUNTER(GCOV_COUNTERS)
+                  && !((tag - GCOV_TAG_COUNTER_BASE) & ((1U << 17U) - 1U - GCOV_TAG_HIT_BITS))) {
+            if(file.functions.empty())
+                throw gcda_error("counter record without function");
+            gcda_counters& counters = file.functions.back().counters.emplace_back();
+            counters.kind = (tag - GCOV_TAG_COUNTER_BASE) >> 17U;
+            if(tag & GCOV_TAG_HIT_BITS) {
+                // the length holds the number of counters
+                counters.values = read_hit_bits(reader, length);
+            } else if(packed) {
+                // the length holds the number of counters
+                counters.values = read_packed_counters(reader, length);
+            } else {
+                if(length % GCOV_TAG_COUNTER_LENGTH(1U))
+                    throw gcda_error("unexpected counter record length");
+                if(length > reader.remaining())
+                    throw gcda_error("gcda data is truncated");
+                counters.values.resize(length / GCOV_TAG_COUNTER_LENGTH(1U));
+                for(uint64_t& value : counters.values)
+                    value = reader.read_counter();
+            }
+        } else {
+            // records unknown to this version, e.g. the histograms of older compilers
+            reader.skip(length);
+        }
+    }
+
+    if(consumed)
+        *consumed = reader.position();
+    return file;
+}
+
+std::vector<uint8_t> gcovhost::serialize_gcda(const gcda_file& file) {
+    gcda_writer writer(file.big_endian);
+    writer.write_word(GCOV_DATA_MAGIC);
+    writer.write_word(file.version);
+    writer.write_word(file.stamp);
+    writer.write_word(file.checksum);
+    if(file.runs) {
+        writer.write_word(GCOV_TAG_OBJECT_SUMMARY);
+        writer.write_word(GCOV_TAG_SUMMARY_LENGTH);
+        writer.write_word(file.runs);
+        writer.write_word(file.sum_max);
+    }
+    for(const gcda_function& function : file.functions) {
+        writer.write_word(GCOV_TAG_FUNCTION);
+        writer.write_word(GCOV_TAG_FUNCTION_LENGTH);
+        writer.write_word(function.ident);
+        writer.write_word(function.lineno_checksum);
+        writer.write_word(function.cfg_checksum);
+        for(const gcda_counters& counters : function.counters) {
+            writer.write_word(GCOV_TAG_FOR_COUNTER(counters.kind));
+            writer.write_word(GCOV_TAG_COUNTER_LENGTH(counters.values.size()));
+            for(const uint64_t value : counters.values)
+                writer.write_counter(value);
+        }
+    }
+    return std::move(writer.output);
+}
+
+void gcovhost::merge_gcda(gcda_file& into, const gcda_file& from) {
+    if(into.version != from.version)
+        throw gcda_error("gcov version does not match");
+    if(into.stamp != from.stamp || into.checksum != from.checksum)
+        throw gcda_error("stamp or checksum does not match, the data belongs to another build");
+    if(into.functions.size() != from.functions.size())
+        throw gcda_error("number of functions does not match");
+
+    // everything is checked first, so a mismatch leaves the target untouched
+    for(size_t function_idx = 0U; function_idx < into.functions.size(); ++function_idx) {
+        const gcda_function& function = into.functions[function_idx];
+        const gcda_function& other = from.functions[function_idx];
+        if(function.ident != other.ident || function.lineno_checksum != other.lineno_checksum
+           || function.cfg_checksum != other.cfg_checksum)
+            throw gcda_error("checksum of function " + std::to_string(function.ident)
+                             + " does not match");
+        if(function.counters.size() != other.counters.size())
+            throw gcda_error("counters of function " + std::to_string(function.ident)
+                             + " do not match");
+        try {
+            for(size_t counter_idx = 0U; counter_idx < function.counters.size(); ++counter_idx)
+                check_counters(function.counters[counter_idx], other.counters[counter_idx]);
+        } catch(const gcda_error& error) {
+            throw gcda_error(std::string(error.what()) + " in function "
+                             + std::to_string(function.ident));
+        }
+    }
+
+    for(size_t function_idx = 0U; function_idx < into.functions.size(); ++function_idx) {
+        std::vector<gcda_counters>& counters = into.functions[function_idx].counters;
+        for(size_t counter_idx = 0U; counter_idx < counters.size(); ++counter_idx)
+            merge_counters(counters[counter_idx],
+                           from.functions[function_idx].counters[counter_idx]);
+    }
+    // like libgcov, which adds the largest arc counter of each run
+    into.runs += from.runs;
+    into.sum_max = static_cast<uint32_t>(
+        std::min<uint64_t>(uint64_t{into.sum_max} + from.sum_max, UINT32_MAX));
+}
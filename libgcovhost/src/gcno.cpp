@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+}
+
+#include "gcovhost/gcda.hpp"
+#include "gcovhost/gcno.hpp"
+#include "gcovhost/image.hpp"
+#include "record_reader.hpp"
+
+namespace {
+
+// Record tags of the gcno format, see gcc/gcov-io.h
+constexpr uint32_t gcov_note_magic = 0x67636E6FU;    // "gcno"
+constexpr uint32_t gcov_tag_blocks = 0x01410000U;
+constexpr uint32_t gcov_tag_arcs = 0x01430000U;
+constexpr uint32_t gcov_tag_lines = 0x01450000U;
+constexpr uint32_t gcov_tag_conditions = 0x01470000U;
+
+/*! \brief Reads the line table of a block
+ *
+ *  \param[in]  reader  The reader positioned behind the block index
+ *  \param[out] block   The block to add the locations to
+ *
+ *  A line number of zero is followed by the name of the source file of the next lines, an
+ *  empty name ends the table.
+ */
+void read_gcno_lines(gcovhost::record_reader& reader, gcovhost::gcno_block& block) {
+    for(;;) {
+        const uint32_t line = reader.read_word();
+        if(line) {
+            if(block.locations.empty())
+                throw gcovhost::gcda_error("line without source file");
+            block.locations.back().lines.push_back(line);
+            continue;
+        }
+        std::string source = reader.read_string();
+        if(source.empty())
+            return;
+        block.locations.push_back({std::move(source), {}});
+    }
+}
+
+}
+
+gcovhost::gcno_file gcovhost::parse_gcno(const uint8_t* data, const size_t size) {
+    record_reader reader(data, size);
+    gcno_file file;
+
+    const uint32_t magic = reader.read_word();
+    if(magic != gcov_note_magic) {
+        if(__builtin_bswap32(magic) != gcov_note_magic)
+            throw gcda_error("missing gcno magic");
+        reader.set_big_endian(true);
+    }
+    file.version = reader.read_word();
+    file.stamp = reader.read_word();
+    file.checksum = reader.read_word();
+    file.cwd = reader.read_string();
+    (void) reader.read_word();    // whether the compiler marks blocks without execution
+
+    gcno_function* function = nullptr;
+    while(!reader.at_end()) {
+        const uint32_t tag = reader.read_word();
+        const uint32_t length = reader.read_word();
+        const size_t end = reader.position() + length;
+
+        if(tag == GCOV_TAG_FUNCTION) {
+            function = &file.functions.emplace_back();
+            function->ident = reader.read_word();
+            function->lineno_checksum = reader.read_word();
+            function->cfg_checksum = reader.read_word();
+            function->name = reader.read_string();
+            function->artificial = reader.read_word() != 0U;
+            function->source = reader.read_string();
+            function->start_line = reader.read_word();
+            function->start_column = reader.read_word();
+            function->end_line = reader.read_word();
+            function->end_column = reader.read_word();
+        } else if(!function) {
+            // records in front of the first function are not needed
+        } else if(tag == gcov_tag_blocks) {
+            function->blocks.resize(reader.read_word());
+        } else if(tag == gcov_tag_arcs) {
+            const uint32_t source = reader.read_word();
+            const uint32_t arcs = (std::max(length, uint32_t(GCOV_WORD_SIZE)) - GCOV_WORD_SIZE)
+                                  / (2U * GCOV_WORD_SIZE);
+            for(uint32_t arc = 0U; arc < arcs; ++arc) {
+                const uint32_t destination = reader.read_word();
+                const uint32_t flags = reader.read_word();
+                if(source >= function->blocks.size() || destination >= function->blocks.size())
+                    throw gcda_error("arc of " + function->name + " exceeds its blocks");
+                function->arcs.push_back({source, destination, flags});
+            }
+        } else if(tag == gcov_tag_conditions) {
+            for(uint32_t condition = 0U; condition < length / (2U * GCOV_WORD_SIZE);
+                ++condition) {
+                const uint32_t block = reader.read_word();
+                const uint32_t terms = reader.read_word();
+                if(block >= function->blocks.size())
+                    throw gcda_error("condition of " + function->name + " exceeds its blocks");
+                function->blocks[block].condition_terms = terms;
+                function->conditions.push_back(block);
+            }
+        } else if(tag == gcov_tag_lines) {
+            const uint32_t block = reader.read_word();
+            if(block >= function->blocks.size())
+                throw gcda_error("lines of " + function->name + " exceed its blocks");
+            read_gcno_lines(reader, function->blocks[block]);
+        }
+
+        if(reader.position() > end)
+            throw gcda_error("gcno record exceeds its length");
+        reader.skip(end - reader.position());
+    }
+    return file;
+}
+
+gcovhost::gcno_file gcovhost::read_gcno(const std::string& path) {
+    const mapped_file file(path);
+    try {
+        return parse_gcno(file.data(), file.size());
+    } catch(const gcda_error& error) {
+        throw gcda_error(path + ": " + error.what());
+    }
+}
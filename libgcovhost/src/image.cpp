@@ -0,0 +1,610 @@
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <optional>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <tuple>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+}
+
+#include "gcovhost/image.hpp"
+
+namespace {
+
+constexpr char end_marker[] = "Gcov End";
+
+constexpr char record_marker[] = GCOV_IMAGE_RECORD_MARKER;
+constexpr size_t record_marker_size = sizeof(record_marker) - 1U;
+constexpr size_t crc_size = 4U;
+
+using crc_tables = std::array<std::array<uint32_t, 256U>, 8U>;
+
+/*! \brief Calculates the tables of the slicing-by-8 CRC-32
+ *
+ *  Table k holds the CRC-32 of a byte followed by k zero bytes.
+ */
+constexpr crc_tables make_crc_tables() {
+    crc_tables tables{};
+    for(uint32_t byte = 0U; byte < tables[0].size(); ++byte) {
+        uint32_t crc = byte;
+        for(unsigned bit = 0U; bit < 8U; ++bit)
+            crc = (crc >> 1U) ^ (0xEDB8'8320U & (0U - (crc & 1U)));
+        tables[0][byte] = crc;
+    }
+    for(size_t table = 1U; table < tables.size(); ++table)
+        for(size_t byte = 0U; byte < tables[table].size(); ++byte)
+            tables[table][byte] =
+                (tables[table - 1U][byte] >> 8U) ^ tables[0][tables[table - 1U][byte] & 0xFFU];
+    return tables;
+}
+
+constexpr crc_tables crc_table = make_crc_tables();
+
+/*! \brief Calculates the table which drops a byte in front of a chunk from its CRC-32
+ *
+ *  Entry b is the CRC-32 register of the byte b followed by a chunk of zeros without the
+ *  initial value, so the register of a window sliding over the image is updated per byte.
+ */
+constexpr std::array<uint32_t, 256U> make_window_table() {
+    std::array<uint32_t, 256U> table{};
+    for(uint32_t byte = 0U; byte < table.size(); ++byte) {
+        uint32_t crc = crc_table[0][byte ^ 0xFFU] ^ 0xFF00'0000U;
+        for(size_t idx = 0U; idx < GCOV_IMAGE_CHUNK_SIZE; ++idx)
+            crc = (crc >> 8U) ^ crc_table[0][crc & 0xFFU];
+        table[byte] = crc;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256U> window_table = make_window_table();
+
+uint32_t read_be32(const uint8_t* data) {
+    return (uint32_t(data[0]) << 24U) | (uint32_t(data[1]) << 16U) | (uint32_t(data[2]) << 8U)
+           | uint32_t(data[3]);
+}
+
+bool is_end_marker(const uint8_t* data, const size_t size, const size_t pos) {
+    return size - pos >= sizeof(end_marker) && !memcmp(data + pos, end_marker, sizeof(end_marker));
+}
+
+bool is_gcda(const uint8_t* data, const size_t size, const size_t pos) {
+    if(size - pos < GCOV_WORD_SIZE)
+        return false;
+    const uint32_t magic = read_be32(data + pos);
+    return magic == GCOV_DATA_MAGIC || __builtin_bswap32(magic) == GCOV_DATA_MAGIC;
+}
+
+/*! \brief Reads the path in front of the gcda data of a record
+ *
+ *  \param[in]  data    The raw image
+ *  \param[in]  size    The size of the image
+ *  \param[in]  pos     The position of the record
+ *  \return             The position of the terminating null char, size if there is none
+ */
+size_t find_path_end(const uint8_t* data, const size_t size, const size_t pos) {
+    const void* path_end = memchr(data + pos, '\0', size - pos);
+    return path_end ? size_t(static_cast<const uint8_t*>(path_end) - data) : size;
+}
+
+/*! \brief Reads the table of contents of an image since version 3
+ *
+ *  \return The record offset, data offset and data length of each record, nothing if the image
+ *          has no valid table of contents, e.g. because it was truncated
+ */
+std::optional<std::vector<std::tuple<uint32_t, uint32_t, uint32_t>>>
+    read_toc(const uint8_t* data, const size_t size, const size_t header_size) {
+    const size_t trailer_end = size - sizeof(end_marker);
+    if(size < header_size + GCOV_IMAGE_TRAILER_SIZE + sizeof(end_marker)
+       || !is_end_marker(data, size, trailer_end))
+        return std::nullopt;
+    const size_t trailer = trailer_end - GCOV_IMAGE_TRAILER_SIZE;
+    const uint64_t toc_offset = read_be32(data + trailer);
+    const uint64_t count = read_be32(data + trailer + 4U);
+    if(toc_offset < header_size || toc_offset + count * GCOV_IMAGE_TOC_ENTRY_SIZE != trailer)
+        return std::nullopt;
+
+    std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> toc;
+    toc.reserve(count);
+    for(const uint8_t* entry = data + toc_offset; entry != data + trailer;
+        entry += GCOV_IMAGE_TOC_ENTRY_SIZE)
+        toc.emplace_back(read_be32(entry), read_be32(entry + 4U), read_be32(entry + 8U));
+    return toc;
+}
+
+/*! \brief The payload of a checked image, the bytes without the chunk CRC-32s
+ */
+struct checked_payload {
+    std::vector<uint8_t> bytes;                          //!< The payload bytes
+    std::vector<std::pair<size_t, size_t>> corrupted;    //!< The ranges of corrupted chunks
+    bool shifted = false;                                //!< Set if bytes were lost or inserted
+    bool complete = false;                               //!< Set if the last chunk was found
+
+    /*! \brief Checks whether a payload range holds bytes of corrupted chunks
+     */
+    bool is_corrupted(const size_t begin, const size_t end) const {
+        return std::any_of(corrupted.begin(), corrupted.end(), [&](const auto& range) {
+            return range.first < end && begin < range.second;
+        });
+    }
+};
+
+/*! \brief Checks whether a chunk of a checked image starts at a position
+ *
+ *  \param[in]  data    The raw image
+ *  \param[in]  size    The size of the image
+ *  \param[in]  pos     The position of the chunk
+ *  \param[in]  length  The number of payload bytes of the chunk
+ *  \return             True if the CRC-32 behind the payload matches
+ */
+bool is_chunk(const uint8_t* data, const size_t size, const size_t pos, const size_t length) {
+    if(size - pos < length + crc_size)
+        return false;
+    uint32_t crc = 0U;
+    if(!pos) {
+        // the first chunk was calculated with the length and the CRC-32 of the header zero
+        if(length < GCOV_IMAGE_HEADER_SIZE)
+            return false;
+        const uint8_t zeros[8] = {};
+        crc = gcovhost::crc32(data, GCOV_IMAGE_LENGTH_OFFSET);
+        crc = gcovhost::crc32(zeros, sizeof(zeros), crc);
+        crc = gcovhost::crc32(
+            data + GCOV_IMAGE_HEADER_SIZE, length - GCOV_IMAGE_HEADER_SIZE, crc);
+    } else {
+        crc = gcovhost::crc32(data + pos, length);
+    }
+    return crc == read_be32(data + pos + length);
+}
+
+/*! \brief Finds the first chunk of the full size which starts in a range of positions
+ *
+ *  \param[in]  data    The raw image
+ *  \param[in]  size    The size of the image
+ *  \param[in]  first   The first position to check, not the start of the image
+ *  \param[in]  last    The last position to check
+ *  \return             The position of the chunk, 0 if there is none
+ *
+ *  The CRC-32 of the window is updated per position instead of calculated again.
+ */
+size_t find_full_chunk(const uint8_t* data, const size_t size, const size_t first, size_t last) {
+    if(size < GCOV_IMAGE_CHUNK_SIZE + crc_size)
+        return 0U;
+    last = std::min(last, size - GCOV_IMAGE_CHUNK_SIZE - crc_size);
+    if(first > last)
+        return 0U;
+    uint32_t crc = ~gcovhost::crc32(data + first, GCOV_IMAGE_CHUNK_SIZE);
+    for(size_t pos = first;; ++pos) {
+        if(~crc == read_be32(data + pos + GCOV_IMAGE_CHUNK_SIZE))
+            return pos;
+        if(pos == last)
+            return 0U;
+        const uint8_t next = data[pos + GCOV_IMAGE_CHUNK_SIZE];
+        crc = (crc >> 8U) ^ crc_table[0][(crc ^ next) & 0xFFU] ^ window_table[data[pos]];
+    }
+}
+
+/*! \brief Removes the chunk CRC-32s of a checked image and collects the corrupted chunks
+ *
+ *  \param[in]  data    The raw image
+ *  \param[in]  size    The size of the image
+ *  \return             The payload of the image
+ *
+ *  Behind a corrupted chunk the next chunk is expected at its regular position. If it is not
+ *  there either, bytes were lost or inserted. Then the next record marker is searched and the
+ *  chunk holding it is looked for in front of it, or the last chunk of the image if no marker
+ *  follows. The intact chunks in front of the found one are taken as well. The last chunk is
+ *  shorter and ends with the end marker of the image.
+ */
+checked_payload read_chunks(const uint8_t* data, const size_t size) {
+    std::vector<size_t> image_ends;
+    for(size_t pos = 0U; pos < size;) {
+        const void* marker = memmem(data + pos, size - pos, end_marker, sizeof(end_marker));
+        if(!marker)
+            break;
+        pos = size_t(static_cast<const uint8_t*>(marker) - data) + sizeof(end_marker);
+        image_ends.push_back(pos);
+    }
+    // returns the payload length of the chunk at pos, 0 if there is none
+    const auto find_chunk = [&](const size_t pos) -> size_t {
+        if(is_chunk(data, size, pos, GCOV_IMAGE_CHUNK_SIZE))
+            return GCOV_IMAGE_CHUNK_SIZE;
+        for(auto end = std::upper_bound(image_ends.begin(), image_ends.end(), pos);
+            end != image_ends.end() && *end - pos < GCOV_IMAGE_CHUNK_SIZE; ++end)
+            if(is_chunk(data, size, pos, *end - pos))
+                return *end - pos;
+        return 0U;
+    };
+    constexpr size_t raw_chunk_size = GCOV_IMAGE_CHUNK_SIZE + crc_size;
+    // returns the position of the first chunk behind pos on a new grid, size if there is none
+    const auto resync = [&](const size_t pos) -> size_t {
+        const auto image_end = std::upper_bound(image_ends.begin(), image_ends.end(), pos);
+        const size_t end = image_end != image_ends.end() ? *image_end : size;
+        size_t found = 0U;
+        for(size_t from = pos + 1U; !found && from < end;) {
+            const void* marker = memmem(data + from, end - from, record_marker, record_marker_size);
+            if(!marker)
+                break;
+            // a chunk holding the whole marker starts less than a chunk in front of it
+            const size_t offset = size_t(static_cast<const uint8_t*>(marker) - data);
+            const size_t reach = GCOV_IMAGE_CHUNK_SIZE - record_marker_size;
+            found = find_full_chunk(data, size, std::max(from, offset - std::min(offset, reach)),
+                                    offset);
+            from = offset + 1U;
+        }
+        // behind the last record only the table of contents and the last chunk are left
+        if(!found && image_end != image_ends.end()) {
+            const size_t first = end - std::min<size_t>(end, GCOV_IMAGE_CHUNK_SIZE);
+            for(size_t start = std::max(pos + 1U, first); !found && start < end; ++start)
+                if(is_chunk(data, size, start, end - start))
+                    found = start;
+        }
+        if(!found)
+            return size;
+        // records whose marker was cut by a chunk CRC-32 lie in the chunks in front of it
+        while(found > pos + raw_chunk_size
+              && is_chunk(data, size, found - raw_chunk_size, GCOV_IMAGE_CHUNK_SIZE))
+            found -= raw_chunk_size;
+        return found;
+    };
+
+    checked_payload payload;
+    payload.bytes.reserve(size);
+    size_t pos = 0U;
+    while(pos < size) {
+        if(const size_t length = find_chunk(pos)) {
+            payload.bytes.insert(payload.bytes.end(), data + pos, data + pos + length);
+            pos += length + crc_size;
+            if(std::binary_search(image_ends.begin(), image_ends.end(), pos - crc_size)) {
+                payload.complete = true;
+                break;
+            }
+            continue;
+        }
+
+        size_t next = pos + raw_chunk_size;
+        if(next >= size || !find_chunk(next))
+            next = resync(pos);
+        const size_t begin = payload.bytes.size();
+        if((next - pos) % raw_chunk_size == 0U) {
+            // only the chunks are corrupted, the payload keeps its offsets
+            for(; pos != next; pos += raw_chunk_size)
+                payload.bytes.insert(
+                    payload.bytes.end(), data + pos, data + pos + GCOV_IMAGE_CHUNK_SIZE);
+        } else {
+            payload.shifted = true;
+            payload.bytes.insert(payload.bytes.end(), data + pos, data + next);
+            pos = next;
+        }
+        payload.corrupted.emplace_back(begin, payload.bytes.size());
+    }
+    return payload;
+}
+
+/*! \brief Returns the path of a dropped record if its bytes are intact
+ *
+ *  \param[in]  payload The payload of the image
+ *  \param[in]  pos     The position of the path
+ *  \return             The path, empty if it is corrupted or no gcda data follows it
+ */
+std::string lost_path(const checked_payload& payload, const size_t pos) {
+    const uint8_t* bytes = payload.bytes.data();
+    const size_t size = payload.bytes.size();
+    const size_t path_end = find_path_end(bytes, size, pos);
+    if(path_end == size || payload.is_corrupted(pos, path_end + 1U + GCOV_WORD_SIZE)
+       || !is_gcda(bytes, size, path_end + 1U))
+        return {};
+    return std::string(reinterpret_cast<const char*>(bytes + pos), path_end - pos);
+}
+
+/*! \brief Reads the records of a checked image
+ *
+ *  \param[in]      payload     The payload of the image
+ *  \param[in]      header_size The size of the image header
+ *  \param[in,out]  image       The image to add the records to
+ *
+ *  As long as the table of contents is intact and no bytes were lost, each record listed in it
+ *  is checked. Otherwise the records are found by their markers, a marker which is not followed
+ *  by a valid record is skipped and the search for the next one continues behind it.
+ */
+void parse_checked_records(const checked_payload& payload,
+                           const size_t header_size,
+                           gcovhost::image& image) {
+    const uint8_t* bytes = payload.bytes.data();
+    const size_t size = payload.bytes.size();
+    const bool packed = image.flags & GCOV_IMAGE_PACKED_COUNTERS;
+    image.truncated = !payload.complete;
+
+    std::optional<std::vector<std::tuple<uint32_t, uint32_t, uint32_t>>> toc;
+    if(payload.complete && !payload.shifted)
+        toc = read_toc(bytes, size, header_size);
+    if(toc) {
+        const size_t toc_offset = size - sizeof(end_marker) - GCOV_IMAGE_TRAILER_SIZE
+                                  - toc->size() * GCOV_IMAGE_TOC_ENTRY_SIZE;
+        if(payload.is_corrupted(toc_offset, size))
+            toc.reset();
+    }
+    if(toc) {
+        for(const auto& [record_offset, data_offset, length] : *toc) {
+            // the CRC-32 of the record follows the zero tag behind its data
+            const size_t crc_offset = size_t(data_offset) + length + GCOV_WORD_SIZE;
+            if(record_offset < data_offset && data_offset <= size
+               && size - data_offset >= size_t(length) + GCOV_WORD_SIZE + crc_size
+               && gcovhost::crc32(bytes + record_offset, crc_offset - record_offset)
+                      == read_be32(bytes + crc_offset)) {
+                image.records.push_back(
+                    {std::string(reinterpret_cast<const char*>(bytes + record_offset),
+                                 data_offset - record_offset - 1U),
+                     gcovhost::parse_gcda(bytes + data_offset, length, packed)});
+            } else {
+                image.lost.push_back(
+                    {record_offset, record_offset < size ? lost_path(payload, record_offset)
+                                                         : std::string()});
+            }
+        }
+        return;
+    }
+
+    // the table of contents is left out of the search as long as the trailer tells its size
+    size_t records_end = size;
+    std::optional<size_t> count;
+    if(payload.complete
+       && size - header_size >= GCOV_IMAGE_TRAILER_SIZE + sizeof(end_marker)) {
+        const size_t trailer = size - sizeof(end_marker) - GCOV_IMAGE_TRAILER_SIZE;
+        const size_t entries = read_be32(bytes + trailer + 4U);
+        if(!payload.is_corrupted(trailer, size)
+           && uint64_t(entries) * GCOV_IMAGE_TOC_ENTRY_SIZE <= trailer - header_size) {
+            records_end = trailer - entries * GCOV_IMAGE_TOC_ENTRY_SIZE;
+            count = entries;
+        }
+    }
+
+    // the ranges holding valid records or markers of dropped ones
+    std::vector<std::pair<size_t, size_t>> explained;
+    size_t pos = header_size;
+    while(pos < records_end) {
+        const void* found =
+            memmem(bytes + pos, records_end - pos, record_marker, record_marker_size);
+        if(!found)
+            break;
+        const size_t marker = size_t(static_cast<const uint8_t*>(found) - bytes);
+        const size_t record = marker + record_marker_size;
+        // a dropped record extends up to the next marker
+        if(!explained.empty() && explained.back().second == records_end)
+            explained.back().second = marker;
+
+        const size_t path_end = find_path_end(bytes, size, record);
+        if(path_end != size && is_gcda(bytes, size, path_end + 1U)) {
+            try {
+                size_t consumed = 0U;
+                gcovhost::gcda_file file = gcovhost::parse_gcda(
+                    bytes + path_end + 1U, size - path_end - 1U, packed, &consumed);
+                const size_t crc_offset = path_end + 1U + consumed;
+                if(size - crc_offset >= crc_size
+                   && gcovhost::crc32(bytes + record, crc_offset - record)
+                          == read_be32(bytes + crc_offset)) {
+                    image.records.push_back(
+                        {std::string(reinterpret_cast<const char*>(bytes + record),
+                                     path_end - record),
+                         std::move(file)});
+                    pos = crc_offset + crc_size;
+                    explained.emplace_back(marker, pos);
+                    continue;
+                }
+            } catch(const gcovhost::gcda_error&) {
+                // the record is reported as lost below
+            }
+        }
+        image.lost.push_back({record, lost_path(payload, record)});
+        explained.emplace_back(marker, records_end);
+        pos = marker + 1U;
+    }
+
+    // corrupted bytes outside of all records held records whose marker was corrupted as well
+    std::vector<size_t> unexplained;
+    for(const auto& [begin, end] : payload.corrupted) {
+        size_t offset = std::max(begin, header_size);
+        for(const auto& [first, last] : explained)
+            if(first <= offset && offset < last)
+                offset = last;
+        if(offset < std::min(end, records_end))
+            unexplained.push_back(offset);
+    }
+    // records lost together with their marker are only counted by the trailer
+    size_t unknown = unexplained.size();
+    if(count) {
+        const size_t found = image.records.size() + image.lost.size();
+        unknown = *count > found ? *count - found : 0U;
+    }
+    for(size_t idx = 0U; idx < unknown; ++idx) {
+        size_t offset = header_size;
+        if(!unexplained.empty())
+            offset = unexplained[std::min(idx, unexplained.size() - 1U)];
+        else if(!payload.corrupted.empty())
+            offset = payload.corrupted.front().first;
+        image.lost.push_back({offset, std::string()});
+    }
+    std::sort(image.lost.begin(), image.lost.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.offset < rhs.offset;
+    });
+}
+
+/*! \brief Splits an image of the legacy headerless layout
+ */
+void parse_legacy_records(const uint8_t* data, const size_t size, gcovhost::image& image) {
+    size_t pos = 0U;
+    while(pos < size && !is_end_marker(data, size, pos)) {
+        const size_t path_end = find_path_end(data, size, pos);
+        if(size - path_end < 5U)
+            throw gcovhost::image_error("legacy image is truncated");
+        const size_t length = read_be32(data + path_end + 1U);
+        const size_t data_start = path_end + 5U;
+        if(size - data_start < length)
+            throw gcovhost::image_error("record exceeds the legacy image");
+        image.records.push_back(
+            {std::string(reinterpret_cast<const char*>(data + pos), path_end - pos),
+             gcovhost::parse_gcda(data + data_start, length, false)});
+        pos = data_start + length;
+    }
+}
+
+}
+
+gcovhost::mapped_file::mapped_file(const std::string& path) : address(nullptr), length(0U) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+        throw image_error(path + ": " + strerror(errno));
+    struct stat status;
+    if(fstat(fd, &status) != 0 || status.st_size == 0) {
+        close(fd);
+        throw image_error(path + ": empty or unreadable file");
+    }
+    void* mapping = mmap(nullptr, size_t(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(mapping == MAP_FAILED)
+        throw image_error(path + ": " + strerror(errno));
+    address = static_cast<const uint8_t*>(mapping);
+    length = size_t(status.st_size);
+}
+
+gcovhost::mapped_file::~mapped_file() {
+    munmap(const_cast<uint8_t*>(address), length);
+}
+
+uint32_t gcovhost::crc32(const uint8_t* data, size_t size, uint32_t crc) {
+    crc = ~crc;
+    // eight bytes at once, the lookups of one round are independent of each other
+    for(; size >= 8U; data += 8U, size -= 8U) {
+        const uint32_t word = uint32_t(data[0]) | (uint32_t(data[1]) << 8U)
+                              | (uint32_t(data[2]) << 16U) | (uint32_t(data[3]) << 24U);
+        const uint32_t low = crc ^ word;
+        crc = crc_table[7][low & 0xFFU] ^ crc_table[6][(low >> 8U) & 0xFFU]
+              ^ crc_table[5][(low >> 16U) & 0xFFU] ^ crc_table[4][low >> 24U]
+              ^ crc_table[3][data[4]] ^ crc_table[2][data[5]] ^ crc_table[1][data[6]]
+              ^ crc_table[0][data[7]];
+    }
+    while(size--)
+        crc = (crc >> 8U) ^ crc_table[0][(crc ^ *data++) & 0xFFU];
+    return ~crc;
+}
+
+gcovhost::image_state
+    gcovhost::check_image(const uint8_t* data, const size_t size, size_t& length) {
+    length = 0U;
+    if(size < GCOV_IMAGE_HEADER_SIZE || data[4] < 4U)
+        return image_state::unfinished;
+    length = read_be32(data + GCOV_IMAGE_LENGTH_OFFSET);
+    if(!length)
+        return image_state::unfinished;
+    if(length > size)
+        return image_state::truncated;
+    // checked images end with the CRC-32 of their last chunk
+    const size_t tail = sizeof(end_marker) + ((data[5] & GCOV_IMAGE_CHECKED) ? crc_size : 0U);
+    if(length < GCOV_IMAGE_HEADER_SIZE + GCOV_IMAGE_TRAILER_SIZE + tail
+       || !is_end_marker(data, length, length - tail))
+        return image_state::corrupted;
+
+    // the CRC-32 was calculated with the length and the CRC-32 zero
+    const uint8_t zeros[8] = {};
+    uint32_t crc = crc32(data, GCOV_IMAGE_LENGTH_OFFSET);
+    crc = crc32(zeros, sizeof(zeros), crc);
+    crc = crc32(data + GCOV_IMAGE_HEADER_SIZE, length - GCOV_IMAGE_HEADER_SIZE, crc);
+    return crc == read_be32(data + GCOV_IMAGE_LENGTH_OFFSET + 4U) ? image_state::complete
+                                                                   : image_state::corrupted;
+}
+
+gcovhost::image gcovhost::parse_image(const uint8_t* data, size_t size) {
+    image parsed;
+    if(size < GCOV_IMAGE_V3_HEADER_SIZE || memcmp(data, GCOV_IMAGE_MAGIC, 4U) != 0) {
+        parse_legacy_records(data, size, parsed);
+        return parsed;
+    }
+
+    parsed.version = data[4];
+    parsed.flags = data[5];
+    parsed.sequence = uint16_t((data[6] << 8U) | data[7]);
+    if(parsed.version < 2U || parsed.version > GCOV_IMAGE_VERSION)
+        throw image_error("unsupported image version " + std::to_string(parsed.version));
+    const bool packed = parsed.flags & GCOV_IMAGE_PACKED_COUNTERS;
+    const size_t header_size =
+        parsed.version >= 4U ? GCOV_IMAGE_HEADER_SIZE : GCOV_IMAGE_V3_HEADER_SIZE;
+
+    size_t length = 0U;
+    switch(check_image(data, size, length)) {
+    case image_state::complete:
+        // bytes behind the image, e.g. the rest of the buffer, are ignored
+        size = length;
+        parsed.verified = true;
+        break;
+    case image_state::corrupted:
+        // the chunks of checked images tell which records are affected
+        if(!(parsed.flags & GCOV_IMAGE_CHECKED))
+            throw image_error("image length or CRC-32 does not match");
+        break;
+    default:
+        break;
+    }
+
+    if(parsed.version >= 4U && (parsed.flags & GCOV_IMAGE_CHECKED)) {
+        parse_checked_records(read_chunks(data, size), header_size, parsed);
+        return parsed;
+    }
+
+    if(parsed.version >= 3U) {
+        if(const auto toc = read_toc(data, size, header_size)) {
+            // records are parsed directly from the table of contents
+            parsed.records.reserve(toc->size());
+            for(const auto& [record_offset, data_offset, length] : *toc) {
+                if(data_offset <= record_offset || data_offset > size
+                   || size - data_offset < length)
+                    throw image_error("table of contents exceeds the image");
+                parsed.records.push_back(
+                    {std::string(reinterpret_cast<const char*>(data + record_offset),
+                                 data_offset - record_offset - 1U),
+                     parse_gcda(data + data_offset, length, packed)});
+            }
+            return parsed;
+        }
+    }
+
+    // without table of contents the records are walked up to their zero tag
+    size_t pos = header_size;
+    while(pos < size && !is_end_marker(data, size, pos)) {
+        const size_t path_end = find_path_end(data, size, pos);
+        // the table of contents behind the records ends the walk
+        if(path_end == size) {
+            parsed.truncated = true;
+            break;
+        }
+        if(!is_gcda(data, size, path_end + 1U))
+            break;
+        size_t consumed = 0U;
+        try {
+            gcda_file file =
+                parse_gcda(data + path_end + 1U, size - path_end - 1U, packed, &consumed);
+            parsed.records.push_back(
+                {std::string(reinterpret_cast<const char*>(data + pos), path_end - pos),
+                 std::move(file)});
+        } catch(const gcda_error&) {
+            // the complete records in front of the truncated one are kept
+            parsed.truncated = true;
+            break;
+        }
+        pos = path_end + 1U + consumed;
+    }
+    return parsed;
+}
+
+gcovhost::image gcovhost::read_image(const std::string& path) {
+    const mapped_file file(path);
+    return parse_image(file.data(), file.size());
+}
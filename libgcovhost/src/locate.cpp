@@ -0,0 +1,77 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+}
+
+#include "gcovhost/locate.hpp"
+
+namespace {
+
+constexpr size_t magic_size = sizeof(GCOV_IMAGE_MAGIC) - 1U;
+
+// 16 bytes, the width of SSE2 and NEON registers
+using byte_vector = uint8_t __attribute__((vector_size(16)));
+
+bool is_candidate(const uint8_t* data, const size_t size, const size_t pos) {
+    return size - pos >= GCOV_IMAGE_V3_HEADER_SIZE
+           && !memcmp(data + pos, GCOV_IMAGE_MAGIC, magic_size) && data[pos + magic_size] >= 1U
+           && data[pos + magic_size] <= GCOV_IMAGE_VERSION;
+}
+
+/*! \brief Finds the next position of the image magic followed by a known version
+ *
+ *  \return The position of the candidate, size if there is none
+ *
+ *  Two overlapping loads compare the first and the last byte of the magic for 16 positions at
+ *  once, only the rare positions matching both are compared completely. Dumps full of either
+ *  byte therefore do not slow the search down.
+ */
+size_t find_candidate(const uint8_t* data, const size_t size, size_t pos) {
+    constexpr size_t lanes = sizeof(byte_vector);
+    const byte_vector first = byte_vector{} + uint8_t(GCOV_IMAGE_MAGIC[0]);
+    const byte_vector last = byte_vector{} + uint8_t(GCOV_IMAGE_MAGIC[magic_size - 1U]);
+    for(; size - pos >= lanes + magic_size - 1U; pos += lanes) {
+        byte_vector head;
+        byte_vector tail;
+        memcpy(&head, data + pos, lanes);
+        memcpy(&tail, data + pos + magic_size - 1U, lanes);
+        const byte_vector matches = byte_vector((head == first) & (tail == last));
+        uint64_t words[2];
+        memcpy(words, &matches, sizeof(words));
+        if(!(words[0] | words[1]))
+            continue;
+        for(size_t lane = 0U; lane < lanes; ++lane) {
+            if(matches[lane] && is_candidate(data, size, pos + lane))
+                return pos + lane;
+        }
+    }
+    for(; pos < size; ++pos) {
+        if(is_candidate(data, size, pos))
+            return pos;
+    }
+    return size;
+}
+
+}
+
+std::vector<gcovhost::located_image> gcovhost::locate_images(const uint8_t* data,
+                                                             const size_t size) {
+    std::vector<located_image> images;
+    for(size_t pos = find_candidate(data, size, 0U); pos < size;) {
+        located_image image;
+        image.offset = pos;
+        image.version = data[pos + 4U];
+        image.flags = data[pos + 5U];
+        image.sequence = uint16_t((data[pos + 6U] << 8U) | data[pos + 7U]);
+        image.state = check_image(data + pos, size - pos, image.length);
+        images.push_back(image);
+        // the records of a complete image can not contain another one
+        pos = find_candidate(
+            data, size, image.state == image_state::complete ? pos + image.length : pos + 1U);
+    }
+    return images;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "gcovhost/gcda.hpp"
+
+namespace gcovhost {
+
+/*! \brief Reads words, strings and LEB128 values from gcda and gcno data in the byte order of
+ *         their writer
+ *
+ *  Throws gcda_error if the data ends before the requested value.
+ */
+class record_reader {
+public:
+    record_reader(const uint8_t* data, const size_t size) : data(data), size(size), pos(0U) {
+    }
+
+    void set_big_endian(const bool value) {
+        big_endian = value;
+    }
+
+    bool at_end() const {
+        return pos >= size;
+    }
+
+    size_t position() const {
+        return pos;
+    }
+
+    size_t remaining() const {
+        return size - pos;
+    }
+
+    uint32_t read_word() {
+        require(4U);
+        const uint8_t* bytes = data + pos;
+        pos += 4U;
+        if(big_endian)
+            return (uint32_t(bytes[0]) << 24U) | (uint32_t(bytes[1]) << 16U)
+                   | (uint32_t(bytes[2]) << 8U) | uint32_t(bytes[3]);
+        return (uint32_t(bytes[3]) << 24U) | (uint32_t(bytes[2]) << 16U)
+               | (uint32_t(bytes[1]) << 8U) | uint32_t(bytes[0]);
+    }
+
+    uint64_t read_counter() {
+        // 64 bit counters are stored as two words, the low part first
+        const uint64_t low = read_word();
+        return low | (uint64_t(read_word()) << 32U);
+    }
+
+    uint64_t read_leb128() {
+        uint64_t value = 0U;
+        for(unsigned shift = 0U;; shift += 7U) {
+            require(1U);
+            const uint8_t byte = data[pos++];
+            if(shift < 64U)
+                value |= uint64_t(byte & 0x7FU) << shift;
+            if(!(byte & 0x80U))
+                return value;
+        }
+    }
+
+    const uint8_t* read_bytes(const size_t bytes) {
+        require(bytes);
+        const uint8_t* start = data + pos;
+        pos += bytes;
+        return start;
+    }
+
+    std::string read_string() {
+        // the length includes the terminating null char, 0 for a null string
+        const uint32_t length = read_word();
+        require(length);
+        const char* string = reinterpret_cast<const char*>(data + pos);
+        pos += length;
+        return length ? std::string(string, strnlen(string, length)) : std::string();
+    }
+
+    void skip(const size_t bytes) {
+        require(bytes);
+        pos += bytes;
+    }
+
+private:
+    void require(const size_t bytes) const {
+        if(size - pos < bytes)
+            throw gcda_error("gcda data is truncated");
+    }
+
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool big_endian = false;
+};
+
+}
@@ -0,0 +1,196 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+}
+
+#include "gcovhost/image.hpp"
+#include "gcovhost/test_matrix.hpp"
+
+namespace {
+
+constexpr char matrix_magic[] = "GCTM";
+constexpr uint32_t matrix_version = 1U;
+//! The magic, the version, the number of tests and functions and the size of the string table
+constexpr size_t matrix_header_size = 5U * 4U;
+//! The ident and the offsets of the path, the name and the source in the string table
+constexpr size_t matrix_function_size = 4U * 4U;
+
+void append_le(std::vector<uint8_t>& data, const uint64_t value, const size_t size) {
+    for(size_t idx = 0U; idx < size; ++idx)
+        data.push_back(uint8_t(value >> (8U * idx)));
+}
+
+uint64_t read_le(const uint8_t* data, const size_t size) {
+    uint64_t value = 0U;
+    for(size_t idx = 0U; idx < size; ++idx)
+        value |= uint64_t(data[idx]) << (8U * idx);
+    return value;
+}
+
+/*! \brief Collects the strings of the matrix, equal strings are stored once
+ */
+class string_table {
+public:
+    uint32_t add(const std::string& text) {
+        const auto [entry, added] = offsets.emplace(text, uint32_t(data.size()));
+        if(added)
+            data.insert(data.end(), text.c_str(), text.c_str() + text.size() + 1U);
+        return entry->second;
+    }
+
+    const std::vector<uint8_t>& bytes() const {
+        return data;
+    }
+
+private:
+    std::map<std::string, uint32_t> offsets;
+    std::vector<uint8_t> data;
+};
+
+/*! \brief Reads a string of the string table
+ */
+std::string read_string(const uint8_t* table, const size_t size, const uint32_t offset) {
+    const void* end = offset < size ? memchr(table + offset, '\0', size - offset) : nullptr;
+    if(!end)
+        throw gcovhost::test_matrix_error("string exceeds the string table");
+    return std::string(reinterpret_cast<const char*>(table + offset),
+                       static_cast<const uint8_t*>(end) - (table + offset));
+}
+
+size_t align8(const size_t size) {
+    return (size + 7U) & ~size_t{7U};
+}
+
+}
+
+void gcovhost::test_matrix_builder::add_image(const image& test_image) {
+    if(!(test_image.flags & GCOV_IMAGE_TEST))
+        throw test_matrix_error("the image was not written by gcov_end_test()");
+    std::vector<size_t>& column = columns[test_image.sequence];
+    for(const image_record& record : test_image.records) {
+        for(const gcda_function& function : record.data.functions) {
+            const auto entry =
+                functions.emplace(std::make_pair(record.path, function.ident), functions.size());
+            column.push_back(entry.first->second);
+        }
+    }
+}
+
+gcovhost::test_matrix gcovhost::test_matrix_builder::build() const {
+    test_matrix matrix;
+    // the map is ordered by path and ident, so is the matrix
+    std::vector<size_t> row_of(functions.size());
+    for(const auto& [key, function_idx] : functions) {
+        row_of[function_idx] = matrix.functions.size();
+        matrix_function function;
+        function.path = key.first;
+        function.ident = key.second;
+        matrix.functions.push_back(std::move(function));
+    }
+
+    for(const auto& column : columns)
+        matrix.tests.push_back(column.first);
+    const size_t words = matrix.words_per_row();
+    matrix.rows.assign(matrix.functions.size() * words, 0U);
+    size_t test_idx = 0U;
+    for(const auto& column : columns) {
+        for(const size_t function_idx : column.second)
+            matrix.rows[row_of[function_idx] * words + test_idx / 64U] |= uint64_t{1U}
+                                                                          << (test_idx % 64U);
+        ++test_idx;
+    }
+    return matrix;
+}
+
+std::vector<uint8_t> gcovhost::serialize_test_matrix(const test_matrix& matrix) {
+    string_table strings;
+    std::vector<uint8_t> entries;
+    for(const matrix_function& function : matrix.functions) {
+        append_le(entries, function.ident, 4U);
+        append_le(entries, strings.add(function.path), 4U);
+        append_le(entries, strings.add(function.name), 4U);
+        append_le(entries, strings.add(function.source), 4U);
+    }
+
+    std::vector<uint8_t> data(matrix_magic, matrix_magic + 4U);
+    append_le(data, matrix_version, 4U);
+    append_le(data, matrix.tests.size(), 4U);
+    append_le(data, matrix.functions.size(), 4U);
+    append_le(data, strings.bytes().size(), 4U);
+    for(const uint32_t test : matrix.tests)
+        append_le(data, test, 4U);
+    data.insert(data.end(), entries.begin(), entries.end());
+    data.insert(data.end(), strings.bytes().begin(), strings.bytes().end());
+    // the rows start at a multiple of 8 bytes
+    data.resize(align8(data.size()), 0U);
+    data.reserve(data.size() + matrix.rows.size() * 8U);
+    for(const uint64_t word : matrix.rows)
+        append_le(data, word, 8U);
+    return data;
+}
+
+gcovhost::test_matrix_file::test_matrix_file(const std::string& path) : file(path) {
+    const uint8_t* data = file.data();
+    const size_t size = file.size();
+    if(size < matrix_header_size || memcmp(data, matrix_magic, 4U) != 0)
+        throw test_matrix_error(path + ": missing test matrix magic");
+    if(read_le(data + 4U, 4U) != matrix_version)
+        throw test_matrix_error(path + ": unsupported test matrix version");
+    const size_t test_count = read_le(data + 8U, 4U);
+    const size_t function_count = read_le(data + 12U, 4U);
+    const size_t string_size = read_le(data + 16U, 4U);
+
+    // the counts are 32 bit, so the sizes do not overflow
+    const size_t words = (test_count + 63U) / 64U;
+    const size_t tests_pos = matrix_header_size;
+    const size_t functions_pos = tests_pos + test_count * 4U;
+    const size_t strings_pos = functions_pos + function_count * matrix_function_size;
+    const size_t rows_pos = align8(strings_pos + string_size);
+    if(rows_pos > size || (words && (size - rows_pos) / 8U / words < function_count))
+        throw test_matrix_error(path + ": test matrix is truncated");
+
+    test_ids.resize(test_count);
+    for(size_t test_idx = 0U; test_idx < test_count; ++test_idx)
+        test_ids[test_idx] = uint32_t(read_le(data + tests_pos + test_idx * 4U, 4U));
+    function_entries.resize(function_count);
+    const uint8_t* strings = data + strings_pos;
+    try {
+        for(size_t function_idx = 0U; function_idx < function_count; ++function_idx) {
+            const uint8_t* entry = data + functions_pos + function_idx * matrix_function_size;
+            matrix_function& function = function_entries[function_idx];
+            function.ident = uint32_t(read_le(entry, 4U));
+            function.path = read_string(strings, string_size, uint32_t(read_le(entry + 4U, 4U)));
+            function.name = read_string(strings, string_size, uint32_t(read_le(entry + 8U, 4U)));
+            function.source =
+                read_string(strings, string_size, uint32_t(read_le(entry + 12U, 4U)));
+        }
+    } catch(const test_matrix_error& error) {
+        throw test_matrix_error(path + ": " + error.what());
+    }
+    rows = data + rows_pos;
+}
+
+std::vector<uint32_t> gcovhost::test_matrix_file::select_tests(
+    const std::vector<size_t>& functions) const {
+    const size_t words = (test_ids.size() + 63U) / 64U;
+    std::vector<uint64_t> selected(words, 0U);
+    for(const size_t function_idx : functions) {
+        const uint8_t* row = rows + function_idx * words * 8U;
+        for(size_t word_idx = 0U; word_idx < words; ++word_idx)
+            selected[word_idx] |= read_le(row + word_idx * 8U, 8U);
+    }
+
+    std::vector<uint32_t> tests;
+    for(size_t word_idx = 0U; word_idx < words; ++word_idx) {
+        for(uint64_t word = selected[word_idx]; word; word &= word - 1U)
+            tests.push_back(test_ids[word_idx * 64U + size_t(__builtin_ctzll(word))]);
+    }
+    return tests;
+}
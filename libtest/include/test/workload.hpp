@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace test {
+
+/*! \brief A message of the protocol handled by process_messages()
+ */
+struct message {
+    uint32_t type;             //!< The handler of the message, unknown types are skipped
+    uint32_t length;           //!< The length of the payload in bytes
+    const uint8_t* payload;    //!< The payload
+};
+
+extern uint64_t process_messages(const message* messages, size_t count, uint32_t block_size);
+}
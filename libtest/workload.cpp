@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "test/workload.hpp"
+
+// The handlers are called indirectly and divide by the block size, the workload of the
+// profile-guided optimization benchmark, see bench/pgo_bench.cpp.
+namespace {
+
+using message_handler = uint64_t (*)(const test::message&, uint32_t);
+
+uint64_t sum_payload(const test::message& message, const uint32_t block_size) {
+    uint8_t block[64];
+    uint64_t sum = 0U;
+    for(uint32_t offset = 0U, size = 0U; offset < message.length; offset += size) {
+        size = std::min({message.length - offset, block_size, uint32_t{sizeof(block)}});
+        memcpy(block, message.payload + offset, size);
+        for(uint32_t idx = 0U; idx < size; ++idx)
+            sum += block[idx];
+    }
+    return sum;
+}
+
+uint64_t hash_payload(const test::message& message, const uint32_t block_size) {
+    uint64_t hash = 0xCBF2'9CE4'8422'2325U;
+    for(uint32_t idx = 0U; idx < message.length; ++idx)
+        hash = (hash ^ message.payload[idx]) * 0x0100'0000'01B3U;
+    return hash % block_size;
+}
+
+uint64_t count_blocks(const test::message& message, const uint32_t block_size) {
+    return (message.length + block_size - 1U) / block_size;
+}
+
+uint64_t xor_payload(const test::message& message, const uint32_t) {
+    uint64_t value = 0U;
+    for(uint32_t idx = 0U; idx < message.length; ++idx)
+        value ^= uint64_t{message.payload[idx]} << ((idx % 8U) * 8U);
+    return value;
+}
+
+const message_handler handlers[] = {sum_payload, hash_payload, count_blocks, xor_payload};
+
+}
+
+uint64_t test::process_messages(const message* messages,
+                                 const size_t count,
+                                 const uint32_t block_size) {
+    uint64_t result = 0U;
+    for(size_t idx = 0U; idx < count; ++idx) {
+        const message& current = messages[idx];
+        if(current.type >= sizeof(handlers) / sizeof(handlers[0]))
+            continue;
+        result += handlers[current.type](current, block_size);
+        result += current.length % block_size;
+    }
+    return result;
+}
@@ -1,15 +1,21 @@
 #include <stdlib.h>
 extern "C" {
 #include <gcov/gcov.h>
+#ifdef GCOV_FILE_SINK
+#include <gcov/gcov_file_sink.h>
+#endif
 }
 
 #include <test/test.hpp>
 
 int main() {
-    unsigned char* gcov_area = new unsigned char[262144];
-    gcov_unsigned_t* gcda_area = new gcov_unsigned_t[16368];
-    set_gcov_buffer(gcov_area, 262144);
-    set_gcov_gcda_buffer(gcda_area, 16368);
+#ifdef GCOV_FILE_SINK
+    static gcov_sink file_sink;
+    static gcov_file_sink_context file_sink_context;
+    gcov_file_sink_init(&file_sink, &file_sink_context, "../output/gcov_output.bin");
+    set_gcov_sink(&file_sink);
+#endif
+    // without the file sink the image stays in gcov_output_arena (GCOV_LINKER_ARENAS)
     test::add_or_mult(3, 3, false);
     return 0;
 }
@@ -1,4 +1,7 @@
 #!/usr/bin/bash
+# Usage: make_results.sh [--gcov-lcov]
+# --gcov-lcov writes the tracefile directly from the image and the gcno files instead of writing
+# gcda files and capturing them with lcov, ctest compares both ways as gcov_lcov_capture
 cd "$(dirname "$0")"
 mkdir -p output
 cmake -S . -B build
@@ -6,10 +9,14 @@ cmake --build build
 cd build
 ./coverage
 cd ..
-python3 gcov.py -p output/gcov_output.bin
 mkdir -p results
 
-lcov --branch-coverage --mcdc-coverage --capture --directory . --output-file results/coverage.info
+if [ "$1" = "--gcov-lcov" ]; then
+    ./build/tools/gcov_lcov -o results/coverage.info output/gcov_output.bin
+else
+    python3 gcov.py -p output/gcov_output.bin
+    lcov --branch-coverage --mcdc-coverage --capture --directory . --output-file results/coverage.info
+fi
 lcov --branch-coverage --mcdc-coverage --remove results/coverage.info -o results/filtered_coverage.info \
             '/usr/include/c++/*' '/doctest/*'
 genhtml --mcdc-coverage --branch-coverage results/filtered_coverage.info --output-directory results/html
@@ -0,0 +1,24 @@
+#!/usr/bin/bash
+cd "$(dirname "$0")"
+cmake -S . -B build-bench -DCMAKE_BUILD_TYPE=Release
+cmake --build build-bench --target gcov_bench
+mkdir -p results
+
+# one run per configuration, the results are collected into one JSON array per invocation
+results=results/benchmarks-$(date -u +%Y%m%dT%H%M%SZ).json
+configurations=(
+    "-f 16 -F 32 -c 16 -z 0.5"
+    "-f 256 -F 64 -c 16 -z 0.5"
+    "-f 256 -F 64 -c 16 -z 0.0"
+    "-f 256 -F 64 -c 16 -z 0.9"
+    "-f 64 -F 16 -c 512 -z 0.5"
+    "-f 256 -F 64 -c 16 -z 0.5 -b 256"
+)
+separator="["
+for configuration in "${configurations[@]}"; do
+    printf '%s\n' "$separator" >> "$results"
+    ./build-bench/bench/gcov_bench $configuration >> "$results" || exit 1
+    separator=","
+done
+echo "]" >> "$results"
+echo "Wrote $results"
@@ -0,0 +1,17 @@
+#!/usr/bin/bash
+cd "$(dirname "$0")"
+cmake -S . -B build-bench -DCMAKE_BUILD_TYPE=Release > /dev/null || exit 1
+cmake --build build-bench --target gcov_overhead_bench gcov_overhead_bench_plain gcov_hot || exit 1
+mkdir -p results
+
+# both builds process the same messages, the instrumented one also writes its counters
+results=results/overhead-$(date -u +%Y%m%dT%H%M%SZ).json
+echo "[" > "$results"
+./build-bench/bench/gcov_overhead_bench_plain "$@" >> "$results" || exit 1
+echo "," >> "$results"
+./build-bench/bench/gcov_overhead_bench -p build-bench/overhead.bin "$@" >> "$results" || exit 1
+echo "]" >> "$results"
+
+grep -o '"variant": "[a-z]*"\|"ns_per_message": {[^}]*}' "$results" | paste - -
+echo "Wrote $results"
+./build-bench/tools/gcov_hot -n 10 build-bench/overhead.bin
@@ -0,0 +1,28 @@
+#!/usr/bin/bash
+cd "$(dirname "$0")"
+build=build-pgo
+mkdir -p results
+
+# the phases reuse one build directory, so -fprofile-use finds the gcda files of the training
+results=results/pgo-$(date -u +%Y%m%dT%H%M%SZ).json
+run_phase() {
+    local phase=$1
+    shift
+    cmake -S . -B "$build" -DCMAKE_BUILD_TYPE=Release -DGCOV_PGO_PHASE="$phase" > /dev/null || exit 1
+    cmake --build "$build" --target gcov_pgo_bench gcov_merge || exit 1
+    ./"$build"/bench/gcov_pgo_bench "$@" >> "$results" || exit 1
+}
+
+echo "[" > "$results"
+run_phase NONE
+echo "," >> "$results"
+# the training run uses other messages than the measured runs
+rm -f "$build"/pgo_profile.bin
+run_phase GENERATE -s 2 -p "$build"/pgo_profile.bin
+"$build"/tools/gcov_merge "$build"/pgo_profile.bin || exit 1
+echo "," >> "$results"
+run_phase USE
+echo "]" >> "$results"
+
+grep -o '"phase": "[A-Z]*"\|"ns_per_message": {[^}]*}' "$results" | paste - -
+echo "Wrote $results"
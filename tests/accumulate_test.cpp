@@ -0,0 +1,120 @@
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "test_support.hpp"
+
+// Sets the counters of synthesized files for several runs, merges each run into the accumulation
+// area with gcov_accumulate() and checks that the accumulated image holds the sum of the runs,
+// like gcovhost::merge_gcda() merges the images of the single runs.
+
+namespace {
+
+using gcovtest::bytes;
+using gcovtest::check;
+
+constexpr gcov_unsigned_t run_count = 3U;
+
+//! The arc counters of each file by gcda path
+using file_counters = std::map<std::string, std::vector<uint64_t>>;
+
+/*! \brief Sets the live counters to the values of a run and returns them
+ */
+file_counters run(gcovbench::synthetic_coverage& coverage, std::mt19937& random) {
+    file_counters files;
+    for(const gcov_info* info : coverage.infos()) {
+        std::vector<uint64_t>& values = files[info->filename];
+        for(unsigned function_idx = 0U; function_idx < info->n_functions; ++function_idx) {
+            const gcov_ctr_info& counters = info->functions[function_idx]->ctrs[0];
+            for(gcov_unsigned_t value_idx = 0U; value_idx < counters.num; ++value_idx) {
+                counters.values[value_idx] = random() % 4U ? gcov_type(random() % 100000U) : 0;
+                values.push_back(uint64_t(counters.values[value_idx]));
+            }
+        }
+    }
+    return files;
+}
+
+/*! \brief Returns the arc counters of all records of an image
+ */
+file_counters image_counters(const gcovhost::image& parsed) {
+    file_counters files;
+    for(const gcovhost::image_record& record : parsed.records) {
+        gcovhost::image single;
+        single.records.push_back(record);
+        files[record.path] = gcovtest::arc_counters(single);
+    }
+    return files;
+}
+
+}
+
+int main() {
+    return gcovtest::run_checks(
+        [] {
+            gcovbench::generator_config config;
+            config.files = 8U;
+            config.functions = 8U;
+            config.counters = 16U;
+            gcovbench::synthetic_coverage coverage(config);
+            gcovtest::register_files(coverage);
+            gcovtest::memory_image sink;
+
+            const size_t counter_size = coverage.counters() * sizeof(gcov_type);
+            std::vector<unsigned char> area(GCOV_ACCUMULATOR_HEADER_SIZE + counter_size + 64U);
+            check(gcov_accumulate() == -1, "the counters are accumulated without area");
+            set_gcov_accumulator(area.data(), GCOV_ACCUMULATOR_HEADER_SIZE + counter_size / 2U);
+            check(gcov_accumulate() == -1, "the counters are accumulated into a too small area");
+            set_gcov_accumulator(area.data(), area.size());
+            gcov_clear_accumulator();
+
+            std::mt19937 random(7U);
+            file_counters expected;
+            std::map<std::string, gcovhost::gcda_file> merged;
+            for(gcov_unsigned_t run_idx = 0U; run_idx < run_count; ++run_idx) {
+                const file_counters values = run(coverage, random);
+                for(const auto& [path, counters] : values) {
+                    std::vector<uint64_t>& sums = expected[path];
+                    sums.resize(counters.size());
+                    for(size_t value_idx = 0U; value_idx < counters.size(); ++value_idx)
+                        sums[value_idx] += counters[value_idx];
+                }
+                const gcovhost::image single_run = gcovtest::parse_intact(sink.dump());
+                for(const gcovhost::image_record& record : single_run.records) {
+                    const auto entry = merged.emplace(record.path, record.data);
+                    if(!entry.second)
+                        gcovhost::merge_gcda(entry.first->second, record.data);
+                }
+
+                check(gcov_accumulate() == 0, "the run is not accumulated");
+                check(gcov_accumulated_runs() == run_idx + 1U, "the runs are not counted");
+                const gcovhost::image cleared = gcovtest::parse_intact(sink.dump());
+                for(const auto& [path, counters] : image_counters(cleared))
+                    check(counters == std::vector<uint64_t>(counters.size()),
+                          "the live counters of " + path + " are not cleared by the merge");
+            }
+
+            set_gcov_image_flags(GCOV_IMAGE_ACCUMULATED);
+            const gcovhost::image accumulated = gcovtest::parse_intact(sink.dump());
+            check(accumulated.flags & GCOV_IMAGE_ACCUMULATED,
+                  "the image is not marked as accumulated");
+            check(image_counters(accumulated) == expected,
+                  "the accumulated counters are not the sum of the runs");
+            for(const gcovhost::image_record& record : accumulated.records) {
+                const gcovhost::gcda_file& file = merged.at(record.path);
+                check(record.data.runs == run_count && file.runs == run_count,
+                      "the object summary of " + record.path + " does not count the runs");
+                gcovhost::image single;
+                single.records.push_back({record.path, file});
+                check(gcovtest::arc_counters(single) == expected.at(record.path),
+                      "merge_gcda() of the run images differs from the accumulated image");
+            }
+
+            gcov_clear_accumulator();
+            check(gcov_accumulated_runs() == 0U, "the accumulation area is not cleared");
+        },
+        "the accumulated counters are the sum of the runs");
+}
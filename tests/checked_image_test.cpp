@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test_support.hpp"
+
+// Damages a checked image in the ways of a noisy debug link and checks which records the host
+// reader recovers: a corrupted chunk, bytes lost or inserted within a record, a truncated image
+// and all of them in one image.
+
+namespace {
+
+using gcovtest::bytes;
+using gcovtest::check;
+
+constexpr size_t crc_size = 4U;
+constexpr size_t record_count = 8U;
+constexpr char record_marker[] = GCOV_IMAGE_RECORD_MARKER;
+
+/*! \brief A record of the intact image
+ */
+struct record_location {
+    std::string path;    //!< The gcda path of the record
+    size_t offset;       //!< The offset of its marker in the image without the chunk CRC-32s
+};
+
+/*! \brief Returns the position in the raw image of an offset without the chunk CRC-32s
+ */
+size_t raw_offset(const size_t offset) {
+    return offset + (offset / GCOV_IMAGE_CHUNK_SIZE) * crc_size;
+}
+
+/*! \brief Locates the records of an intact checked image by their marker and path
+ */
+std::vector<record_location> locate_records(const bytes& image, const gcovhost::image& parsed) {
+    bytes payload;
+    for(size_t pos = 0U; pos < image.size(); pos += GCOV_IMAGE_CHUNK_SIZE + crc_size) {
+        const size_t length =
+            std::min<size_t>(GCOV_IMAGE_CHUNK_SIZE, image.size() - pos - crc_size);
+        payload.insert(payload.end(), image.begin() + std::ptrdiff_t(pos),
+                       image.begin() + std::ptrdiff_t(pos + length));
+    }
+    std::vector<record_location> records;
+    for(const gcovhost::image_record& record : parsed.records) {
+        std::string key = record_marker + record.path;
+        key.push_back('\0');
+        const auto found = std::search(payload.begin(), payload.end(), key.begin(), key.end());
+        check(found != payload.end(), "the marker of " + record.path + " is not found");
+        records.push_back({record.path, size_t(found - payload.begin())});
+    }
+    return records;
+}
+
+/*! \brief The damage of one scenario
+ */
+struct scenario {
+    const char* name;                   //!< Printed if the scenario fails
+    std::vector<size_t> corrupted;      //!< The records in which a chunk is corrupted
+    std::vector<size_t> inserted;       //!< The records into which junk is inserted
+    std::vector<size_t> removed;        //!< The records from which bytes are lost
+    size_t truncated = record_count;    //!< The record in which the image ends
+};
+
+/*! \brief Applies the damage of a scenario to a copy of the image
+ *
+ *  Each record is damaged 2000 bytes behind its marker, far from its path. The records are
+ *  damaged from the last one to the first one, so the offsets of the intact image stay valid.
+ */
+bytes damage(const bytes& image,
+             const std::vector<record_location>& records,
+             const scenario& test) {
+    bytes damaged = image;
+    const auto inside = [&](const size_t record) {
+        return std::ptrdiff_t(raw_offset(records[record].offset + 2000U));
+    };
+    if(test.truncated < record_count)
+        damaged.resize(size_t(inside(test.truncated)));
+    for(size_t record = std::min(test.truncated, record_count); record-- > 0U;) {
+        if(std::count(test.corrupted.begin(), test.corrupted.end(), record))
+            damaged[size_t(inside(record))] ^= 0x5AU;
+        if(std::count(test.inserted.begin(), test.inserted.end(), record))
+            damaged.insert(damaged.begin() + inside(record), 37U, uint8_t(0xA5U));
+        if(std::count(test.removed.begin(), test.removed.end(), record))
+            damaged.erase(damaged.begin() + inside(record),
+                          damaged.begin() + inside(record) + 100);
+    }
+    return damaged;
+}
+
+/*! \brief Checks that exactly the undamaged records are recovered and the damaged ones named
+ */
+void check_scenario(const bytes& image,
+                    const std::vector<record_location>& records,
+                    const scenario& test) {
+    const bytes damaged = damage(image, records, test);
+    const gcovhost::image parsed = gcovhost::parse_image(damaged.data(), damaged.size());
+
+    std::set<std::string> expected;
+    std::set<std::string> expected_lost;
+    for(size_t record = 0U; record < std::min(test.truncated, record_count); ++record) {
+        const bool intact = !std::count(test.corrupted.begin(), test.corrupted.end(), record)
+                            && !std::count(test.inserted.begin(), test.inserted.end(), record)
+                            && !std::count(test.removed.begin(), test.removed.end(), record);
+        (intact ? expected : expected_lost).insert(records[record].path);
+    }
+    std::set<std::string> recovered;
+    for(const gcovhost::image_record& record : parsed.records)
+        recovered.insert(record.path);
+    std::set<std::string> lost;
+    for(const gcovhost::lost_record& record : parsed.lost)
+        lost.insert(record.path);
+
+    const std::string name = test.name;
+    check(recovered == expected, name + ": the recovered records differ");
+    check(std::includes(lost.begin(), lost.end(), expected_lost.begin(), expected_lost.end()),
+          name + ": a damaged record is not reported by its path");
+    check(parsed.truncated == (test.truncated < record_count),
+          name + ": the truncation is not reported");
+}
+
+}
+
+int main() {
+    return gcovtest::run_checks(
+        [] {
+            // each record spans several chunks
+            gcovbench::generator_config config;
+            config.files = record_count;
+            config.functions = 8U;
+            config.counters = 64U;
+            gcovbench::synthetic_coverage coverage(config);
+            gcovtest::register_files(coverage);
+
+            gcovtest::memory_image sink;
+            set_gcov_image_flags(GCOV_IMAGE_CHECKED);
+            const bytes image = sink.dump();
+            const gcovhost::image parsed = gcovtest::parse_intact(image);
+            check(parsed.records.size() == record_count, "the intact image misses records");
+            const std::vector<record_location> records = locate_records(image, parsed);
+
+            const scenario scenarios[] = {
+                {"corrupted chunk", {3U}, {}, {}},
+                {"inserted junk", {}, {2U}, {}},
+                {"lost bytes", {}, {}, {4U}},
+                {"truncated", {}, {}, {}, 5U},
+                {"all at once", {1U}, {3U}, {5U}, 6U},
+                {"every record", {0U, 2U, 4U, 6U}, {1U, 5U}, {3U, 7U}},
+            };
+            for(const scenario& test : scenarios)
+                check_scenario(image, records, test);
+        },
+        "the undamaged records of all damaged checked images were recovered");
+}
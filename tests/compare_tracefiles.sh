@@ -0,0 +1,51 @@
+#!/usr/bin/bash
+# Usage: compare_tracefiles.sh coverage gcov_merge gcov_lcov directory
+#
+# Runs the coverage demo on libtest and writes the tracefile of its image twice, once with
+# gcov_lcov from the image and the gcno files and once with lcov --capture from the gcda files
+# gcov_merge writes below the directory. The line, branch and MC/DC records have to match, the
+# MC/DC expressions are left out since lcov and gcov_lcov name the conditions differently.
+# Exits with 77, which ctest reports as skipped, if lcov can not write MC/DC records.
+coverage=$1
+gcov_merge=$2
+gcov_lcov=$3
+work=$4
+
+# MC/DC records need lcov 2.2
+version=$(lcov --version | grep -o '[0-9]\+\.[0-9]\+' | head -n 1)
+if [ "$(printf '%s\n' 2.2 "$version" | sort -V | head -n 1)" != 2.2 ]; then
+    echo "skipped, lcov $version can not write MC/DC records"
+    exit 77
+fi
+
+rm -rf "$work"
+mkdir -p "$work/run" "$work/output" "$work/gcda"
+# the demo writes its image to ../output/gcov_output.bin
+(cd "$work/run" && "$coverage") || exit 1
+image=$work/output/gcov_output.bin
+
+"$gcov_lcov" -o "$work/direct.info" "$image" || exit 1
+
+# the gcda files are written below the directory, the gcno files are copied next to them
+"$gcov_merge" -o "$work/gcda" "$image" || exit 1
+find "$work/gcda" -name '*.gcda' | while read -r gcda; do
+    original=${gcda#"$work/gcda"}
+    cp "${original%.gcda}.gcno" "${gcda%.gcda}.gcno" || exit 1
+done || exit 1
+lcov --quiet --capture --branch-coverage --mcdc-coverage --directory "$work/gcda" \
+     --output-file "$work/captured.info" || exit 1
+
+# one line per record, prefixed with its source file and sorted
+normalize() {
+    awk -F, '/^SF:/ { source = substr($0, 4) }
+             /^DA:/ { print source "|" $1 "," $2 }
+             /^BRDA:/ { print source "|" $0 }
+             /^MCDC:/ { print source "|" $1 "," $2 "," $3 "," $4 "," $5 }' "$1" | sort
+}
+normalize "$work/direct.info" > "$work/direct.txt"
+normalize "$work/captured.info" > "$work/captured.txt"
+if ! diff "$work/captured.txt" "$work/direct.txt"; then
+    echo "the tracefile of gcov_lcov differs from the one of lcov --capture"
+    exit 1
+fi
+echo "$(wc -l < "$work/direct.txt") line, branch and MC/DC records match lcov --capture"
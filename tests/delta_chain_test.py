@@ -0,0 +1,34 @@
+# Usage: delta_chain_test.py delta_images gcov.py directory
+#
+# Runs delta_images in the directory, which writes a base image, a chain of delta images and the
+# plain image of the final counters, and checks that gcov.py rebuilds the same gcda data of each
+# file from the chain as from the plain image.
+import importlib.util
+import pathlib
+import subprocess
+import sys
+
+if len(sys.argv) != 4:
+    sys.exit("Usage: {} delta_images gcov.py directory".format(sys.argv[0]))
+delta_images, gcov_script, work = sys.argv[1:]
+
+spec = importlib.util.spec_from_file_location("gcov", gcov_script)
+gcov = importlib.util.module_from_spec(spec)
+spec.loader.exec_module(gcov)
+
+pathlib.Path(work).mkdir(parents=True, exist_ok=True)
+subprocess.run([delta_images], cwd=work, check=True)
+
+directory = pathlib.Path(work)
+deltas = sorted(directory.glob("delta_*.bin"), key=lambda path: int(path.stem.split("_")[1]))
+if not deltas:
+    sys.exit("Error: no delta images were written")
+rebuilt = gcov.rebuild_gcdas(str(directory / "base.bin"), [str(path) for path in deltas])
+_, _, expected = gcov.read_image(str(directory / "full.bin"))
+
+if rebuilt.keys() != expected.keys():
+    sys.exit("Error: the chain rebuilds other files than the plain image holds")
+for path in sorted(expected):
+    if rebuilt[path] != expected[path]:
+        sys.exit("Error: the gcda data of {} differs from the plain image".format(path))
+print("{} delta images rebuild the {} files of the plain image".format(len(deltas), len(expected)))
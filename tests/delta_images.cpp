@@ -0,0 +1,84 @@
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "test_support.hpp"
+
+// Writes a chain of delta images of synthesized files, changing other functions before each
+// dump, and the plain image of the final counters for delta_chain_test.py, which rebuilds the
+// latter from the chain with gcov.py. Each delta image has to hold exactly the changed functions.
+
+namespace {
+
+using gcovtest::bytes;
+using gcovtest::check;
+
+constexpr size_t file_count = 16U;
+constexpr size_t function_count = 8U;
+
+void write_image(const bytes& image, const std::string& path) {
+    std::ofstream output(path, std::ios::binary);
+    output.write(reinterpret_cast<const char*>(image.data()), std::streamsize(image.size()));
+    output.close();
+    check(bool(output), "can not write " + path);
+}
+
+/*! \brief Returns the idents of the functions of an image
+ */
+std::set<gcov_unsigned_t> list_functions(const gcovhost::image& parsed) {
+    std::set<gcov_unsigned_t> idents;
+    for(const gcovhost::image_record& record : parsed.records) {
+        for(const gcovhost::gcda_function& function : record.data.functions)
+            idents.insert(function.ident);
+    }
+    return idents;
+}
+
+}
+
+int main() {
+    return gcovtest::run_checks(
+        [] {
+            gcovbench::generator_config config;
+            config.files = file_count;
+            config.functions = function_count;
+            config.counters = 16U;
+            gcovbench::synthetic_coverage coverage(config);
+            gcovtest::register_files(coverage);
+            gcovtest::memory_image sink;
+
+            std::vector<gcov_function_baseline> baseline(file_count * function_count);
+            set_gcov_delta_buffer(baseline.data(), baseline.size());
+            set_gcov_image_flags(GCOV_IMAGE_DELTA);
+            const gcovhost::image base = gcovtest::parse_intact(sink.dump());
+            check(list_functions(base).size() == baseline.size(),
+                  "the base image does not hold all functions");
+            write_image(sink.image(), "base.bin");
+
+            // the functions changed before each delta dump, the second dump changes nothing and
+            // the last one a whole file and the largest counter
+            const std::vector<std::set<gcov_unsigned_t>> changes = {
+                {17U, 74U, 75U}, {}, {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 17U, 127U}};
+            for(size_t delta_idx = 0U; delta_idx < changes.size(); ++delta_idx) {
+                for(const gcov_unsigned_t ident : changes[delta_idx]) {
+                    const gcov_info* info = coverage.infos()[ident / function_count];
+                    info->functions[ident % function_count]->ctrs[0].values[0] +=
+                        gcov_type(ident == 127U ? 1 << 30 : 3);
+                }
+                const gcovhost::image delta = gcovtest::parse_intact(sink.dump());
+                const std::string name = "delta_" + std::to_string(delta_idx + 1U) + ".bin";
+                check((delta.flags & GCOV_IMAGE_DELTA) && delta.sequence == delta_idx + 2U,
+                      name + " is not marked as delta with its sequence number");
+                check(list_functions(delta) == changes[delta_idx],
+                      name + " does not hold exactly the changed functions");
+                write_image(sink.image(), name);
+            }
+
+            set_gcov_image_flags(0U);
+            write_image(sink.dump(), "full.bin");
+        },
+        "wrote a chain of delta images holding exactly the changed functions");
+}
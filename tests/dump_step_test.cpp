@@ -0,0 +1,80 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "test_support.hpp"
+
+// Writes the image of synthesized files with gcov_dump_step() and budgets of 1 byte, 64 bytes
+// and SIZE_MAX and checks that each image is byte-identical to the one of __gcov_dump(), for
+// plain, packed, checked and hit-only images.
+
+namespace {
+
+using gcovtest::bytes;
+using gcovtest::check;
+
+/*! \brief The image of a stepped dump and the number of calls it took
+ */
+struct stepped_image {
+    bytes image;          //!< The image written by the last call
+    size_t calls = 0U;    //!< The number of gcov_dump_step() calls
+};
+
+stepped_image dump_stepped(gcovtest::memory_image& sink, const size_t budget) {
+    stepped_image result;
+    int status = GCOV_DUMP_PENDING;
+    while(status == GCOV_DUMP_PENDING) {
+        status = gcov_dump_step(budget);
+        ++result.calls;
+        check(result.calls < 1000000U, "the stepped dump does not end");
+    }
+    check(status == GCOV_DUMP_DONE, "gcov_dump_step() failed");
+    result.image = sink.image();
+    return result;
+}
+
+}
+
+int main() {
+    return gcovtest::run_checks(
+        [] {
+            gcovbench::generator_config config;
+            config.files = 16U;
+            config.functions = 8U;
+            config.counters = 16U;
+            gcovbench::synthetic_coverage coverage(config);
+            gcovtest::register_files(coverage);
+
+            gcovtest::memory_image sink;
+            const struct {
+                const char* name;
+                gcov_unsigned_t flags;
+            } layouts[] = {
+                {"plain", 0U},
+                {"packed", GCOV_IMAGE_PACKED_COUNTERS},
+                {"checked", GCOV_IMAGE_CHECKED},
+                {"hit-only", GCOV_IMAGE_HIT_ONLY},
+            };
+            for(const auto& layout : layouts) {
+                set_gcov_image_flags(layout.flags);
+                const bytes expected = sink.dump();
+                gcovtest::parse_intact(expected);
+                const std::string name = layout.name;
+
+                const stepped_image single_bytes = dump_stepped(sink, 1U);
+                const stepped_image small = dump_stepped(sink, 64U);
+                const stepped_image unlimited = dump_stepped(sink, SIZE_MAX);
+                check(single_bytes.image == expected,
+                      name + ": the image of budget 1 differs from __gcov_dump()");
+                check(small.image == expected,
+                      name + ": the image of budget 64 differs from __gcov_dump()");
+                check(unlimited.image == expected,
+                      name + ": the image of budget SIZE_MAX differs from __gcov_dump()");
+                check(unlimited.calls == 1U,
+                      name + ": budget SIZE_MAX did not write the image in one call");
+                check(single_bytes.calls > small.calls && small.calls > 1U,
+                      name + ": smaller budgets did not take more calls");
+            }
+        },
+        "the stepped images of all budgets match the images of __gcov_dump()");
+}
@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+#include <gcov/gcov_info.h>
+
+#include "gcov_counter_words.h"
+}
+
+#include <gcovhost/gcda.hpp>
+
+// A self-consistency check of the counter conversion of both byte orders. No big-endian target
+// is involved: endian_le.gcda is the converter output of a little-endian host and
+// endian_swapped.gcda is the same file with the bytes of each word reversed. The checks show that
+// the big-endian conversion, the word-swapped layout, the host reader and gcov-dump agree with
+// each other.
+
+namespace {
+
+constexpr bool host_big_endian = __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+
+// The version of GCC 12, gcov-dump warns about the versions of other releases but reads them
+constexpr gcov_unsigned_t fixture_version = 0x4232322AU;    // "B22*"
+constexpr gcov_unsigned_t fixture_stamp = 0x1234'5678U;
+constexpr gcov_unsigned_t fixture_checksum = 0x9ABC'DEF0U;
+
+/*! \brief Counters whose halves differ, so each half lands in a word of its own
+ */
+gcov_type fixture_values[] = {
+    0,
+    1,
+    0x0000'0000'FFFF'FFFF,
+    0x0000'0001'0000'0000,
+    0x0123'4567'89AB'CDEF,
+    0x7FFF'FFFF'0000'0001,
+    0x0000'0002'0000'0003,
+    42,
+};
+
+/*! \brief A file with two functions using the arc counters, like objects built with --coverage
+ */
+struct fixture_coverage {
+    gcov_fn_info functions[2];
+    gcov_fn_info* function_pointers[2];
+    gcov_info file;
+
+    fixture_coverage() : functions{}, function_pointers{&functions[0], &functions[1]}, file{} {
+        functions[0].ident = 1U;
+        functions[0].lineno_checksum = 0x0102'0304U;
+        functions[0].cfg_checksum = 0x0506'0708U;
+        functions[0].ctrs[0] = {6U, fixture_values};
+        functions[1].ident = 2U;
+        functions[1].lineno_checksum = 0x1112'1314U;
+        functions[1].cfg_checksum = 0x1516'1718U;
+        functions[1].ctrs[0] = {2U, fixture_values + 6};
+        file.version = fixture_version;
+        file.stamp = fixture_stamp;
+        file.checksum = fixture_checksum;
+        file.filename = "/fixtures/endian.gcda";
+        file.merge[0] = __gcov_merge_add;
+        file.n_functions = 2U;
+        file.functions = function_pointers;
+    }
+};
+
+constexpr size_t fixture_count = sizeof(fixture_values) / sizeof(fixture_values[0]);
+
+using bytes = std::vector<uint8_t>;
+
+/*! \brief Returns the gcda words of the counters as a target of the given byte order stores them
+ *
+ *  Written out with shifts, independent of the byte order of the host and of the runtime.
+ */
+bytes expected_words(const bool big_endian) {
+    bytes words;
+    for(const gcov_type counter : fixture_values) {
+        const uint64_t value = uint64_t(counter);
+        for(const uint32_t word : {uint32_t(value), uint32_t(value >> 32U)}) {
+            if(big_endian)
+                words.insert(words.end(), {uint8_t(word >> 24U), uint8_t(word >> 16U),
+                                           uint8_t(word >> 8U), uint8_t(word)});
+            else
+                words.insert(words.end(), {uint8_t(word), uint8_t(word >> 8U),
+                                           uint8_t(word >> 16U), uint8_t(word >> 24U)});
+        }
+    }
+    return words;
+}
+
+/*! \brief Runs the conversion of a target of the given byte order on the host
+ *
+ *  The kernel stores each converted counter with memcpy() in the byte order of the host. A
+ *  target of the other byte order stores the same 64 bit value with its bytes reversed.
+ */
+bytes emulate_conversion(const bool big_endian) {
+    bytes words(sizeof(fixture_values));
+    convert_gcov_counter_words(words.data(), fixture_values, fixture_count, big_endian);
+    if(big_endian != host_big_endian) {
+        for(auto value = words.begin(); value != words.end(); value += sizeof(uint64_t))
+            std::reverse(value, value + sizeof(uint64_t));
+    }
+    return words;
+}
+
+/*! \brief Reverses the bytes of each 32 bit word, gcda data consists of words only
+ */
+bytes swap_words(bytes data) {
+    for(auto word = data.begin(); word + sizeof(uint32_t) <= data.end(); word += sizeof(uint32_t))
+        std::reverse(word, word + sizeof(uint32_t));
+    return data;
+}
+
+bytes read_file(const std::string& path) {
+    std::ifstream input(path, std::ios::binary);
+    if(!input)
+        throw std::runtime_error("can not open " + path);
+    return bytes(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+}
+
+void write_file(const std::string& path, const bytes& data) {
+    std::ofstream output(path, std::ios::binary);
+    output.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+    if(!output)
+        throw std::runtime_error("can not write " + path);
+}
+
+void check(const bool condition, const std::string& what) {
+    if(!condition)
+        throw std::runtime_error(what);
+}
+
+/*! \brief Checks the conversion of both byte orders against the words written out with shifts
+ */
+void check_kernel() {
+    bytes copied(sizeof(fixture_values));
+    memcpy(copied.data(), fixture_values, sizeof(fixture_values));
+    check(emulate_conversion(host_big_endian) == expected_words(host_big_endian),
+          "the conversion of the host byte order differs from the expected words");
+    if(!host_big_endian)
+        check(copied == expected_words(false), "the memcpy() path differs from the expected words");
+    check(emulate_conversion(false) == expected_words(false),
+          "the little-endian conversion differs from the expected words");
+    check(emulate_conversion(true) == expected_words(true),
+          "the big-endian conversion differs from the expected words");
+}
+
+/*! \brief Checks the fixture files of both byte orders
+ *
+ *  The file of the host byte order has to be the output of gcov_convert_to_gcda(). In the file
+ *  of the other byte order the counters have to be the output of the emulated conversion at the
+ *  same offset, and both files have to parse to the fixture.
+ */
+void check_fixtures(const bytes& converted, const bytes& little, const bytes& big) {
+    check(converted == (host_big_endian ? big : little),
+          "the converter output differs from the fixture file of the host byte order");
+    check(swap_words(little) == big, "the fixture files differ in more than the byte order");
+
+    const bytes host_words = expected_words(host_big_endian);
+    const auto counters = std::search(converted.begin(), converted.end(), host_words.begin(),
+                                      host_words.begin() + 6 * sizeof(gcov_type));
+    check(counters != converted.end(), "the counters of the first function are not found");
+    const size_t offset = size_t(counters - converted.begin());
+    const bytes& other = host_big_endian ? little : big;
+    const bytes other_words = emulate_conversion(!host_big_endian);
+    check(std::equal(other_words.begin(), other_words.begin() + 6 * sizeof(gcov_type),
+                     other.begin() + std::ptrdiff_t(offset)),
+          "the counters of the other fixture file differ from the emulated conversion");
+
+    for(const bytes* fixture : {&little, &big}) {
+        const gcovhost::gcda_file file =
+            gcovhost::parse_gcda(fixture->data(), fixture->size(), false);
+        check(file.big_endian == (fixture == &big),
+              "the byte order of a fixture file is not detected");
+        check((file.version == fixture_version) && (file.stamp == fixture_stamp)
+                  && (file.checksum == fixture_checksum) && (file.functions.size() == 2U),
+              "the header of a fixture file does not match the fixture");
+        std::vector<uint64_t> values;
+        for(const gcovhost::gcda_function& function : file.functions) {
+            for(const gcovhost::gcda_counters& counters : function.counters)
+                values.insert(values.end(), counters.values.begin(), counters.values.end());
+        }
+        check(values == std::vector<uint64_t>(std::begin(fixture_values), std::end(fixture_values)),
+              "the counters of a fixture file do not match the fixture");
+    }
+}
+
+void print_usage(const char* name) {
+    fprintf(stderr,
+            "Usage: %s [-w] fixture directory\n"
+            "Checks the conversion of counters into gcda words for both byte orders against\n"
+            "each other and against the files endian_le.gcda and endian_swapped.gcda of the\n"
+            "directory, a self-consistency check without output of a big-endian target.\n"
+            "  -w    writes the files instead, endian_swapped.gcda is the converter output with\n"
+            "        the bytes of each word reversed\n",
+            name);
+}
+
+}
+
+int main(int argc, char** argv) {
+    const bool write = (argc == 3) && !strcmp(argv[1], "-w");
+    if((argc != 2) && !write) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    const std::string directory = argv[argc - 1];
+
+    try {
+        fixture_coverage coverage;
+        bytes converted(gcov_convert_to_gcda(nullptr, 0U, &coverage.file));
+        gcov_convert_to_gcda(converted.data(), converted.size(), &coverage.file);
+        const bytes swapped = swap_words(converted);
+        if(write) {
+            write_file(directory + "/endian_le.gcda", host_big_endian ? swapped : converted);
+            write_file(directory + "/endian_swapped.gcda", host_big_endian ? converted : swapped);
+            return EXIT_SUCCESS;
+        }
+
+        check_kernel();
+        check_fixtures(converted, read_file(directory + "/endian_le.gcda"),
+                       read_file(directory + "/endian_swapped.gcda"));
+    } catch(const std::exception& error) {
+        fprintf(stderr, "Error: %s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    printf("counter conversion and fixture files of both byte orders agree\n");
+    return EXIT_SUCCESS;
+}
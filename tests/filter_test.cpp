@@ -0,0 +1,153 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "test_support.hpp"
+
+// Registers filters for whole files and for functions of synthesized files and checks that the
+// filtered images hold exactly the matching files and functions with their counters, and that
+// clearing the filters dumps all of them again.
+
+namespace {
+
+using gcovtest::bytes;
+using gcovtest::check;
+
+constexpr size_t file_count = 16U;
+constexpr size_t function_count = 8U;
+constexpr size_t counter_count = 4U;
+
+/*! \brief The functions of a file by their ident
+ */
+using file_functions = std::set<gcov_unsigned_t>;
+
+/*! \brief A set of filters and the files and functions they select
+ */
+struct scenario {
+    const char* name;                                  //!< Printed if the scenario fails
+    std::vector<gcov_filter> filters;                  //!< The filters in registration order
+    std::map<std::string, file_functions> expected;    //!< The selected functions by gcda path
+};
+
+std::string file_path(const size_t file_idx) {
+    char path[64];
+    snprintf(path, sizeof(path), "/bench/synthetic/file_%06zu.gcda", file_idx);
+    return path;
+}
+
+/*! \brief Returns all functions of a file, the idents of the synthesized files are consecutive
+ */
+file_functions all_functions(const size_t file_idx) {
+    file_functions functions;
+    for(size_t function_idx = 0U; function_idx < function_count; ++function_idx)
+        functions.insert(gcov_unsigned_t(file_idx * function_count + function_idx));
+    return functions;
+}
+
+/*! \brief Checks that an image holds exactly the expected functions with their live counters
+ */
+void check_image(const bytes& image,
+                 const std::map<std::string, file_functions>& expected,
+                 gcovbench::synthetic_coverage& coverage,
+                 const std::string& name) {
+    const gcovhost::image parsed = gcovtest::parse_intact(image);
+    std::map<std::string, file_functions> dumped;
+    for(const gcovhost::image_record& record : parsed.records) {
+        file_functions& functions = dumped[record.path];
+        for(const gcovhost::gcda_function& function : record.data.functions) {
+            check(functions.insert(function.ident).second,
+                  name + ": a function is dumped twice in " + record.path);
+            const gcov_fn_info* live = coverage.infos()[function.ident / function_count]
+                                           ->functions[function.ident % function_count];
+            check(function.counters.size() == 1U
+                      && function.counters[0].values.size() == counter_count,
+                  name + ": the counters of a function are missing in " + record.path);
+            for(size_t value_idx = 0U; value_idx < counter_count; ++value_idx)
+                check(function.counters[0].values[value_idx]
+                          == uint64_t(live->ctrs[0].values[value_idx]),
+                      name + ": a counter differs in " + record.path);
+        }
+    }
+    check(dumped == expected, name + ": the dumped files or functions differ");
+}
+
+}
+
+int main() {
+    return gcovtest::run_checks(
+        [] {
+            gcovbench::generator_config config;
+            config.files = file_count;
+            config.functions = function_count;
+            config.counters = counter_count;
+            gcovbench::synthetic_coverage coverage(config);
+            gcovtest::register_files(coverage);
+            gcovtest::memory_image sink;
+
+            const std::string single_file = file_path(3U);
+            const std::string function_file = file_path(2U);
+            static const gcov_unsigned_t included_idents[] = {17U, 20U, 23U};
+            static const gcov_unsigned_t excluded_idents[] = {0U, 9U, 127U};
+
+            std::map<std::string, file_functions> everything;
+            for(size_t file_idx = 0U; file_idx < file_count; ++file_idx)
+                everything[file_path(file_idx)] = all_functions(file_idx);
+
+            std::vector<scenario> scenarios;
+            {
+                scenario test = {"included files", {}, {}};
+                test.filters.push_back({single_file.c_str(), nullptr, 0U, true});
+                test.filters.push_back({"/bench/synthetic/file_00001?.gcda", nullptr, 0U, true});
+                test.expected[single_file] = all_functions(3U);
+                for(size_t file_idx = 10U; file_idx < file_count; ++file_idx)
+                    test.expected[file_path(file_idx)] = all_functions(file_idx);
+                scenarios.push_back(test);
+            }
+            {
+                scenario test = {"excluded file", {}, {}};
+                test.filters.push_back({"*/file_00000?.gcda", nullptr, 0U, true});
+                test.filters.push_back({"*5.gcda", nullptr, 0U, false});
+                for(size_t file_idx = 0U; file_idx < 10U; ++file_idx) {
+                    if(file_idx != 5U)
+                        test.expected[file_path(file_idx)] = all_functions(file_idx);
+                }
+                scenarios.push_back(test);
+            }
+            {
+                scenario test = {"included functions", {}, {}};
+                test.filters.push_back({function_file.c_str(), included_idents, 3U, true});
+                test.expected = everything;
+                test.expected[function_file] = {17U, 20U, 23U};
+                scenarios.push_back(test);
+            }
+            {
+                scenario test = {"excluded functions", {}, {}};
+                test.filters.push_back({nullptr, excluded_idents, 3U, false});
+                test.expected = everything;
+                test.expected[file_path(0U)].erase(0U);
+                test.expected[file_path(1U)].erase(9U);
+                test.expected[file_path(15U)].erase(127U);
+                scenarios.push_back(test);
+            }
+
+            for(const scenario& test : scenarios) {
+                for(const gcov_filter& filter : test.filters)
+                    check(gcov_add_filter(&filter) == 0, "the filter is not registered");
+                const gcovhost::image parsed = gcovtest::parse_intact(sink.dump());
+                check(parsed.flags & GCOV_IMAGE_FILTERED,
+                      std::string(test.name) + ": the image is not marked as filtered");
+                check_image(sink.image(), test.expected, coverage, test.name);
+                gcov_clear_filters();
+            }
+
+            const bytes image = sink.dump();
+            check(!(gcovtest::parse_intact(image).flags & GCOV_IMAGE_FILTERED),
+                  "the image without filters is marked as filtered");
+            check_image(image, everything, coverage, "cleared filters");
+        },
+        "the filtered images hold exactly the matching files and functions");
+}
@@ -0,0 +1,9 @@
+// Built with -fcondition-coverage by gcov_lcov_conditions_test, the decisions have to stay on
+// one line, which the test finds by the marker comment
+int two_decisions(const bool a, const bool b, const bool c, const bool d) {
+    int result = 0;
+    // clang-format off
+    if(a && b) result |= 1; if(c && d) result |= 2; // two decisions
+    // clang-format on
+    return result;
+}
@@ -0,0 +1,96 @@
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gcovhost/coverage.hpp>
+#include <gcovhost/gcno.hpp>
+#include <test/test.hpp>
+#include <test/workload.hpp>
+
+#include "test_support.hpp"
+
+// Runs the workload of libtest, dumps the counters as full and as hit-only image and checks that
+// both expand to the same line coverage with the gcno files, i.e. the same lines are executed
+// and the same ones are not.
+
+namespace {
+
+using gcovtest::bytes;
+using gcovtest::check;
+
+/*! \brief The executed and the not executed lines of all source files
+ */
+using line_coverage = std::set<std::pair<std::string, std::pair<uint32_t, bool>>>;
+
+std::string notes_path(const std::string& gcda_path) {
+    const std::string extension = ".gcda";
+    check(gcda_path.size() > extension.size()
+              && gcda_path.compare(gcda_path.size() - extension.size(), extension.size(),
+                                   extension)
+                     == 0,
+          "the record path " + gcda_path + " does not end with .gcda");
+    return gcda_path.substr(0U, gcda_path.size() - extension.size()) + ".gcno";
+}
+
+line_coverage expand_lines(const bytes& image) {
+    gcovhost::coverage_map coverage;
+    for(const gcovhost::image_record& record : gcovtest::parse_intact(image).records)
+        gcovhost::add_coverage(coverage, gcovhost::read_gcno(notes_path(record.path)),
+                               &record.data);
+    line_coverage lines;
+    for(const auto& [source, file] : coverage) {
+        for(const auto& [line, count] : file.lines)
+            lines.emplace(source, std::make_pair(line, count != 0U));
+    }
+    return lines;
+}
+
+void run_workload() {
+    uint8_t payload[256];
+    for(size_t idx = 0U; idx < sizeof(payload); ++idx)
+        payload[idx] = uint8_t(idx * 7U);
+    // neither hash_payload nor the skip of unknown types runs, so some lines stay unexecuted
+    const test::message messages[] = {
+        {0U, 200U, payload},
+        {2U, 33U, payload},
+        {3U, 17U, payload + 100},
+        {0U, 0U, payload},
+    };
+    volatile uint64_t result = test::process_messages(messages, 4U, 16U);
+    result = result + test::add_or_mult(result, 3U, false);
+}
+
+}
+
+int main() {
+    return gcovtest::run_checks(
+        [] {
+            run_workload();
+            gcovtest::memory_image sink;
+            const bytes full = sink.dump();
+            set_gcov_image_flags(GCOV_IMAGE_HIT_ONLY);
+            const bytes hit_only = sink.dump();
+            check(gcovtest::parse_intact(hit_only).flags & GCOV_IMAGE_HIT_ONLY,
+                  "the image is not marked as hit-only");
+
+            const line_coverage expected = expand_lines(full);
+            const line_coverage actual = expand_lines(hit_only);
+            size_t executed = 0U;
+            for(const auto& line : expected)
+                executed += line.second.second ? 1U : 0U;
+            check(executed && executed < expected.size(),
+                  "the workload has to leave some lines unexecuted");
+            for(const auto& line : expected) {
+                check(actual.count(line),
+                      "line " + std::to_string(line.second.first) + " of " + line.first
+                          + (line.second.second ? " is executed" : " is not executed")
+                          + " in the full image only");
+            }
+            check(actual.size() == expected.size(), "the hit-only image lists other lines");
+        },
+        "the hit-only image expands to the line coverage of the full image");
+}
@@ -0,0 +1,144 @@
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test_support.hpp"
+
+// Runs the two decisions on one line of fixtures/two_decisions.cpp, writes the MC/DC records of
+// the image with gcov_lcov and checks that both decisions keep records of their own. The inputs
+// cover both outcomes of all conditions except the false outcome of c.
+
+int two_decisions(bool a, bool b, bool c, bool d);
+
+namespace {
+
+using gcovtest::bytes;
+using gcovtest::check;
+
+const char image_path[] = "two_decisions.bin";
+const char tracefile_path[] = "two_decisions.info";
+
+/*! \brief An MC/DC record of the tracefile
+ */
+struct mcdc_record {
+    unsigned terms;            //!< The number of conditions of the decision
+    bool taken;                //!< Set if the condition was shown to be independent
+    unsigned index;            //!< The index of the condition
+    std::string expression;    //!< The expression which tells the records apart
+};
+
+/*! \brief Returns the line of the fixture which holds the two decisions
+ */
+unsigned find_decision_line(const std::string& fixture) {
+    std::ifstream input(fixture);
+    check(bool(input), "can not read " + fixture);
+    unsigned line_number = 1U;
+    for(std::string line; std::getline(input, line); ++line_number) {
+        if(line.find("// two decisions") != std::string::npos)
+            return line_number;
+    }
+    throw std::runtime_error("the decisions are not found in " + fixture);
+}
+
+/*! \brief Reads the MC/DC records of a line of the fixture by sense and expression
+ */
+std::map<std::pair<char, std::string>, mcdc_record> read_records(const unsigned line_number) {
+    std::ifstream input(tracefile_path);
+    check(bool(input), std::string("can not read ") + tracefile_path);
+    std::map<std::pair<char, std::string>, mcdc_record> records;
+    bool in_fixture = false;
+    const std::string fixture_name = "/two_decisions.cpp";
+    for(std::string line; std::getline(input, line);) {
+        if(line.rfind("SF:", 0U) == 0U) {
+            in_fixture = line.size() >= fixture_name.size()
+                         && line.compare(line.size() - fixture_name.size(), fixture_name.size(),
+                                         fixture_name)
+                                == 0;
+            continue;
+        }
+        if(!in_fixture || line.rfind("MCDC:", 0U) != 0U)
+            continue;
+        // MCDC:<line>,<terms>,<t|f>,<taken>,<index>,<expression>
+        std::istringstream fields(line.substr(5U));
+        std::string field;
+        std::vector<std::string> values;
+        while(std::getline(fields, field, ','))
+            values.push_back(field);
+        check(values.size() == 6U && values[2].size() == 1U, "malformed record " + line);
+        if(std::stoul(values[0]) != line_number)
+            continue;
+        const mcdc_record record = {unsigned(std::stoul(values[1])), values[3] != "0",
+                                    unsigned(std::stoul(values[4])), values[5]};
+        check(records.emplace(std::make_pair(values[2][0], values[5]), record).second,
+              "two records share the sense and expression of " + line);
+    }
+    return records;
+}
+
+}
+
+int main(int argc, char** argv) {
+    if(argc != 3) {
+        fprintf(stderr,
+                "Usage: %s gcov_lcov fixture\n"
+                "Checks the MC/DC records gcov_lcov writes for two decisions on one line of\n"
+                "the fixture source two_decisions.cpp.\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+    const std::string gcov_lcov = argv[1];
+    const std::string fixture = argv[2];
+    return gcovtest::run_checks(
+        [&] {
+            gcovtest::memory_image sink;
+            const bool inputs[][4] = {{true, true, true, true},
+                                      {false, true, true, false},
+                                      {true, false, true, true}};
+            for(const auto& input : inputs)
+                two_decisions(input[0], input[1], input[2], input[3]);
+            const bytes image = sink.dump();
+            std::ofstream output(image_path, std::ios::binary);
+            output.write(reinterpret_cast<const char*>(image.data()),
+                         std::streamsize(image.size()));
+            output.close();
+            check(bool(output), std::string("can not write ") + image_path);
+
+            const std::string command = gcov_lcov + " -o " + tracefile_path + " " + image_path;
+            check(std::system(command.c_str()) == 0, "gcov_lcov failed");
+            const auto records = read_records(find_decision_line(fixture));
+            check(!records.empty(),
+                  "no MC/DC records, the fixture needs -fcondition-coverage of GCC 14");
+
+            // two decisions with two conditions, each shown true and false
+            check(records.size() == 8U, "the line holds " + std::to_string(records.size())
+                                            + " MC/DC records instead of 8");
+            std::map<std::string, std::vector<bool>> decisions;
+            for(const auto& [key, record] : records) {
+                const std::string& expression = key.second;
+                const size_t separator = expression.find(':');
+                check(separator != std::string::npos && record.terms == 2U,
+                      "unexpected record " + expression);
+                check(expression.substr(separator + 1U) == std::to_string(record.index),
+                      "the expression " + expression + " does not end with the condition index");
+                std::vector<bool>& taken = decisions[expression.substr(0U, separator)];
+                taken.resize(4U);
+                taken[record.index * 2U + (key.first == 't' ? 0U : 1U)] = record.taken;
+            }
+            check(decisions.size() == 2U, "the records do not tell the two decisions apart");
+            const std::multiset<std::vector<bool>> expected = {
+                {true, true, true, true},      // a && b
+                {true, false, true, true},     // c && d, c is never false
+            };
+            std::multiset<std::vector<bool>> actual;
+            for(const auto& [decision, taken] : decisions)
+                actual.insert(taken);
+            check(actual == expected, "the covered conditions differ from the inputs");
+        },
+        "the MC/DC records of two decisions on one line are kept apart");
+}
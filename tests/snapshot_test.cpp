@@ -0,0 +1,102 @@
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "test_support.hpp"
+
+// Takes a snapshot of synthesized files, writes its image with gcov_dump_step() while every
+// counter is incremented between two calls and checks that the image holds the counters of the
+// snapshot. The next dump without snapshot has to hold the live counters again.
+
+namespace {
+
+using gcovtest::bytes;
+using gcovtest::check;
+
+//! The arc counters of each file by gcda path
+using file_counters = std::map<std::string, std::vector<uint64_t>>;
+
+/*! \brief Returns the live arc counters of all files
+ */
+file_counters live_counters(gcovbench::synthetic_coverage& coverage) {
+    file_counters files;
+    for(const gcov_info* info : coverage.infos()) {
+        std::vector<uint64_t>& values = files[info->filename];
+        for(unsigned function_idx = 0U; function_idx < info->n_functions; ++function_idx) {
+            const gcov_ctr_info& counters = info->functions[function_idx]->ctrs[0];
+            values.insert(values.end(), counters.values, counters.values + counters.num);
+        }
+    }
+    return files;
+}
+
+/*! \brief Returns the arc counters of all records of an image
+ */
+file_counters image_counters(const bytes& image) {
+    file_counters files;
+    for(const gcovhost::image_record& record : gcovtest::parse_intact(image).records) {
+        gcovhost::image single;
+        single.records.push_back(record);
+        files[record.path] = gcovtest::arc_counters(single);
+    }
+    return files;
+}
+
+/*! \brief Increments every counter, as if the application kept running
+ */
+void mutate(gcovbench::synthetic_coverage& coverage) {
+    for(const gcov_info* info : coverage.infos()) {
+        for(unsigned function_idx = 0U; function_idx < info->n_functions; ++function_idx) {
+            const gcov_ctr_info& counters = info->functions[function_idx]->ctrs[0];
+            for(gcov_unsigned_t value_idx = 0U; value_idx < counters.num; ++value_idx)
+                counters.values[value_idx] += 1000;
+        }
+    }
+}
+
+}
+
+int main() {
+    return gcovtest::run_checks(
+        [] {
+            gcovbench::generator_config config;
+            config.files = 16U;
+            config.functions = 8U;
+            config.counters = 16U;
+            gcovbench::synthetic_coverage coverage(config);
+            gcovtest::register_files(coverage);
+            gcovtest::memory_image sink;
+
+            std::vector<unsigned char> area(coverage.counters() * sizeof(gcov_type) + 64U);
+            check(gcov_snapshot() == -1, "a snapshot is taken without area");
+            set_gcov_snapshot_buffer(area.data(), coverage.counters() * sizeof(gcov_type) / 2U);
+            check(gcov_snapshot() == -1, "a snapshot is taken into a too small area");
+            set_gcov_snapshot_buffer(area.data(), area.size());
+
+            for(const size_t budget : {size_t(64U), SIZE_MAX}) {
+                const file_counters expected = live_counters(coverage);
+                check(gcov_snapshot() == 0, "the snapshot is not taken");
+                check(gcov_snapshot_pending(), "the snapshot is not pending");
+                mutate(coverage);
+                size_t calls = 0U;
+                int status = GCOV_DUMP_PENDING;
+                while(status == GCOV_DUMP_PENDING) {
+                    status = gcov_dump_step(budget);
+                    mutate(coverage);
+                    ++calls;
+                }
+                check(status == GCOV_DUMP_DONE, "the stepped dump failed");
+                check(budget == SIZE_MAX || calls > 1U, "the image is written in a single call");
+                check(!gcov_snapshot_pending(), "the snapshot is pending after its image");
+                check(image_counters(sink.image()) == expected,
+                      "the image does not hold the counters of the snapshot");
+            }
+
+            const file_counters live = live_counters(coverage);
+            check(image_counters(sink.dump()) == live,
+                  "the dump after the snapshot does not hold the live counters");
+        },
+        "the images of the snapshots hold the counters at the time of the snapshot");
+}
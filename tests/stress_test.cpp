@@ -0,0 +1,270 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+}
+
+#include <gcovhost/image.hpp>
+#include <test/test.hpp>
+#include <test/workload.hpp>
+
+namespace {
+
+// Counter types with a fixed meaning, see gcc/gcov-counter.def
+constexpr unsigned gcov_counter_arcs = 0U;
+constexpr unsigned gcov_counter_conditions = 8U;
+//! The exit code ctest reports as skipped
+constexpr int exit_skipped = 77;
+
+/*! \brief The configuration of a run
+ */
+struct stress_config {
+    size_t workers = 4U;       //!< The number of threads running instrumented code
+    size_t dumps = 5000U;      //!< The number of images the dump thread writes
+    unsigned reset_ms = 1U;    //!< The pause between two resets, 0 disables them
+    bool force = false;        //!< Set to run on a single CPU, where threads never run at once
+};
+
+/*! \brief The outcome of the checks of all images
+ */
+struct stress_result {
+    size_t images = 0U;        //!< The number of parsed images
+    size_t compared = 0U;      //!< The images compared to the previous one without reset
+    size_t decreased = 0U;     //!< The counters which went down without reset
+    size_t mismatched = 0U;    //!< The images whose layout differs from the previous one
+};
+
+/*! \brief The counter records of an image in image order
+ */
+using counter_list = std::vector<const gcovhost::gcda_counters*>;
+
+counter_list list_counters(const gcovhost::image& parsed) {
+    counter_list counters;
+    for(const gcovhost::image_record& record : parsed.records) {
+        for(const gcovhost::gcda_function& function : record.data.functions) {
+            for(const gcovhost::gcda_counters& values : function.counters)
+                counters.push_back(&values);
+        }
+    }
+    return counters;
+}
+
+/*! \brief Counts the counters of an image which went down since the previous image
+ *
+ *  Arc counters are summed up and condition counters are OR'ed, so neither may lose counts
+ *  or bits while no reset happens. Other counter types are not checked.
+ */
+size_t count_decreased(const counter_list& previous, const counter_list& current) {
+    size_t decreased = 0U;
+    for(size_t record_idx = 0U; record_idx < current.size(); ++record_idx) {
+        const gcovhost::gcda_counters& before = *previous[record_idx];
+        const gcovhost::gcda_counters& after = *current[record_idx];
+        for(size_t value_idx = 0U; value_idx < after.values.size(); ++value_idx) {
+            const uint64_t old_value = before.values[value_idx];
+            const uint64_t new_value = after.values[value_idx];
+            const bool lost_bits = (new_value | old_value) != new_value;
+            if(((after.kind == gcov_counter_arcs) && (new_value < old_value))
+               || ((after.kind == gcov_counter_conditions) && lost_bits))
+                ++decreased;
+        }
+    }
+    return decreased;
+}
+
+bool same_layout(const counter_list& previous, const counter_list& current) {
+    if(previous.size() != current.size())
+        return false;
+    for(size_t record_idx = 0U; record_idx < current.size(); ++record_idx) {
+        if((previous[record_idx]->kind != current[record_idx]->kind)
+           || (previous[record_idx]->values.size() != current[record_idx]->values.size()))
+            return false;
+    }
+    return true;
+}
+
+/*! \brief Runs the instrumented workload of libtest until it is stopped
+ */
+void run_worker(const std::atomic<bool>& stop, const uint32_t seed, std::atomic<uint64_t>& sink) {
+    std::mt19937 random(seed);
+    std::vector<uint8_t> payload(512U);
+    for(uint8_t& byte : payload)
+        byte = uint8_t(random());
+    std::vector<test::message> messages(64U);
+    for(test::message& message : messages) {
+        message.type = random() % 5U;
+        message.length = random() % 256U;
+        message.payload = payload.data() + random() % 256U;
+    }
+
+    uint64_t result = 0U;
+    while(!stop.load(std::memory_order_relaxed)) {
+        result += test::process_messages(messages.data(), messages.size(), 1U + random() % 64U);
+        result += test::add_or_mult(result, random() % 8U, random() % 2U);
+    }
+    sink += result;
+}
+
+/*! \brief Resets the counters periodically until it is stopped
+ *
+ *  \param[in]      stop    Set to stop
+ *  \param[in]      pause   The pause between two resets
+ *  \param[in,out]  resets  Incremented before and after each reset, so it is odd during one
+ */
+void run_resetter(const std::atomic<bool>& stop,
+                  const std::chrono::milliseconds pause,
+                  std::atomic<unsigned>& resets) {
+    while(!stop.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(pause);
+        resets.fetch_add(1U);
+        // a dump which reads a cleared counter sees the odd count afterwards
+        std::atomic_thread_fence(std::memory_order_release);
+        __gcov_reset();
+        resets.fetch_add(1U);
+    }
+}
+
+/*! \brief Dumps the counters while the workers and the resetter run and checks each image
+ */
+stress_result run_dumps(const stress_config& config, const std::atomic<unsigned>& resets) {
+    static unsigned char buffer[1U << 20U];
+    gcov_sink sink;
+    gcov_memory_sink_context context;
+    gcov_memory_sink_init(&sink, &context, buffer, sizeof(buffer));
+    set_gcov_sink(&sink);
+
+    stress_result result;
+    gcovhost::image previous;
+    counter_list previous_counters;
+    bool comparable = false;
+    unsigned previous_resets = 0U;
+    for(size_t dump_idx = 0U; dump_idx < config.dumps; ++dump_idx) {
+        const unsigned resets_before = resets.load();
+        __gcov_dump();
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const unsigned resets_after = resets.load();
+
+        size_t length = 0U;
+        if(context.overflow)
+            throw std::runtime_error("the image does not fit into the buffer");
+        if(gcovhost::check_image(buffer, context.used, length) != gcovhost::image_state::complete)
+            throw std::runtime_error("image " + std::to_string(dump_idx) + " is not complete");
+        gcovhost::image current = gcovhost::parse_image(buffer, length);
+        if(current.records.empty())
+            throw std::runtime_error("image " + std::to_string(dump_idx) + " holds no record");
+        ++result.images;
+
+        // images overlapping a reset or following one are only parsed
+        counter_list current_counters = list_counters(current);
+        if(comparable && (resets_before == previous_resets) && (resets_before == resets_after)) {
+            if(!same_layout(previous_counters, current_counters)) {
+                ++result.mismatched;
+            } else {
+                result.decreased += count_decreased(previous_counters, current_counters);
+                ++result.compared;
+            }
+        }
+        comparable = (resets_before == resets_after) && !(resets_after & 1U);
+        previous_resets = resets_after;
+        previous = std::move(current);
+        previous_counters = std::move(current_counters);
+    }
+    set_gcov_sink(nullptr);
+    return result;
+}
+
+void print_usage(const char* name) {
+    fprintf(stderr,
+            "Usage: %s [-t threads] [-d dumps] [-r reset ms] [-f]\n"
+            "Runs instrumented code of libtest in several threads while another thread dumps the\n"
+            "counters and a third one resets them. Each image has to be complete and parse, and\n"
+            "no arc or condition counter may go down between two images without reset. Skipped\n"
+            "on a single CPU, where the threads never run at the same time.\n"
+            "  -t threads    the number of threads running libtest, defaults to 4\n"
+            "  -d dumps      the number of images to check, defaults to 5000\n"
+            "  -r reset ms   the pause between two resets, 0 disables them, defaults to 1\n"
+            "  -f            runs on a single CPU as well\n",
+            name);
+}
+
+}
+
+int main(int argc, char** argv) {
+    stress_config config;
+    for(int arg = 1; arg < argc; ++arg) {
+        const bool has_value = arg + 1 < argc;
+        if(!strcmp(argv[arg], "-t") && has_value) {
+            config.workers = strtoul(argv[++arg], nullptr, 10);
+        } else if(!strcmp(argv[arg], "-d") && has_value) {
+            config.dumps = strtoul(argv[++arg], nullptr, 10);
+        } else if(!strcmp(argv[arg], "-r") && has_value) {
+            config.reset_ms = unsigned(strtoul(argv[++arg], nullptr, 10));
+        } else if(!strcmp(argv[arg], "-f")) {
+            config.force = true;
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if(!config.workers || (config.dumps < 2U)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if((std::thread::hardware_concurrency() < 2U) && !config.force) {
+        printf("skipped, the threads need at least two CPUs to run at the same time\n");
+        return exit_skipped;
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<unsigned> resets{0U};
+    std::atomic<uint64_t> checksum{0U};
+    std::vector<std::thread> threads;
+    for(size_t worker_idx = 0U; worker_idx < config.workers; ++worker_idx)
+        threads.emplace_back(run_worker, std::cref(stop), uint32_t(worker_idx + 1U),
+                             std::ref(checksum));
+    if(config.reset_ms)
+        threads.emplace_back(run_resetter, std::cref(stop),
+                             std::chrono::milliseconds(config.reset_ms), std::ref(resets));
+
+    stress_result result;
+    int status = EXIT_SUCCESS;
+    try {
+        result = run_dumps(config, resets);
+    } catch(const std::runtime_error& error) {
+        fprintf(stderr, "Error: %s\n", error.what());
+        status = EXIT_FAILURE;
+    }
+    stop = true;
+    for(std::thread& thread : threads)
+        thread.join();
+    if(status != EXIT_SUCCESS)
+        return status;
+
+    printf("%zu images, %zu compared without reset, %u resets, %zu counters decreased, "
+           "%zu layout mismatches\n",
+           result.images, result.compared, resets.load() / 2U, result.decreased,
+           result.mismatched);
+    if(result.decreased || result.mismatched) {
+        fprintf(stderr, "Error: counters went down between images without reset\n");
+        return EXIT_FAILURE;
+    }
+    if(config.reset_ms && (resets.load() < 2U)) {
+        fprintf(stderr, "Error: the dumps ended before the first reset, raise -d\n");
+        return EXIT_FAILURE;
+    }
+    if(!result.compared) {
+        fprintf(stderr, "Error: every image overlapped a reset, nothing was compared\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gcovhost/test_matrix.hpp>
+
+#include "test_support.hpp"
+
+// Runs tests on synthesized files, each of which increments the counters of a known set of
+// functions between gcov_begin_test() and gcov_end_test(), builds the test matrix from their
+// images, writes it as file and checks that select_tests() returns exactly the tests which
+// executed the queried functions.
+
+namespace {
+
+using gcovtest::bytes;
+using gcovtest::check;
+
+constexpr size_t file_count = 8U;
+constexpr size_t function_count = 8U;
+const char matrix_path[] = "test_matrix.gtm";
+
+/*! \brief Increments a counter of a function, as if the function was executed
+ */
+void execute(gcovbench::synthetic_coverage& coverage, const gcov_unsigned_t ident) {
+    const gcov_info* info = coverage.infos()[ident / function_count];
+    ++info->functions[ident % function_count]->ctrs[0].values[1];
+}
+
+/*! \brief Checks that no counter of the synthesized files is set
+ */
+void check_cleared(gcovbench::synthetic_coverage& coverage) {
+    for(const gcov_info* info : coverage.infos()) {
+        for(size_t function_idx = 0U; function_idx < function_count; ++function_idx) {
+            const gcov_ctr_info& counters = info->functions[function_idx]->ctrs[0];
+            for(gcov_unsigned_t value_idx = 0U; value_idx < counters.num; ++value_idx)
+                check(!counters.values[value_idx], "a counter is not cleared");
+        }
+    }
+}
+
+}
+
+int main() {
+    return gcovtest::run_checks(
+        [] {
+            gcovbench::generator_config config;
+            config.files = file_count;
+            config.functions = function_count;
+            config.counters = 4U;
+            gcovbench::synthetic_coverage coverage(config);
+            gcovtest::register_files(coverage);
+            gcovtest::memory_image sink;
+
+            check(gcov_end_test() == GCOV_DUMP_FAILED, "a test ended without being started");
+            check(gcov_begin_test(GCOV_MAX_TEST_ID + 1U) == -1, "a too large test id is taken");
+
+            // the functions each test executes by test id, test 3 runs twice, test 100 executes
+            // nothing and the tests from 200 on need a second word per row
+            std::multimap<gcov_unsigned_t, std::set<gcov_unsigned_t>> runs = {
+                {3U, {0U, 5U}}, {7U, {5U, 20U}}, {12U, {63U}}, {3U, {9U}}, {100U, {}},
+            };
+            for(gcov_unsigned_t test_id = 200U; test_id < 270U; ++test_id)
+                runs.insert({test_id, {gcov_unsigned_t(40U + test_id % 3U)}});
+
+            gcovhost::test_matrix_builder builder;
+            for(const auto& [test_id, functions] : runs) {
+                // the setup before the test is not attributed to it
+                execute(coverage, 33U);
+                check(gcov_begin_test(test_id) == 0, "the test is not started");
+                check(gcov_begin_test(test_id) == -1, "a test is started within a test");
+                for(const gcov_unsigned_t ident : functions)
+                    execute(coverage, ident);
+                check(gcov_end_test() == GCOV_DUMP_DONE, "the test image is not written");
+                check_cleared(coverage);
+                const gcovhost::image parsed = gcovtest::parse_intact(sink.image());
+                check((parsed.flags & GCOV_IMAGE_TEST) && parsed.sequence == test_id,
+                      "the image is not marked with the test id");
+                builder.add_image(parsed);
+            }
+
+            const bytes data = gcovhost::serialize_test_matrix(builder.build());
+            std::ofstream output(matrix_path, std::ios::binary);
+            output.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+            output.close();
+            check(bool(output), std::string("can not write ") + matrix_path);
+            const gcovhost::test_matrix_file matrix(matrix_path);
+
+            std::set<gcov_unsigned_t> test_ids;
+            for(const auto& run : runs)
+                test_ids.insert(run.first);
+            check(std::set<gcov_unsigned_t>(matrix.tests().begin(), matrix.tests().end())
+                      == test_ids,
+                  "the matrix lists other tests");
+
+            const auto select = [&](const std::set<gcov_unsigned_t>& idents) {
+                std::vector<size_t> functions;
+                for(size_t function_idx = 0U; function_idx < matrix.functions().size();
+                    ++function_idx) {
+                    if(idents.count(matrix.functions()[function_idx].ident))
+                        functions.push_back(function_idx);
+                }
+                return matrix.select_tests(functions);
+            };
+            check(select({33U}).empty(), "the setup before a test is attributed to a test");
+            check(select({1U, 2U}).empty(), "functions which never ran select tests");
+            check(select({5U}) == std::vector<uint32_t>{3U, 7U}, "function 5 selects other tests");
+            check(select({9U}) == std::vector<uint32_t>{3U}, "the second run of test 3 is lost");
+            check(select({20U, 63U}) == std::vector<uint32_t>{7U, 12U},
+                  "functions 20 and 63 select other tests");
+            std::vector<uint32_t> expected;
+            for(uint32_t test_id = 200U; test_id < 270U; ++test_id) {
+                if(test_id % 3U != 1U)
+                    expected.push_back(test_id);
+            }
+            check(select({40U, 42U}) == expected, "functions 40 and 42 select other tests");
+        },
+        "the test matrix selects exactly the tests which executed the functions");
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+}
+
+#include <gcovhost/image.hpp>
+
+#include "info_generator.hpp"
+
+namespace gcovtest {
+
+using bytes = std::vector<uint8_t>;
+
+inline void check(const bool condition, const std::string& what) {
+    if(!condition)
+        throw std::runtime_error(what);
+}
+
+/*! \brief A memory sink which is set as the sink of the runtime while it exists
+ */
+class memory_image {
+public:
+    explicit memory_image(const size_t capacity = size_t(1U) << 22U) : buffer(capacity) {
+        gcov_memory_sink_init(&sink, &context, buffer.data(), buffer.size());
+        set_gcov_sink(&sink);
+    }
+    ~memory_image() {
+        set_gcov_sink(nullptr);
+    }
+
+    memory_image(const memory_image&) = delete;
+    memory_image& operator=(const memory_image&) = delete;
+
+    /*! \brief Returns the image written last, throws if it did not fit into the buffer
+     */
+    bytes image() const {
+        check(!context.overflow, "the image does not fit into the buffer");
+        return bytes(buffer.begin(), buffer.begin() + std::ptrdiff_t(context.used));
+    }
+
+    /*! \brief Dumps the counters with __gcov_dump() and returns the image
+     */
+    bytes dump() {
+        __gcov_dump();
+        return image();
+    }
+
+private:
+    bytes buffer;
+    gcov_sink sink;
+    gcov_memory_sink_context context;
+};
+
+/*! \brief Registers the files of synthesized coverage data with the runtime
+ *
+ *  Files can not be unregistered, so each test registers a single set of files.
+ */
+inline void register_files(gcovbench::synthetic_coverage& coverage) {
+    for(gcov_info* info : coverage.infos())
+        __gcov_init(info);
+}
+
+/*! \brief Parses an image, throws if it is truncated or a checked record was lost
+ */
+inline gcovhost::image parse_intact(const bytes& image) {
+    gcovhost::image parsed = gcovhost::parse_image(image.data(), image.size());
+    check(!parsed.truncated && parsed.lost.empty(), "an intact image is not read completely");
+    return parsed;
+}
+
+/*! \brief Returns the arc counters of all records of an image in image order
+ */
+inline std::vector<uint64_t> arc_counters(const gcovhost::image& parsed) {
+    std::vector<uint64_t> values;
+    for(const gcovhost::image_record& record : parsed.records) {
+        for(const gcovhost::gcda_function& function : record.data.functions) {
+            for(const gcovhost::gcda_counters& counters : function.counters) {
+                if(counters.kind == 0U)
+                    values.insert(values.end(), counters.values.begin(), counters.values.end());
+            }
+        }
+    }
+    return values;
+}
+
+/*! \brief Runs the checks of a test and reports the first failed one
+ *
+ *  \param[in]  checks  Throws std::exception if a check fails
+ *  \param[in]  passed  Printed if all checks passed
+ *  \return             The exit code of the test
+ */
+template<typename checks_fn>
+int run_checks(checks_fn&& checks, const char* passed) {
+    try {
+        checks();
+    } catch(const std::exception& error) {
+        fprintf(stderr, "Error: %s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    printf("%s\n", passed);
+    return EXIT_SUCCESS;
+}
+
+}
@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+}
+
+#include <gcovhost/coverage.hpp>
+#include <gcovhost/gcda.hpp>
+#include <gcovhost/gcno.hpp>
+#include <gcovhost/image.hpp>
+
+namespace {
+
+// Counter types with a fixed meaning, see gcc/gcov-counter.def
+constexpr unsigned gcov_counter_arcs = 0U;
+constexpr unsigned gcov_counter_conditions = 8U;
+
+/*! \brief The counter increments of a function summed over all images
+ */
+struct hot_function {
+    std::string name;                           //!< The demangled name, the ident without notes
+    std::string location;                       //!< The source and the first line
+    uint64_t increments = 0U;                   //!< The sum of all arc counters
+    size_t conditions = 0U;                     //!< The number of MC/DC counters
+    std::vector<gcovhost::arc_counter> arcs;    //!< The arcs with counter, empty without notes
+    std::vector<std::string> arc_locations;     //!< The source lines of the arcs
+};
+
+/*! \brief An arc ranked by its counter
+ */
+struct hot_arc {
+    const hot_function* function;    //!< The function of the arc
+    size_t arc_idx;                  //!< The index in hot_function::arcs
+};
+
+/*! \brief Derives the path of the notes file from the path of the gcda file
+ */
+std::string notes_path(const std::string& gcda_path) {
+    const std::string extension = ".gcda";
+    if(gcda_path.size() > extension.size()
+       && gcda_path.compare(gcda_path.size() - extension.size(), extension.size(), extension) == 0)
+        return gcda_path.substr(0U, gcda_path.size() - extension.size()) + ".gcno";
+    return gcda_path + ".gcno";
+}
+
+std::string demangle(const std::string& name) {
+    if(name.compare(0U, 2U, "_Z") != 0)
+        return name;
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if(!demangled)
+        return name;
+    std::string result(demangled);
+    free(demangled);
+    return result;
+}
+
+/*! \brief Describes the lines an arc leaves and enters
+ *
+ *  A branch is taken at the last line of its source block. Lines of inlined code in other
+ *  sources are skipped, blocks without lines in the source of the function, like the entry and
+ *  exit block, are described by the first and last line of the function.
+ */
+std::string describe_arc(const gcovhost::gcno_function& function,
+                         const gcovhost::arc_counter& arc) {
+    std::vector<uint32_t> source_lines;
+    const auto own_lines = [&function, &source_lines](const uint32_t block) {
+        source_lines.clear();
+        for(const gcovhost::gcno_location& location : function.blocks[block].locations) {
+            if(location.source == function.source)
+                source_lines.insert(source_lines.end(), location.lines.begin(),
+                                    location.lines.end());
+        }
+        return !source_lines.empty();
+    };
+    const uint32_t fallback_line = arc.source == 1U ? function.end_line : function.start_line;
+    const uint32_t source_line = own_lines(arc.source) ? source_lines.back() : fallback_line;
+    const uint32_t destination_line = own_lines(arc.destination) ? source_lines.front()
+                                      : arc.destination == 1U ? function.end_line
+                                                              : function.start_line;
+    return std::to_string(source_line) + " -> " + std::to_string(destination_line);
+}
+
+/*! \brief Adds the counters of a file to the functions
+ *
+ *  \param[in,out]  functions   The functions by gcda path and ident
+ *  \param[in]      path        The gcda path of the file
+ *  \param[in]      data        The counters of the file
+ *  \param[in]      notes       The notes of the file, nullptr if there are none
+ */
+void add_file(std::map<std::pair<std::string, uint32_t>, hot_function>& functions,
+              const std::string& path,
+              const gcovhost::gcda_file& data,
+              const gcovhost::gcno_file* notes) {
+    if(notes && data.stamp != notes->stamp)
+        throw gcovhost::gcda_error(path + ": stamp does not match the notes, the data is stale");
+    for(const gcovhost::gcda_function& counters : data.functions) {
+        hot_function& function = functions[{path, counters.ident}];
+        const gcovhost::gcno_function* named = nullptr;
+        if(notes) {
+            for(const gcovhost::gcno_function& candidate : notes->functions) {
+                if(candidate.ident == counters.ident)
+                    named = &candidate;
+            }
+        }
+
+        for(const gcovhost::gcda_counters& values : counters.counters) {
+            if(values.kind == gcov_counter_conditions)
+                function.conditions = values.values.size();
+        }
+        if(!named) {
+            function.name = "function " + std::to_string(counters.ident);
+            function.location = path;
+            for(const gcovhost::gcda_counters& values : counters.counters) {
+                if(values.kind == gcov_counter_arcs)
+                    for(const uint64_t value : values.values)
+                        function.increments += value;
+            }
+            continue;
+        }
+
+        if(counters.lineno_checksum != named->lineno_checksum
+           || counters.cfg_checksum != named->cfg_checksum)
+            throw gcovhost::gcda_error(path + ": checksum of " + named->name
+                                       + " does not match the notes");
+        const std::vector<gcovhost::arc_counter> arcs =
+            gcovhost::list_arc_counters(*named, counters);
+        if(function.arcs.empty()) {
+            function.name = demangle(named->name);
+            function.location = gcovhost::resolve_source(notes->cwd, named->source) + ":"
+                                + std::to_string(named->start_line);
+            function.arcs = arcs;
+            for(const gcovhost::arc_counter& arc : arcs)
+                function.arc_locations.push_back(describe_arc(*named, arc));
+        } else {
+            for(size_t arc_idx = 0U; arc_idx < arcs.size(); ++arc_idx)
+                function.arcs[arc_idx].count += arcs[arc_idx].count;
+        }
+        for(const gcovhost::arc_counter& arc : arcs)
+            function.increments += arc.count;
+    }
+}
+
+double share(const uint64_t part, const uint64_t total) {
+    return total ? 100.0 * double(part) / double(total) : 0.0;
+}
+
+void print_usage(const char* name) {
+    fprintf(stderr,
+            "Usage: %s [-n count] image...\n"
+            "Ranks the functions and arcs of coverage images by their counter increments, the\n"
+            "instrumentation overhead they cause. The gcno file of each record is expected next\n"
+            "to the gcda path in the image.\n"
+            "  -n count  the number of functions and arcs to list, defaults to 20\n",
+            name);
+}
+
+}
+
+int main(int argc, char** argv) {
+    size_t count = 20U;
+    std::vector<std::string> images;
+    for(int arg = 1; arg < argc; ++arg) {
+        const bool has_value = arg + 1 < argc;
+        if(!strcmp(argv[arg], "-n") && has_value) {
+            count = strtoul(argv[++arg], nullptr, 10);
+        } else if(argv[arg][0] == '-') {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            images.push_back(argv[arg]);
+        }
+    }
+    if(images.empty() || !count) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::map<std::pair<std::string, uint32_t>, hot_function> functions;
+    std::map<std::string, gcovhost::gcno_file> notes;
+    for(const std::string& image_path : images) {
+        try {
+            const gcovhost::image image = gcovhost::read_image(image_path);
+            if(image.flags & (GCOV_IMAGE_DELTA | GCOV_IMAGE_HIT_ONLY)) {
+                fprintf(stderr, "Error: %s holds no complete counts, dump it without %s\n",
+                        image_path.c_str(),
+                        (image.flags & GCOV_IMAGE_DELTA) ? "GCOV_IMAGE_DELTA"
+                                                         : "GCOV_IMAGE_HIT_ONLY");
+                return EXIT_FAILURE;
+            }
+            if(image.truncated)
+                fprintf(stderr, "Warning: %s is truncated\n", image_path.c_str());
+            for(const gcovhost::image_record& record : image.records) {
+                auto unit = notes.find(record.path);
+                if(unit == notes.end()) {
+                    const std::string path = notes_path(record.path);
+                    gcovhost::gcno_file file;
+                    if(access(path.c_str(), R_OK) == 0)
+                        file = gcovhost::read_gcno(path);
+                    else
+                        fprintf(stderr, "Warning: no notes file %s\n", path.c_str());
+                    unit = notes.emplace(record.path, std::move(file)).first;
+                }
+                add_file(functions, record.path, record.data,
+                         unit->second.functions.empty() ? nullptr : &unit->second);
+            }
+        } catch(const std::runtime_error& error) {
+            fprintf(stderr, "Error: %s: %s\n", image_path.c_str(), error.what());
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<const hot_function*> ranked;
+    std::vector<hot_arc> arcs;
+    uint64_t total = 0U;
+    for(const auto& entry : functions) {
+        const hot_function& function = entry.second;
+        ranked.push_back(&function);
+        for(size_t arc_idx = 0U; arc_idx < function.arcs.size(); ++arc_idx)
+            arcs.push_back({&function, arc_idx});
+        total += function.increments;
+    }
+    std::stable_sort(ranked.begin(),
+                     ranked.end(),
+                     [](const hot_function* lhs, const hot_function* rhs) {
+                         return lhs->increments > rhs->increments;
+                     });
+    const auto arc_count = [](const hot_arc& arc) {
+        return arc.function->arcs[arc.arc_idx].count;
+    };
+    std::stable_sort(arcs.begin(),
+                     arcs.end(),
+                     [&arc_count](const hot_arc& lhs, const hot_arc& rhs) {
+                         return arc_count(lhs) > arc_count(rhs);
+                     });
+
+    printf("%llu counter increments in %zu functions\n\n", (unsigned long long) total,
+           functions.size());
+    printf("%4s %20s %7s %7s %5s %5s  %s\n", "rank", "increments", "share", "cumul.", "arcs",
+           "cond.", "function");
+    uint64_t cumulative = 0U;
+    for(size_t rank = 0U; rank < std::min(count, ranked.size()); ++rank) {
+        const hot_function& function = *ranked[rank];
+        cumulative += function.increments;
+        printf("%4zu %20llu %6.2f%% %6.2f%% %5zu %5zu  %s at %s\n", rank + 1U,
+               (unsigned long long) function.increments, share(function.increments, total),
+               share(cumulative, total), function.arcs.size(), function.conditions,
+               function.name.c_str(), function.location.c_str());
+    }
+
+    printf("\n%4s %20s %7s  %s\n", "rank", "increments", "share", "arc");
+    for(size_t rank = 0U; rank < std::min(count, arcs.size()); ++rank) {
+        const hot_arc& arc = arcs[rank];
+        printf("%4zu %20llu %6.2f%%  %s at line %s\n", rank + 1U,
+               (unsigned long long) arc_count(arc), share(arc_count(arc), total),
+               arc.function->name.c_str(), arc.function->arc_locations[arc.arc_idx].c_str());
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,206 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+}
+
+#include <gcovhost/coverage.hpp>
+#include <gcovhost/gcda.hpp>
+#include <gcovhost/gcno.hpp>
+#include <gcovhost/image.hpp>
+
+namespace {
+
+/*! \brief Derives the path of the notes file from the path of the gcda file
+ */
+std::string notes_path(const std::string& gcda_path) {
+    const std::string extension = ".gcda";
+    if(gcda_path.size() > extension.size()
+       && gcda_path.compare(gcda_path.size() - extension.size(), extension.size(), extension) == 0)
+        return gcda_path.substr(0U, gcda_path.size() - extension.size()) + ".gcno";
+    return gcda_path + ".gcno";
+}
+
+/*! \brief Writes the functions of a source file
+ *
+ *  Functions at the same location, e.g. constructor variants, share one FNL record.
+ */
+void write_functions(FILE* output, const gcovhost::source_coverage& source) {
+    std::map<std::pair<uint32_t, uint32_t>, std::vector<std::pair<std::string, uint64_t>>>
+        locations;
+    for(const auto& [name, function] : source.functions)
+        locations[{function.start_line, function.end_line}].emplace_back(name, function.count);
+
+    size_t index = 0U;
+    size_t hit = 0U;
+    for(const auto& [location, aliases] : locations) {
+        fprintf(output, "FNL:%zu,%u,%u\n", index, location.first, location.second);
+        bool executed = false;
+        for(const auto& [name, count] : aliases) {
+            fprintf(output, "FNA:%zu,%llu,%s\n", index, (unsigned long long) count, name.c_str());
+            executed |= count != 0U;
+        }
+        hit += executed;
+        ++index;
+    }
+    fprintf(output, "FNF:%zu\nFNH:%zu\n", locations.size(), hit);
+}
+
+/*! \brief Writes the branches of a source file
+ */
+void write_branches(FILE* output, const gcovhost::source_coverage& source) {
+    size_t found = 0U;
+    size_t hit = 0U;
+    for(const auto& [line, branches] : source.branches) {
+        for(size_t branch = 0U; branch < branches.size(); ++branch) {
+            const gcovhost::branch_coverage& coverage = branches[branch];
+            const char* block = coverage.exceptional ? "e0" : "0";
+            if(coverage.executed)
+                fprintf(output, "BRDA:%u,%s,%zu,%llu\n", line, block, branch,
+                        (unsigned long long) coverage.taken);
+            else
+                fprintf(output, "BRDA:%u,%s,%zu,-\n", line, block, branch);
+            ++found;
+            hit += coverage.taken != 0U;
+        }
+    }
+    if(found)
+        fprintf(output, "BRF:%zu\nBRH:%zu\n", found, hit);
+}
+
+/*! \brief Writes the MC/DC coverage of a source file
+ *
+ *  gcov does not know the text of the conditions, so the index of the expression on its line
+ *  and the index of the condition serve as expression, e.g. 1:0 for the first condition of the
+ *  second expression. lcov identifies the records of a line by it, so two expressions with the
+ *  same number of conditions on one line stay apart.
+ */
+void write_conditions(FILE* output, const gcovhost::source_coverage& source) {
+    size_t found = 0U;
+    size_t hit = 0U;
+    for(const auto& [line, conditions] : source.conditions) {
+        for(size_t group = 0U; group < conditions.size(); ++group) {
+            const gcovhost::condition_coverage& condition = conditions[group];
+            for(uint32_t term = 0U; term < condition.terms; ++term) {
+                const bool covered_true = (condition.covered_true >> term) & 1U;
+                const bool covered_false = (condition.covered_false >> term) & 1U;
+                fprintf(output, "MCDC:%u,%u,t,%d,%u,%zu:%u\n", line, condition.terms,
+                        covered_true, term, group, term);
+                fprintf(output, "MCDC:%u,%u,f,%d,%u,%zu:%u\n", line, condition.terms,
+                        covered_false, term, group, term);
+                found += 2U;
+                hit += covered_true + covered_false;
+            }
+        }
+    }
+    if(found)
+        fprintf(output, "MCF:%zu\nMCH:%zu\n", found, hit);
+}
+
+/*! \brief Writes the coverage as lcov tracefile
+ */
+void write_tracefile(FILE* output,
+                     const std::string& test_name,
+                     const gcovhost::coverage_map& coverage) {
+    for(const auto& [path, source] : coverage) {
+        fprintf(output, "TN:%s\nSF:%s\n", test_name.c_str(), path.c_str());
+        write_functions(output, source);
+        write_branches(output, source);
+        write_conditions(output, source);
+        size_t hit = 0U;
+        for(const auto& [line, count] : source.lines) {
+            fprintf(output, "DA:%u,%llu\n", line, (unsigned long long) count);
+            hit += count != 0U;
+        }
+        fprintf(output, "LF:%zu\nLH:%zu\nend_of_record\n", source.lines.size(), hit);
+    }
+}
+
+void print_usage(const char* name) {
+    fprintf(stderr,
+            "Usage: %s [-o tracefile] [-t test name] image...\n"
+            "Writes the line, branch and MC/DC coverage of coverage images as lcov tracefile.\n"
+            "The gcno file of each record is expected next to the gcda path in the image.\n"
+            "  -o tracefile  the tracefile to write, defaults to stdout\n"
+            "  -t test name  the test name of the records\n",
+            name);
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* output_path = nullptr;
+    std::string test_name;
+    std::vector<std::string> images;
+    for(int arg = 1; arg < argc; ++arg) {
+        const bool has_value = arg + 1 < argc;
+        if(!strcmp(argv[arg], "-o") && has_value) {
+            output_path = argv[++arg];
+        } else if(!strcmp(argv[arg], "-t") && has_value) {
+            test_name = argv[++arg];
+        } else if(argv[arg][0] == '-') {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            images.push_back(argv[arg]);
+        }
+    }
+    if(images.empty()) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // images and notes are processed one by one, only the coverage per line is kept
+    gcovhost::coverage_map coverage;
+    for(const std::string& image_path : images) {
+        try {
+            const gcovhost::image image = gcovhost::read_image(image_path);
+            if(image.flags & GCOV_IMAGE_DELTA) {
+                fprintf(stderr, "Error: %s is a delta image, rebuild it with gcov.py -d first\n",
+                        image_path.c_str());
+                return EXIT_FAILURE;
+            }
+            if(image.truncated)
+                fprintf(stderr, "Warning: %s is truncated\n", image_path.c_str());
+            if(image.flags & GCOV_IMAGE_INCOMPLETE)
+                fprintf(stderr, "Warning: %s misses object files beyond GCOV_MAX_FILES\n",
+                        image_path.c_str());
+            for(const gcovhost::lost_record& lost : image.lost)
+                fprintf(stderr, "Warning: %s lost %s at offset %zu\n", image_path.c_str(),
+                        lost.path.empty() ? "an unknown record" : lost.path.c_str(), lost.offset);
+            for(const gcovhost::image_record& record : image.records) {
+                // objects built without -ftest-coverage have no notes, like lcov they are skipped
+                const std::string notes = notes_path(record.path);
+                if(access(notes.c_str(), R_OK) != 0) {
+                    fprintf(stderr, "Warning: no notes file %s\n", notes.c_str());
+                    continue;
+                }
+                gcovhost::add_coverage(coverage, gcovhost::read_gcno(notes), &record.data);
+            }
+        } catch(const std::runtime_error& error) {
+            fprintf(stderr, "Error: %s: %s\n", image_path.c_str(), error.what());
+            return EXIT_FAILURE;
+        }
+    }
+
+    FILE* output = output_path ? fopen(output_path, "w") : stdout;
+    if(!output) {
+        fprintf(stderr, "Error: can not write %s\n", output_path);
+        return EXIT_FAILURE;
+    }
+    write_tracefile(output, test_name, coverage);
+    if(output != stdout && fclose(output) != 0) {
+        fprintf(stderr, "Error: can not write %s\n", output_path);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
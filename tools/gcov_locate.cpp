@@ -0,0 +1,173 @@
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <elf.h>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+}
+
+#include <gcovhost/image.hpp>
+#include <gcovhost/locate.hpp>
+
+namespace {
+
+/*! \brief A loadable segment of an ELF file, e.g. a memory region of a core file
+ */
+struct segment {
+    uint64_t offset = 0U;     //!< The offset of the segment in the file
+    uint64_t size = 0U;       //!< The number of bytes of the segment in the file
+    uint64_t address = 0U;    //!< The address of the segment in the memory of the target
+};
+
+/*! \brief Reads an unsigned value of an ELF file in the byte order of the file
+ */
+uint64_t read_elf(const uint8_t* data, const size_t size, const bool big_endian) {
+    uint64_t value = 0U;
+    for(size_t idx = 0U; idx < size; ++idx)
+        value |= uint64_t(data[big_endian ? idx : size - 1U - idx]) << (8U * (size - 1U - idx));
+    return value;
+}
+
+/*! \brief Reads the loadable segments of an ELF file of either class and byte order
+ *
+ *  \return The segments, empty if the file is no ELF file, e.g. a raw dump of the RAM
+ */
+std::vector<segment> read_segments(const uint8_t* data, const size_t size) {
+    std::vector<segment> segments;
+    if(size < EI_NIDENT || memcmp(data, ELFMAG, SELFMAG) != 0)
+        return segments;
+    const bool wide = data[EI_CLASS] == ELFCLASS64;
+    const bool big_endian = data[EI_DATA] == ELFDATA2MSB;
+    const size_t header_size = wide ? sizeof(Elf64_Ehdr) : sizeof(Elf32_Ehdr);
+    if(size < header_size)
+        return segments;
+
+    const size_t word = wide ? 8U : 4U;
+    const uint64_t table = read_elf(data + (wide ? 32U : 28U), word, big_endian);
+    const uint64_t entry_size = read_elf(data + (wide ? 54U : 42U), 2U, big_endian);
+    const uint64_t entries = read_elf(data + (wide ? 56U : 44U), 2U, big_endian);
+    for(uint64_t entry = 0U; entry < entries; ++entry) {
+        const uint64_t pos = table + entry * entry_size;
+        if(pos > size || size - pos < (wide ? sizeof(Elf64_Phdr) : sizeof(Elf32_Phdr)))
+            break;
+        const uint8_t* header = data + pos;
+        if(read_elf(header, 4U, big_endian) != PT_LOAD)
+            continue;
+        segment loaded;
+        loaded.offset = read_elf(header + (wide ? 8U : 4U), word, big_endian);
+        loaded.address = read_elf(header + (wide ? 16U : 8U), word, big_endian);
+        loaded.size = read_elf(header + (wide ? 32U : 16U), word, big_endian);
+        segments.push_back(loaded);
+    }
+    return segments;
+}
+
+/*! \brief Translates an offset in an ELF file into the address of the target
+ */
+std::optional<uint64_t> find_address(const std::vector<segment>& segments, const size_t offset) {
+    for(const segment& loaded : segments) {
+        if(offset >= loaded.offset && offset - loaded.offset < loaded.size)
+            return loaded.address + (offset - loaded.offset);
+    }
+    return std::nullopt;
+}
+
+const char* describe(const gcovhost::image_state state) {
+    switch(state) {
+    case gcovhost::image_state::complete:
+        return "complete";
+    case gcovhost::image_state::truncated:
+        return "truncated by the end of the dump";
+    case gcovhost::image_state::corrupted:
+        return "corrupted, the end marker or the CRC-32 does not match";
+    default:
+        return "unfinished, the header holds no length";
+    }
+}
+
+/*! \brief Writes a complete image into the output directory
+ */
+bool write_image(const std::string& path, const uint8_t* data, const size_t size) {
+    FILE* output = fopen(path.c_str(), "wb");
+    if(!output)
+        return false;
+    const bool written = fwrite(data, 1U, size, output) == size;
+    return (fclose(output) == 0) && written;
+}
+
+void print_usage(const char* name) {
+    fprintf(stderr,
+            "Usage: %s [-o directory] dump...\n"
+            "Finds and validates the coverage images in raw RAM dumps and ELF core files.\n"
+            "  -o directory  writes each complete image to <directory>/<dump>_<offset>.bin\n",
+            name);
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* output_directory = nullptr;
+    std::vector<std::string> dumps;
+    for(int arg = 1; arg < argc; ++arg) {
+        const bool has_value = arg + 1 < argc;
+        if(!strcmp(argv[arg], "-o") && has_value) {
+            output_directory = argv[++arg];
+        } else if(argv[arg][0] == '-') {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            dumps.push_back(argv[arg]);
+        }
+    }
+    if(dumps.empty()) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    size_t complete = 0U;
+    for(const std::string& dump_path : dumps) {
+        try {
+            const gcovhost::mapped_file dump(dump_path);
+            const std::vector<segment> segments = read_segments(dump.data(), dump.size());
+            for(const gcovhost::located_image& image :
+                gcovhost::locate_images(dump.data(), dump.size())) {
+                printf("%s: offset 0x%zx", dump_path.c_str(), image.offset);
+                if(const auto address = find_address(segments, image.offset))
+                    printf(" (address 0x%" PRIx64 ")", *address);
+                printf(", version %u, flags 0x%02x, sequence %u, %zu bytes: %s\n", image.version,
+                       image.flags, unsigned(image.sequence), image.length, describe(image.state));
+                if(image.state != gcovhost::image_state::complete)
+                    continue;
+                ++complete;
+                if(!output_directory)
+                    continue;
+
+                const size_t name_start = dump_path.find_last_of('/') + 1U;
+                char offset[32];
+                snprintf(offset, sizeof(offset), "_%zx.bin", image.offset);
+                const std::string image_path = std::string(output_directory) + "/"
+                                               + dump_path.substr(name_start) + offset;
+                if(!write_image(image_path, dump.data() + image.offset, image.length)) {
+                    fprintf(stderr, "Error: can not write %s\n", image_path.c_str());
+                    return EXIT_FAILURE;
+                }
+            }
+        } catch(const std::runtime_error& error) {
+            fprintf(stderr, "Error: %s\n", error.what());
+            return EXIT_FAILURE;
+        }
+    }
+    if(!complete) {
+        fprintf(stderr, "Error: no complete coverage image found\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
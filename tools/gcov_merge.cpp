@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+}
+
+#include <gcovhost/gcda.hpp>
+#include <gcovhost/image.hpp>
+
+namespace {
+
+/*! \brief The merged gcda files of all images processed by one worker
+ */
+struct merge_state {
+    std::unordered_map<std::string, gcovhost::gcda_file> files;    //!< The files by their path
+    std::vector<std::string> errors;                               //!< Mismatches and read errors
+};
+
+/*! \brief Merges a file into the state
+ *
+ *  \param[in,out]  state   The state to merge into
+ *  \param[in]      origin  The image the file was read from, for error messages
+ *  \param[in]      path    The path of the gcda file
+ *  \param[in]      file    The file to merge
+ */
+void merge_file(merge_state& state,
+                const std::string& origin,
+                const std::string& path,
+                gcovhost::gcda_file&& file) {
+    auto [entry, inserted] = state.files.try_emplace(path, std::move(file));
+    if(inserted)
+        return;
+    try {
+        gcovhost::merge_gcda(entry->second, file);
+    } catch(const gcovhost::gcda_error& error) {
+        state.errors.push_back(origin + ": " + path + ": " + error.what());
+    }
+}
+
+/*! \brief Parses and merges the images assigned to a worker
+ *
+ *  \param[in]      images  The paths of all images
+ *  \param[in,out]  next    The index of the next image to process, shared by all workers
+ *  \param[out]     state   The state of the worker
+ */
+void merge_images(const std::vector<std::string>& images,
+                  std::atomic<size_t>& next,
+                  merge_state& state) {
+    for(size_t idx = next++; idx < images.size(); idx = next++) {
+        try {
+            gcovhost::image image = gcovhost::read_image(images[idx]);
+            if(image.flags & GCOV_IMAGE_DELTA) {
+                state.errors.push_back(images[idx]
+                                       + ": delta images only hold changed functions, rebuild "
+                                         "them with gcov.py -d first");
+                continue;
+            }
+            if(image.flags & GCOV_IMAGE_TEST) {
+                state.errors.push_back(images[idx]
+                                       + ": test images only hold the functions a single test "
+                                         "executed, use gcov_tests or gcov_lcov");
+                continue;
+            }
+            if(image.truncated)
+                fprintf(stderr, "Warning: %s is truncated\n", images[idx].c_str());
+            if(image.flags & GCOV_IMAGE_INCOMPLETE)
+                fprintf(stderr, "Warning: %s misses object files beyond GCOV_MAX_FILES\n",
+                        images[idx].c_str());
+            for(const gcovhost::lost_record& lost : image.lost)
+                fprintf(stderr, "Warning: %s lost %s at offset %zu\n", images[idx].c_str(),
+                        lost.path.empty() ? "an unknown record" : lost.path.c_str(), lost.offset);
+            for(gcovhost::image_record& record : image.records)
+                merge_file(state, images[idx], record.path, std::move(record.data));
+        } catch(const std::runtime_error& error) {
+            state.errors.push_back(images[idx] + ": " + error.what());
+        }
+    }
+}
+
+/*! \brief Reads the image paths listed in a file, one per line
+ */
+void read_image_list(const char* list, std::vector<std::string>& images) {
+    std::ifstream input(list);
+    if(!input)
+        throw std::runtime_error(std::string("can not read ") + list);
+    for(std::string line; std::getline(input, line);)
+        if(!line.empty())
+            images.push_back(line);
+}
+
+void print_usage(const char* name) {
+    fprintf(stderr,
+            "Usage: %s [-j workers] [-o directory] [-l list] image...\n"
+            "Merges the coverage images of many runs into one set of gcda files.\n"
+            "  -j workers    number of parsing threads, defaults to the number of cores\n"
+            "  -o directory  writes the gcda files below this directory instead of their\n"
+            "                original path\n"
+            "  -l list       reads further image paths from a file, one per line\n",
+            name);
+}
+
+}
+
+int main(int argc, char** argv) {
+    size_t workers = std::max(1U, std::thread::hardware_concurrency());
+    std::filesystem::path output_directory;
+    std::vector<std::string> images;
+
+    try {
+        for(int arg = 1; arg < argc; ++arg) {
+            const bool has_value = arg + 1 < argc;
+            if(!strcmp(argv[arg], "-j") && has_value) {
+                workers = std::max(1L, strtol(argv[++arg], nullptr, 10));
+            } else if(!strcmp(argv[arg], "-o") && has_value) {
+                output_directory = argv[++arg];
+            } else if(!strcmp(argv[arg], "-l") && has_value) {
+                read_image_list(argv[++arg], images);
+            } else if(argv[arg][0] == '-') {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            } else {
+                images.push_back(argv[arg]);
+            }
+        }
+    } catch(const std::runtime_error& error) {
+        fprintf(stderr, "Error: %s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    if(images.empty()) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // each worker merges into its own state, the states are combined afterwards
+    workers = std::min(workers, images.size());
+    std::vector<merge_state> states(workers);
+    std::atomic<size_t> next {0U};
+    std::vector<std::thread> threads;
+    for(size_t worker = 1U; worker < workers; ++worker)
+        threads.emplace_back(
+            merge_images, std::cref(images), std::ref(next), std::ref(states[worker]));
+    merge_images(images, next, states[0]);
+    for(std::thread& thread : threads)
+        thread.join();
+
+    merge_state& merged = states[0];
+    for(size_t worker = 1U; worker < workers; ++worker) {
+        for(auto& [path, file] : states[worker].files)
+            merge_file(merged, "worker " + std::to_string(worker), path, std::move(file));
+        merged.errors.insert(merged.errors.end(), states[worker].errors.begin(),
+                             states[worker].errors.end());
+    }
+
+    // mismatching builds are not merged silently, nothing is written
+    if(!merged.errors.empty()) {
+        std::sort(merged.errors.begin(), merged.errors.end());
+        for(const std::string& error : merged.errors)
+            fprintf(stderr, "Error: %s\n", error.c_str());
+        return EXIT_FAILURE;
+    }
+
+    for(const auto& [path, file] : merged.files) {
+        std::filesystem::path target = path;
+        if(!output_directory.empty())
+            target = output_directory / target.relative_path();
+        if(target.has_parent_path())
+            std::filesystem::create_directories(target.parent_path());
+        const std::vector<uint8_t> data = gcovhost::serialize_gcda(file);
+        std::ofstream output(target, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+        if(!output) {
+            fprintf(stderr, "Error: can not write %s\n", target.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+    printf("Merged %zu images into %zu gcda files\n", images.size(), merged.files.size());
+    return EXIT_SUCCESS;
+}
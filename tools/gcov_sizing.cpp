@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+}
+
+#include <gcovhost/gcno.hpp>
+
+namespace {
+
+// The record header of a gcda file: the tag and the length
+constexpr size_t gcda_record_header_size = 2U * GCOV_WORD_SIZE;
+// The gcda header: magic, version, stamp and checksum, followed by the object summary
+constexpr size_t gcda_header_size =
+    4U * GCOV_WORD_SIZE + gcda_record_header_size + GCOV_TAG_SUMMARY_LENGTH;
+// The end marker behind the trailer of an image, see __gcov_dump()
+constexpr size_t image_end_marker_size = sizeof("Gcov End");
+
+/*! \brief Upper bounds of the coverage data of a set of instrumented object files
+ */
+struct sizing {
+    size_t files = 0U;            //!< The number of instrumented object files
+    size_t functions = 0U;        //!< The number of instrumented functions
+    size_t counters = 0U;         //!< The number of counters of all files
+    size_t max_gcda_size = 0U;    //!< The size of the largest gcda file in bytes
+    size_t image_size = GCOV_IMAGE_HEADER_SIZE + GCOV_IMAGE_TRAILER_SIZE + image_end_marker_size;
+};
+
+/*! \brief Derives the path of the notes file from the path of an object file
+ *
+ *  gcc replaces the extension of the object file, so test.cpp.o has the notes test.cpp.gcno.
+ */
+std::filesystem::path notes_path(const std::filesystem::path& object) {
+    std::filesystem::path notes = object;
+    return notes.extension() == ".gcno" ? notes : notes.replace_extension(".gcno");
+}
+
+/*! \brief Adds the gcda file of an instrumented object file to the sizing
+ *
+ *  \param[in,out]  result  The sizing to add to
+ *  \param[in]      notes   The gcno file of the object
+ *  \param[in]      path    The path of the gcno file
+ *
+ *  A counter type is used by every function of a file as soon as one function has counters of
+ *  that type. Only the arc and condition counters are known from the notes, value profiling
+ *  counters of -fprofile-generate builds are not covered.
+ */
+void add_notes(sizing& result,
+               const gcovhost::gcno_file& notes,
+               const std::filesystem::path& path) {
+    size_t arcs = 0U;
+    size_t conditions = 0U;
+    for(const gcovhost::gcno_function& function : notes.functions) {
+        arcs += std::count_if(function.arcs.begin(), function.arcs.end(), [](const auto& arc) {
+            return !(arc.flags & gcovhost::gcno_arc_on_tree);
+        });
+        conditions += function.conditions.size();
+    }
+    const size_t kinds = (arcs != 0U) + (conditions != 0U);
+    // each condition has one counter for the true and one for the false outcomes
+    const size_t counters = arcs + 2U * conditions;
+
+    const size_t gcda_size = gcda_header_size
+                             + notes.functions.size()
+                                   * (gcda_record_header_size + GCOV_TAG_FUNCTION_LENGTH
+                                      + kinds * gcda_record_header_size)
+                             + GCOV_TAG_COUNTER_LENGTH(counters);
+    // the runtime records the absolute gcda path next to the object
+    std::filesystem::path gcda_path = std::filesystem::absolute(path);
+    gcda_path.replace_extension(".gcda");
+
+    ++result.files;
+    result.functions += notes.functions.size();
+    result.counters += counters;
+    result.max_gcda_size = std::max(result.max_gcda_size, gcda_size);
+    result.image_size += gcda_path.string().size() + 1U + gcda_size + GCOV_WORD_SIZE
+                         + GCOV_IMAGE_TOC_ENTRY_SIZE;
+}
+
+/*! \brief Writes the sizing as C header usable from C and C++
+ */
+bool write_header(const char* path, const sizing& result) {
+    FILE* output = path ? fopen(path, "w") : stdout;
+    if(!output)
+        return false;
+    // the counters of the accumulation area are aligned behind its header
+    const size_t accumulator_size = GCOV_ACCUMULATOR_HEADER_SIZE + alignof(gcov_type) - 1U
+                                    + result.counters * sizeof(gcov_type);
+    // the snapshot area holds the same counters without header
+    const size_t snapshot_size = alignof(gcov_type) - 1U + result.counters * sizeof(gcov_type);
+    // checked images add a marker and a CRC-32 to each record and a CRC-32 to each chunk
+    const size_t checked_payload =
+        result.image_size
+        + result.files * (sizeof(GCOV_IMAGE_RECORD_MARKER) - 1U + sizeof(gcov_unsigned_t));
+    const size_t checked_image_size =
+        checked_payload
+        + (checked_payload + GCOV_IMAGE_CHUNK_SIZE - 1U) / GCOV_IMAGE_CHUNK_SIZE
+              * sizeof(gcov_unsigned_t);
+    fprintf(output,
+            "// Generated by gcov_sizing from %zu instrumented object files, do not edit\n"
+            "#ifndef GCOV_SIZING_H\n"
+            "#define GCOV_SIZING_H\n"
+            "\n"
+            "//! The number of instrumented object files\n"
+            "#define GCOV_SIZING_FILES              %zuU\n"
+            "//! The number of instrumented functions, i.e. the entries of a delta baseline\n"
+            "#define GCOV_SIZING_FUNCTIONS          %zuU\n"
+            "//! The number of counters of all files\n"
+            "#define GCOV_SIZING_COUNTERS           %zuU\n"
+            "//! The size of the largest gcda file in bytes\n"
+            "#define GCOV_SIZING_MAX_GCDA_SIZE      %zuU\n"
+            "//! The size of a complete image with plain counters in bytes\n"
+            "#define GCOV_SIZING_IMAGE_SIZE         %zuU\n"
+            "//! The size of a complete image with plain counters and GCOV_IMAGE_CHECKED in bytes\n"
+            "#define GCOV_SIZING_CHECKED_IMAGE_SIZE %zuU\n"
+            "//! The size of the accumulation area in bytes, including the counter alignment\n"
+            "#define GCOV_SIZING_ACCUMULATOR_SIZE   %zuU\n"
+            "//! The size of the snapshot area in bytes, including the counter alignment\n"
+            "#define GCOV_SIZING_SNAPSHOT_SIZE      %zuU\n"
+            "\n"
+            "#endif\n",
+            result.files, result.files, result.functions, result.counters, result.max_gcda_size,
+            result.image_size, checked_image_size, accumulator_size, snapshot_size);
+    return output == stdout ? fflush(output) == 0 : fclose(output) == 0;
+}
+
+void print_usage(const char* name) {
+    fprintf(stderr,
+            "Usage: %s [-o header] [-m image buffer size] object...\n"
+            "Writes upper bounds of the coverage data of instrumented objects as C header.\n"
+            "The gcno file of each object is expected next to it, objects without are skipped.\n"
+            "  -o header             the header to write, defaults to stdout\n"
+            "  -m image buffer size  fails if a complete image does not fit into this size\n",
+            name);
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* output_path = nullptr;
+    size_t image_buffer_size = 0U;
+    std::vector<std::filesystem::path> objects;
+    for(int arg = 1; arg < argc; ++arg) {
+        const bool has_value = arg + 1 < argc;
+        if(!strcmp(argv[arg], "-o") && has_value) {
+            output_path = argv[++arg];
+        } else if(!strcmp(argv[arg], "-m") && has_value) {
+            image_buffer_size = strtoull(argv[++arg], nullptr, 0);
+        } else if(argv[arg][0] == '-') {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            objects.push_back(argv[arg]);
+        }
+    }
+    if(objects.empty()) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    sizing result;
+    for(const std::filesystem::path& object : objects) {
+        const std::filesystem::path notes = notes_path(object);
+        if(!std::filesystem::exists(notes))
+            continue;
+        try {
+            add_notes(result, gcovhost::read_gcno(notes.string()), notes);
+        } catch(const std::runtime_error& error) {
+            fprintf(stderr, "Error: %s\n", error.what());
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(image_buffer_size && result.image_size > image_buffer_size) {
+        fprintf(stderr, "Error: the image needs %zu bytes, the buffer only has %zu bytes\n",
+                result.image_size, image_buffer_size);
+        return EXIT_FAILURE;
+    }
+    if(!write_header(output_path, result)) {
+        fprintf(stderr, "Error: can not write %s\n", output_path);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
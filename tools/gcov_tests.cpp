@@ -0,0 +1,251 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <fnmatch.h>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+extern "C" {
+#include <gcov/gcov.h>
+}
+
+#include <gcovhost/coverage.hpp>
+#include <gcovhost/gcno.hpp>
+#include <gcovhost/image.hpp>
+#include <gcovhost/locate.hpp>
+#include <gcovhost/test_matrix.hpp>
+
+namespace {
+
+using query_clock = std::chrono::steady_clock;
+
+/*! \brief Derives the path of the notes file from the path of the gcda file
+ */
+std::string notes_path(const std::string& gcda_path) {
+    const std::string extension = ".gcda";
+    if(gcda_path.size() > extension.size()
+       && gcda_path.compare(gcda_path.size() - extension.size(), extension.size(), extension) == 0)
+        return gcda_path.substr(0U, gcda_path.size() - extension.size()) + ".gcno";
+    return gcda_path + ".gcno";
+}
+
+/*! \brief Adds the test images of a file, e.g. the images of all tests streamed into one log
+ *
+ *  \return The number of test images found in the file
+ */
+size_t add_images(gcovhost::test_matrix_builder& builder, const std::string& path) {
+    const gcovhost::mapped_file file(path);
+    const std::vector<gcovhost::located_image> located =
+        gcovhost::locate_images(file.data(), file.size());
+    size_t added = 0U;
+    for(size_t idx = 0U; idx < located.size(); ++idx) {
+        const gcovhost::located_image& image = located[idx];
+        if(!(image.flags & GCOV_IMAGE_TEST))
+            continue;
+        // images streamed without length end at the next image
+        size_t end = idx + 1U < located.size() ? located[idx + 1U].offset : file.size();
+        if(image.state == gcovhost::image_state::complete)
+            end = image.offset + image.length;
+        const gcovhost::image parsed =
+            gcovhost::parse_image(file.data() + image.offset, end - image.offset);
+        if(parsed.truncated)
+            fprintf(stderr, "Warning: the image of test %u in %s is truncated\n",
+                    unsigned(parsed.sequence), path.c_str());
+        builder.add_image(parsed);
+        ++added;
+    }
+    return added;
+}
+
+/*! \brief Fills in the names and sources of the functions from the gcno files
+ */
+void name_functions(gcovhost::test_matrix& matrix) {
+    std::map<std::string, gcovhost::gcno_file> notes;
+    for(gcovhost::matrix_function& function : matrix.functions) {
+        auto unit = notes.find(function.path);
+        if(unit == notes.end()) {
+            const std::string path = notes_path(function.path);
+            gcovhost::gcno_file file;
+            if(access(path.c_str(), R_OK) == 0)
+                file = gcovhost::read_gcno(path);
+            else
+                fprintf(stderr, "Warning: no notes file %s\n", path.c_str());
+            unit = notes.emplace(function.path, std::move(file)).first;
+        }
+        for(const gcovhost::gcno_function& named : unit->second.functions) {
+            if(named.ident != function.ident)
+                continue;
+            function.name = named.name;
+            function.source = gcovhost::resolve_source(unit->second.cwd, named.source);
+            break;
+        }
+    }
+}
+
+std::string demangle(const std::string& name) {
+    if(name.compare(0U, 2U, "_Z") != 0)
+        return name;
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if(!demangled)
+        return name;
+    std::string result(demangled);
+    free(demangled);
+    return result;
+}
+
+bool matches(const std::vector<std::string>& patterns, const std::string& text) {
+    for(const std::string& pattern : patterns) {
+        if(!text.empty() && fnmatch(pattern.c_str(), text.c_str(), 0) == 0)
+            return true;
+    }
+    return false;
+}
+
+/*! \brief Reads the test names, line n holds the name of test id n
+ */
+std::vector<std::string> read_names(const char* path) {
+    std::vector<std::string> names;
+    FILE* input = fopen(path, "r");
+    if(!input)
+        throw std::runtime_error(std::string("can not read ") + path);
+    char line[1024];
+    while(fgets(line, sizeof(line), input))
+        names.emplace_back(line, strcspn(line, "\r\n"));
+    fclose(input);
+    return names;
+}
+
+void print_usage(const char* name) {
+    fprintf(stderr,
+            "Usage: %s -o matrix image...\n"
+            "       %s -m matrix [-f file]... [-F function]... [-n names]\n"
+            "Builds the matrix of the functions each test executed from the images written by\n"
+            "gcov_end_test() and lists the tests touching the given files or functions. Functions\n"
+            "have to match one of the -f and one of the -F globs, if given.\n"
+            "  -o matrix     builds the matrix, an image file may hold the images of many tests\n"
+            "  -m matrix     queries the matrix, all tests without -f and -F\n"
+            "  -f file       a glob matching the source or gcda path of the functions\n"
+            "  -F function   a glob matching the assembler or demangled name of the functions\n"
+            "  -n names      a file with the name of test id n in line n + 1\n",
+            name, name);
+}
+
+int build_matrix(const char* output_path, const std::vector<std::string>& images) {
+    gcovhost::test_matrix_builder builder;
+    size_t added = 0U;
+    for(const std::string& image_path : images) {
+        try {
+            const size_t found = add_images(builder, image_path);
+            if(!found)
+                fprintf(stderr, "Warning: %s holds no test image\n", image_path.c_str());
+            added += found;
+        } catch(const std::runtime_error& error) {
+            fprintf(stderr, "Error: %s: %s\n", image_path.c_str(), error.what());
+            return EXIT_FAILURE;
+        }
+    }
+    if(!added) {
+        fprintf(stderr, "Error: no test image found\n");
+        return EXIT_FAILURE;
+    }
+
+    gcovhost::test_matrix matrix = builder.build();
+    try {
+        name_functions(matrix);
+    } catch(const std::runtime_error& error) {
+        fprintf(stderr, "Error: %s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    const std::vector<uint8_t> data = gcovhost::serialize_test_matrix(matrix);
+    FILE* output = fopen(output_path, "wb");
+    const bool written = output && fwrite(data.data(), 1U, data.size(), output) == data.size();
+    if(!output || (fclose(output) != 0) || !written) {
+        fprintf(stderr, "Error: can not write %s\n", output_path);
+        return EXIT_FAILURE;
+    }
+    fprintf(stderr, "%zu tests, %zu functions from %zu images\n", matrix.tests.size(),
+            matrix.functions.size(), added);
+    return EXIT_SUCCESS;
+}
+
+int query_matrix(const char* matrix_path,
+                 const std::vector<std::string>& files,
+                 const std::vector<std::string>& functions,
+                 const char* names_path) {
+    try {
+        const query_clock::time_point start = query_clock::now();
+        const gcovhost::test_matrix_file matrix(matrix_path);
+        std::vector<size_t> selected;
+        for(size_t function_idx = 0U; function_idx < matrix.functions().size(); ++function_idx) {
+            const gcovhost::matrix_function& function = matrix.functions()[function_idx];
+            const bool file_matches = files.empty() || matches(files, function.source)
+                                      || matches(files, function.path);
+            const bool name_matches = functions.empty() || matches(functions, function.name)
+                                      || matches(functions, demangle(function.name));
+            if(file_matches && name_matches)
+                selected.push_back(function_idx);
+        }
+        const std::vector<uint32_t> tests = matrix.select_tests(selected);
+        const double elapsed =
+            std::chrono::duration<double, std::milli>(query_clock::now() - start).count();
+
+        const std::vector<std::string> names =
+            names_path ? read_names(names_path) : std::vector<std::string>();
+        for(const uint32_t test : tests) {
+            if(test < names.size())
+                printf("%s\n", names[test].c_str());
+            else
+                printf("%u\n", test);
+        }
+        fprintf(stderr, "%zu of %zu tests touch %zu functions (%.2f ms)\n", tests.size(),
+                matrix.tests().size(), selected.size(), elapsed);
+    } catch(const std::runtime_error& error) {
+        fprintf(stderr, "Error: %s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* output_path = nullptr;
+    const char* matrix_path = nullptr;
+    const char* names_path = nullptr;
+    std::vector<std::string> files;
+    std::vector<std::string> functions;
+    std::vector<std::string> images;
+    for(int arg = 1; arg < argc; ++arg) {
+        const bool has_value = arg + 1 < argc;
+        if(!strcmp(argv[arg], "-o") && has_value) {
+            output_path = argv[++arg];
+        } else if(!strcmp(argv[arg], "-m") && has_value) {
+            matrix_path = argv[++arg];
+        } else if(!strcmp(argv[arg], "-f") && has_value) {
+            files.push_back(argv[++arg]);
+        } else if(!strcmp(argv[arg], "-F") && has_value) {
+            functions.push_back(argv[++arg]);
+        } else if(!strcmp(argv[arg], "-n") && has_value) {
+            names_path = argv[++arg];
+        } else if(argv[arg][0] == '-') {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            images.push_back(argv[arg]);
+        }
+    }
+    if(output_path && matrix_path == nullptr && !images.empty())
+        return build_matrix(output_path, images);
+    if(matrix_path && output_path == nullptr && images.empty())
+        return query_matrix(matrix_path, files, functions, names_path);
+    print_usage(argv[0]);
+    return EXIT_FAILURE;
+}